@@ -0,0 +1,138 @@
+/**
+ * @file arena_benchmark.cpp
+ *
+ * Compares basin sampling into a util::Counter of Attractor objects with
+ * basin sampling into an ExperimentArena.
+ *
+ * The program runs Brent's cycle finder from a number of random states of a
+ * network and counts the attractors reached, with either or both methods. It
+ * prints the heap allocations, the peak resident set size and the time of
+ * the run. Peak RSS only grows during a process, so each method should be
+ * measured in a run of its own; when both are run, the program checks that
+ * they count the same attractors.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <sys/resource.h>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/experiment/basin_of_attraction.hpp>
+#include <BnSimulator/gen/RandomStateGen.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+std::size_t allocations = 0;
+
+/**
+ * Returns the peak resident set size of this process.
+ * @return a size in KiB
+ */
+long peak_rss() {
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+void report(const char name[], const std::size_t allocs, const double time,
+		const std::size_t attractors) {
+	std::cout << name << ": " << attractors << " attractors, " << allocs
+			<< " allocations, peak RSS " << peak_rss() << " KiB, " << time
+			<< " s" << std::endl;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+	++allocations;
+	if (void* p = std::malloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* p) throw () {
+	std::free(p);
+}
+
+void operator delete[](void* p) throw () {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) throw () {
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) throw () {
+	std::free(p);
+}
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li path to topology file
+ * @li path to node function file
+ * @li number of probes
+ * @li seed for the random number generator
+ * @li optionally, "counter" or "arena" to run a single method
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 5) {
+		std::cerr << "usage: " << argv[0]
+				<< " topology functions probes seed [counter|arena]"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const ImmutableBooleanNetwork net = ImmutableBooleanNetwork::makeNetwork(
+			argv[1], argv[2]);
+	const std::size_t probes = std::atoi(argv[3]);
+	const int seed = std::atoi(argv[4]);
+	const bool counter = argc < 6 || std::strcmp(argv[5], "counter") == 0;
+	const bool arena = argc < 6 || std::strcmp(argv[5], "arena") == 0;
+	CompiledNetwork compiled(net);
+	util::Counter<Attractor> basins;
+	if (counter) {
+		std::srand(seed);
+		const std::size_t before = allocations;
+		util::Stopwatch timer;
+		basins = basin_of_attraction(gen::random_states(net.size(), probes),
+				brent(compiled));
+		report("Counter<Attractor>", allocations - before, timer.elapsed(),
+				basins.size());
+	}
+	ExperimentArena experiment;
+	if (arena) {
+		std::srand(seed);
+		const std::size_t before = allocations;
+		util::Stopwatch timer;
+		basin_of_attraction(gen::random_states(net.size(), probes), brent(
+				compiled), experiment);
+		report("ExperimentArena", allocations - before, timer.elapsed(),
+				experiment.size());
+		std::cout << "arena: " << experiment.memory() << " bytes"
+				<< std::endl;
+	}
+	if (counter && arena) {
+		bool ok = basins.size() == experiment.size()
+				&& basins.insertions() == experiment.insertions();
+		for (ExperimentArena::const_iterator it = experiment.begin(); it
+				!= experiment.end(); ++it)
+			ok = ok && basins[it->toAttractor()] == it->getCount();
+		if (!ok) {
+			std::cerr << "Counter and ExperimentArena results differ"
+					<< std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	return EXIT_SUCCESS;
+}
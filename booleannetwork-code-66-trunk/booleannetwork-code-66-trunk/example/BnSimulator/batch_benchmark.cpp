@@ -0,0 +1,79 @@
+/**
+ * @file batch_benchmark.cpp
+ *
+ * Compares the throughput of ImmutableBooleanNetwork::update(State&) with the
+ * bit-sliced batch simulator on the same set of random initial states, once
+ * for each lane kernel supported by the running CPU.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/BitslicedNetwork.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following required parameters in order:
+ * @li path to topology file
+ * @li path to node function file
+ * @li number of independent trajectories
+ * @li number of steps per trajectory
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0]
+				<< " topology functions trajectories steps seed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	ImmutableBooleanNetwork net = ImmutableBooleanNetwork::makeNetwork(argv[1],
+			argv[2]);
+	const std::size_t probes = std::atoi(argv[3]);
+	const std::size_t steps = std::atoi(argv[4]);
+	std::srand(std::atoi(argv[5]));
+	std::vector<State> init;
+	for (std::size_t i = 0; i < probes; ++i)
+		init.push_back(util::random_state(net.size()));
+	// one trajectory at a time
+	std::vector<State> serial(init);
+	util::Stopwatch timer;
+	for (std::size_t i = 0; i < probes; ++i)
+		for (std::size_t t = 0; t < steps; ++t)
+			net.update(serial[i]);
+	const double serialTime = timer.elapsed();
+	const double total = static_cast<double> (probes) * steps;
+	std::cout << "nodes: " << net.size() << '\n';
+	std::cout << "update():  " << total / serialTime << " steps/s\n";
+	// all trajectories at once, with every kernel the CPU supports
+	BitslicedNetwork batchNet(net);
+	std::cout << "selected kernel: " << batchNet.getKernel().name << '\n';
+	const char* const kernels[] = { "scalar", "sse2", "avx2", "avx512" };
+	for (std::size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); ++k) {
+		const LaneKernel* kernel = find_lane_kernel(kernels[k]);
+		if (kernel == NULL)
+			continue;
+		batchNet.setKernel(*kernel);
+		BatchState batch(net.size(), probes);
+		timer.restart();
+		batch.load(init.begin(), init.end());
+		batchNet.update(batch, steps);
+		std::vector<State> sliced(probes);
+		batch.store(sliced.begin(), probes);
+		const double batchTime = timer.elapsed();
+		if (sliced != serial) {
+			std::cerr << kernel->name << ": batch and serial trajectories differ"
+					<< std::endl;
+			return EXIT_FAILURE;
+		}
+		std::cout << kernel->name << " (" << batch.lanes() << " lanes): "
+				<< total / batchTime << " steps/s (" << serialTime / batchTime
+				<< "x)" << std::endl;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file cached_basin_benchmark.cpp
+ *
+ * Measures how much an AttractorCache speeds up the sampling of basins of
+ * attraction of a random network.
+ *
+ * The program pipes the same random initial states into brent(...) and into
+ * cached(...) on a CompiledNetwork, with every eviction policy and then on a
+ * pool of threads sharing one cache, and prints the searches per second, the
+ * speedup, the hit rate of the lookups and the number of evictions. It fails
+ * if any run finds other attractors, or other counts, than brent().
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/AttractorCache.hpp>
+#include <BnSimulator/experiment/cached_cycle_finder.hpp>
+#include <BnSimulator/experiment/parallel_cycle_finder.hpp>
+#include <BnSimulator/gen/RandomStateGen.hpp>
+#include <BnSimulator/util/Counter.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+bool same(const bn::util::Counter<bn::Attractor>& a,
+		const bn::util::Counter<bn::Attractor>& b) {
+	return a.size() == b.size() && a.insertions() == b.insertions()
+			&& std::equal(a.begin(), a.end(), b.begin());
+}
+
+void print(const char name[], const double rate, const double base,
+		const bn::AttractorCache& cache) {
+	const bn::AttractorCache::Statistics stats = cache.getStatistics();
+	std::cout << name << ": " << rate << " searches/s (" << rate / base
+			<< "x), hit rate " << stats.hitRate() << ", " << stats.evictions
+			<< " evictions" << std::endl;
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li number of initial states
+ * @li seed for the random number generator
+ * @li memory of the cache, in bytes
+ * @li number of threads
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 7) {
+		std::cerr << "usage: " << argv[0]
+				<< " nodes k states seed memory threads" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t states = std::atoi(argv[3]);
+	const int seed = std::atoi(argv[4]);
+	const std::size_t memory = std::atol(argv[5]);
+	const std::size_t threads = std::atoi(argv[6]);
+	std::srand(seed);
+	const MutableBooleanNetwork graph = make_random_network(n, k);
+	CompiledNetwork compiled(graph);
+	// every run draws the same initial states
+	std::srand(seed + 1);
+	util::Stopwatch timer;
+	const util::Counter<Attractor> plain(gen::random_states(n, states)
+			| brent(compiled));
+	const double base = states / timer.elapsed();
+	std::cout << "N=" << n << " K=" << k << ": " << base
+			<< " searches/s uncached, " << plain.size() << " attractors"
+			<< std::endl;
+	const char* names[] = { "CLOCK", "FIFO", "NONE" };
+	const AttractorCache::Eviction policies[] = { AttractorCache::CLOCK,
+			AttractorCache::FIFO, AttractorCache::NONE };
+	bool ok = true;
+	for (std::size_t i = 0; i < 3; ++i) {
+		AttractorCache cache(n, memory, policies[i]);
+		std::srand(seed + 1);
+		timer.restart();
+		const util::Counter<Attractor> found(gen::random_states(n, states)
+				| cached(compiled, cache));
+		print(names[i], states / timer.elapsed(), base, cache);
+		ok = ok && same(found, plain);
+	}
+	AttractorCache cache(n, memory);
+	std::srand(seed + 1);
+	timer.restart();
+	const util::Counter<Attractor> found = gen::random_states(n, states)
+			| parallel(cached(compiled, cache), threads);
+	print("CLOCK, parallel", states / timer.elapsed(), base, cache);
+	ok = ok && same(found, plain);
+	if (!ok) {
+		std::cerr << "cached and uncached searches differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file codegen_benchmark.cpp
+ *
+ * Generates, compiles and loads the update function of a network, then
+ * compares its throughput with ImmutableBooleanNetwork and CompiledNetwork.
+ * With option @c -s it only prints the generated source code.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/GeneratedNetwork.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Times @a steps updates of @a net from state @a s.
+ * @return steps per second
+ */
+double throughput(bn::BooleanDynamics& net, bn::State& s,
+		const std::size_t steps) {
+	bn::util::Stopwatch timer;
+	for (std::size_t i = 0; i < steps; ++i)
+		net.update(s);
+	return steps / timer.elapsed();
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following required parameters in order:
+ * @li path to topology file
+ * @li path to node function file
+ * @li number of steps, or @c -s to print the generated code
+ * @li seed for the random number generator (unless @c -s is given)
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 4 || (argc < 5 && std::strcmp(argv[3], "-s") != 0)) {
+		std::cerr << "usage: " << argv[0] << " topology functions (steps seed | -s)"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	ImmutableBooleanNetwork net = ImmutableBooleanNetwork::makeNetwork(argv[1],
+			argv[2]);
+	if (std::strcmp(argv[3], "-s") == 0) {
+		GeneratedNetwork::generate(net, std::cout);
+		return EXIT_SUCCESS;
+	}
+	const std::size_t steps = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	util::Stopwatch timer;
+	GeneratedNetwork generated(net);
+	const double loadTime = timer.elapsed();
+	if (generated.isNative())
+		std::cout << "loaded " << generated.getLibrary() << " in " << loadTime
+				<< " s\n";
+	else
+		std::cout << "code generation failed, using the interpreted path\n";
+	CompiledNetwork compiled(net);
+	const State init = util::random_state(net.size());
+	State a(init), b(init), c(init);
+	const double graphRate = throughput(net, a, steps);
+	const double compiledRate = throughput(compiled, b, steps);
+	const double generatedRate = throughput(generated, c, steps);
+	std::cout << "nodes: " << net.size() << '\n';
+	std::cout << "ImmutableBooleanNetwork: " << graphRate << " steps/s\n";
+	std::cout << "CompiledNetwork: " << compiledRate << " steps/s ("
+			<< compiledRate / graphRate << "x)\n";
+	std::cout << "GeneratedNetwork: " << generatedRate << " steps/s ("
+			<< generatedRate / graphRate << "x)" << std::endl;
+	if (a != b || a != c) {
+		std::cerr << "trajectories differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file compiled_benchmark.cpp
+ *
+ * Compares the throughput of the graph-based update(State&) of the network
+ * classes with CompiledNetwork::update(State&), checking that the two produce
+ * the same trajectory.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Times @a steps updates of @a net from state @a s.
+ * @return steps per second
+ */
+double throughput(bn::BooleanDynamics& net, bn::State& s,
+		const std::size_t steps) {
+	bn::util::Stopwatch timer;
+	for (std::size_t i = 0; i < steps; ++i)
+		net.update(s);
+	return steps / timer.elapsed();
+}
+
+/**
+ * Benchmarks one network.
+ * @return false if the two simulators disagree
+ */
+template<class Network> bool run(const std::string& name, Network& graph,
+		const std::size_t steps) {
+	using namespace bn;
+	CompiledNetwork compiled(graph);
+	const State init = util::random_state(graph.size());
+	State a(init), b(init);
+	const double base = throughput(graph, a, steps);
+	const double fast = throughput(compiled, b, steps);
+	std::cout << name << " (" << graph.size() << " nodes): " << base
+			<< " steps/s graph, " << fast << " steps/s compiled (" << fast
+			/ base << "x)" << std::endl;
+	return a == b;
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of steps per network
+ * @li seed for the random number generator
+ * @li one or more networks, each given either as a topology file followed by
+ * 	a node function file or as <tt>-r</tt> followed by the number of nodes and
+ * 	of inputs per node of a random network
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 5) {
+		std::cerr << "usage: " << argv[0]
+				<< " steps seed (topology functions | -r nodes k)..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t steps = std::atoi(argv[1]);
+	std::srand(std::atoi(argv[2]));
+	bool ok = true;
+	for (int i = 3; i + 1 < argc; i += 2) {
+		if (std::strcmp(argv[i], "-r") == 0 && i + 2 < argc) {
+			const std::size_t n = std::atoi(argv[i + 1]);
+			const std::size_t k = std::atoi(argv[i + 2]);
+			MutableBooleanNetwork net = make_random_network(n, k);
+			std::ostringstream name;
+			name << "random N=" << n << " K=" << k;
+			ok = run(name.str(), net, steps) && ok;
+			++i;
+		} else {
+			ImmutableBooleanNetwork net = ImmutableBooleanNetwork::makeNetwork(
+					argv[i], argv[i + 1]);
+			ok = run(argv[i], net, steps) && ok;
+		}
+	}
+	if (!ok) {
+		std::cerr << "graph and compiled trajectories differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
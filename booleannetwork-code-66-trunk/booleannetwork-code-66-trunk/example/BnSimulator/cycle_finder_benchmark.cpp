@@ -0,0 +1,137 @@
+/**
+ * @file cycle_finder_benchmark.cpp
+ *
+ * Compares the cycle finders on ordered, critical and chaotic ensembles of
+ * random networks, that is on networks with 1, 2 and 3 inputs per node.
+ *
+ * For every ensemble, the program pipes the same random initial states of
+ * the same networks into naive(...), brent(...), nivasch(...) and
+ * nivasch<4>(...) on a CompiledNetwork, and prints for each of them the
+ * searches per second and the steps per search, those taken to build the
+ * attractor included. It fails if two cycle finders find other attractors,
+ * or other counts, on the same network.
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/cycle_finder.hpp>
+#include <BnSimulator/gen/RandomStateGen.hpp>
+#include <BnSimulator/util/Counter.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Dynamics that count the steps of a CompiledNetwork.
+ */
+struct CountingNetwork {
+	typedef bn::State state_type;
+	bn::CompiledNetwork& net;
+	std::size_t steps;
+	CountingNetwork(bn::CompiledNetwork& net) :
+		net(net), steps(0) {
+	}
+	void step(const bn::State& in, bn::State& out) {
+		++steps;
+		net.step(in, out);
+	}
+};
+
+const std::size_t FINDERS = 4;
+
+const char* NAMES[FINDERS] = { "naive", "brent", "nivasch", "nivasch<4>" };
+
+/**
+ * Runs cycle finder @a i of @a dyn from @a states random states drawn with
+ * seed @a seed.
+ */
+template<class D> bn::util::Counter<bn::Attractor> run(const std::size_t i,
+		D& dyn, const std::size_t nodes, const std::size_t states,
+		const int seed) {
+	using namespace bn;
+	std::srand(seed);
+	switch (i) {
+	case 0:
+		return util::Counter<Attractor>(gen::random_states(nodes, states)
+				| naive(dyn));
+	case 1:
+		return util::Counter<Attractor>(gen::random_states(nodes, states)
+				| brent(dyn));
+	case 2:
+		return util::Counter<Attractor>(gen::random_states(nodes, states)
+				| nivasch(dyn));
+	default:
+		return util::Counter<Attractor>(gen::random_states(nodes, states)
+				| nivasch<4> (dyn));
+	}
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of networks per ensemble
+ * @li number of initial states per network
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 5) {
+		std::cerr << "usage: " << argv[0] << " nodes networks states seed"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t networks = std::atoi(argv[2]);
+	const std::size_t states = std::atoi(argv[3]);
+	const int seed = std::atoi(argv[4]);
+	const char* ensembles[] = { "ordered", "critical", "chaotic" };
+	bool ok = true;
+	for (std::size_t k = 1; k <= 3; ++k) {
+		std::srand(seed + k);
+		double seconds[FINDERS] = { };
+		std::size_t steps[FINDERS] = { };
+		for (std::size_t net = 0; net < networks; ++net) {
+			const MutableBooleanNetwork graph = make_random_network(n, k);
+			CompiledNetwork compiled(graph);
+			CountingNetwork counting(compiled);
+			const int first = std::rand();
+			util::Counter<Attractor> expected;
+			for (std::size_t i = 0; i < FINDERS; ++i) {
+				util::Stopwatch timer;
+				const util::Counter<Attractor> found = run(i, compiled, n,
+						states, first);
+				seconds[i] += timer.elapsed();
+				counting.steps = 0;
+				run(i, counting, n, states, first);
+				steps[i] += counting.steps;
+				if (i == 0)
+					expected = found;
+				ok = ok && found.size() == expected.size()
+						&& found.insertions() == expected.insertions()
+						&& std::equal(found.begin(), found.end(),
+								expected.begin());
+			}
+			std::srand(first);
+		}
+		std::cout << ensembles[k - 1] << " (N=" << n << " K=" << k << "):";
+		for (std::size_t i = 0; i < FINDERS; ++i)
+			std::cout << ' ' << NAMES[i] << ' ' << networks * states
+					/ seconds[i] << " searches/s " << double(steps[i])
+					/ (networks * states) << " steps;";
+		std::cout << std::endl;
+	}
+	if (!ok) {
+		std::cerr << "the cycle finders differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
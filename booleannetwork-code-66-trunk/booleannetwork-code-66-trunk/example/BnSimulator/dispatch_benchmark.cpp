@@ -0,0 +1,127 @@
+/**
+ * @file dispatch_benchmark.cpp
+ *
+ * Measures the cost of virtual steps in the cycle finders on small networks,
+ * whose steps cost about as much as a call.
+ *
+ * For every network size, the program runs Brent's cycle finder from a
+ * number of random states of a random network, through a reference to
+ * BasicBooleanDynamics, whose steps are virtual calls, and through the
+ * network class itself, whose steps are called directly (see
+ * is_leaf_dynamics). It does so with a FixedWidthNetwork, whose step is
+ * defined in its header and can be inlined, and with a CompiledNetwork,
+ * whose step is not; then it times a long trajectory in both ways. It prints
+ * the rates of every mode and checks that both find the same attractors.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/FixedWidthNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/cycle_finder.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Runs Brent's cycle finder on @a dyn from every state of @a init.
+ * @param lengths the sum of the lengths of the attractors found
+ * @return searches per second
+ */
+template<class D> double search(D& dyn,
+		const std::vector<typename D::state_type>& init, std::size_t& lengths) {
+	bn::util::Stopwatch timer;
+	lengths = 0;
+	for (std::size_t t = 0; t < init.size(); ++t)
+		lengths += bn::cycle_finder::brent(dyn, init[t]).getLength();
+	return init.size() / timer.elapsed();
+}
+
+/**
+ * Advances a trajectory of @a dyn by @a steps steps.
+ * @param s the initial state, and the final one on return
+ * @return steps per second
+ */
+template<class D> double walk(D& dyn, typename D::state_type& s,
+		const std::size_t steps) {
+	bn::util::Stopwatch timer;
+	bn::BasicTrajectoryRange<typename D::state_type, D> r(dyn, s, steps);
+	typename bn::BasicTrajectoryRange<typename D::state_type, D>::iterator it =
+			r.begin();
+	for (std::size_t i = 1; i < steps; ++i)
+		++it;
+	s = *it;
+	return steps / timer.elapsed();
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of inputs per node
+ * @li number of initial states
+ * @li number of steps of the trajectory
+ * @li seed for the random number generator
+ * @li one or more network sizes, at most 64
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0] << " k states steps seed nodes..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t k = std::atoi(argv[1]);
+	const std::size_t states = std::atoi(argv[2]);
+	const std::size_t steps = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	bool ok = true;
+	for (int a = 5; a < argc; ++a) {
+		const std::size_t n = std::atoi(argv[a]);
+		if (n > 64) {
+			std::cerr << "networks have at most 64 nodes" << std::endl;
+			return EXIT_FAILURE;
+		}
+		const MutableBooleanNetwork graph = make_random_network(n, k);
+		FixedWidthNetwork<64> fixed(graph);
+		CompiledNetwork compiled(graph);
+		// through volatile pointers, lest the compiler devirtualize the calls
+		BasicBooleanDynamics<State64>* volatile pf = &fixed;
+		BasicBooleanDynamics<State>* volatile pc = &compiled;
+		BasicBooleanDynamics<State64>& virtualFixed = *pf;
+		BasicBooleanDynamics<State>& virtualCompiled = *pc;
+		std::vector<State> init;
+		std::vector<State64> init64;
+		for (std::size_t t = 0; t < states; ++t) {
+			init.push_back(util::random_state(n));
+			init64.push_back(State64(init.back()));
+		}
+		std::size_t l1, l2, l3, l4;
+		const double fv = search(virtualFixed, init64, l1);
+		const double fs = search(fixed, init64, l2);
+		const double cv = search(virtualCompiled, init, l3);
+		const double cs = search(compiled, init, l4);
+		State64 s1(init64[0]), s2(init64[0]);
+		const double wv = walk(virtualFixed, s1, steps);
+		const double ws = walk(fixed, s2, steps);
+		std::cout << "N=" << n << ": FixedWidthNetwork " << fv
+				<< " searches/s virtual, " << fs / fv
+				<< "x static; CompiledNetwork " << cv
+				<< " searches/s virtual, " << cs / cv
+				<< "x static; trajectory " << wv << " steps/s virtual, " << ws
+				/ wv << "x static" << std::endl;
+		ok = ok && l1 == l2 && l2 == l3 && l3 == l4 && s1 == s2;
+	}
+	if (!ok) {
+		std::cerr << "virtual and static dispatch results differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
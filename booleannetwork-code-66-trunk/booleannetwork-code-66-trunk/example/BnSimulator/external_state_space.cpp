@@ -0,0 +1,134 @@
+/**
+ * @file external_state_space.cpp
+ *
+ * Analyzes the whole state space of a random network with
+ * ExternalFunctionalGraph, interrupting and resuming the analysis, and
+ * compares the results with those of FunctionalGraph.
+ *
+ * The analysis first runs in a child process, which is killed after a delay;
+ * then the program resumes it from the files left in the directory, prints
+ * its time and the number of attractors, and fails unless the distributions
+ * account for every state and random states reach the attractor of their
+ * label, found by Brent's cycle finder, in exactly as many steps as their
+ * transient length. Up to 32 nodes it also fails unless attractors, basin
+ * sizes, distributions and the labels and transient lengths of random states
+ * are the same as those found in memory.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/ExternalFunctionalGraph.hpp>
+#include <BnSimulator/experiment/FunctionalGraph.hpp>
+#include <BnSimulator/experiment/cycle_finder.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Tells whether a distribution accounts for @a states states, weighted by
+ * @a weighted.
+ */
+bool accounts(const bn::ExternalFunctionalGraph::Distribution& distribution,
+		const boost::uint64_t states, const bool weighted) {
+	boost::uint64_t sum = 0;
+	for (bn::ExternalFunctionalGraph::Distribution::const_iterator d =
+			distribution.begin(); d != distribution.end(); ++d)
+		sum += d->second * (weighted ? d->first : 1);
+	return sum == states;
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes, at most 40, and at most 32 for the comparison
+ * @li number of inputs per node
+ * @li seed for the random number generator
+ * @li an empty directory for the files of the analysis
+ * @li memory for the sorts, in bytes
+ * @li delay before the interruption, in milliseconds
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 7) {
+		std::cerr << "usage: " << argv[0]
+				<< " nodes k seed directory memory delay" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	std::srand(std::atoi(argv[3]));
+	const std::size_t memory = std::atol(argv[5]);
+	if (n == 0 || n > ExternalFunctionalGraph::MAX_NODES) {
+		std::cerr << "networks have 1 to " << ExternalFunctionalGraph::MAX_NODES
+				<< " nodes" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const MutableBooleanNetwork graph = make_random_network(n, k);
+	CompiledNetwork compiled(graph);
+	const pid_t child = fork();
+	if (child == 0) {
+		ExternalFunctionalGraph interrupted(argv[4], memory);
+		interrupted.analyze(compiled);
+		_exit(EXIT_SUCCESS);
+	}
+	usleep(1000 * std::atoi(argv[6]));
+	kill(child, SIGKILL);
+	waitpid(child, NULL, 0);
+	util::Stopwatch timer;
+	ExternalFunctionalGraph external(argv[4], memory);
+	if (!external.analyze(compiled)) {
+		std::cerr << "the analysis failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "N=" << n << " K=" << k << ": " << external.numAttractors()
+			<< " attractors, " << external.getGardenOfEden()
+			<< " Garden-of-Eden states; resumed in " << timer.elapsed()
+			<< " s" << std::endl;
+	const boost::uint64_t states = external.numStates();
+	bool ok = accounts(external.getTransients(), states, false) && accounts(
+			external.getInDegrees(), states, false) && accounts(
+			external.getInDegrees(), states, true);
+	for (std::size_t t = 0; t < 1000; ++t) {
+		State s = util::random_state(n);
+		const std::size_t a = external.getAttractorOf(s);
+		for (boost::uint64_t i = external.getTransient(s); i > 0; --i) {
+			compiled.update(s);
+			ok = ok && external.getTransient(s) == i - 1;
+		}
+		ok = ok && external.getAttractorOf(s) == a && external.getAttractor(a)
+				== cycle_finder::brent(compiled, s);
+	}
+	if (n <= FunctionalGraph::MAX_NODES) {
+		timer.restart();
+		const FunctionalGraph space(compiled);
+		std::cout << "in memory: " << timer.elapsed() << " s" << std::endl;
+		ok = ok && external.numAttractors() == space.numAttractors()
+				&& external.getTransients() == space.getTransients()
+				&& external.getInDegrees() == space.getInDegrees();
+		for (std::size_t i = 0; ok && i < space.numAttractors(); ++i)
+			ok = external.getAttractor(i) == space.getAttractor(i)
+					&& external.getBasinSize(i) == space.getBasinSize(i);
+		for (std::size_t t = 0; t < 1000; ++t) {
+			const State s = util::random_state(n);
+			ok = ok && external.getAttractorOf(s) == space.getAttractorOf(s)
+					&& external.getTransient(s) == space.getTransient(s);
+		}
+	}
+	if (!ok) {
+		std::cerr << "the analyses differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
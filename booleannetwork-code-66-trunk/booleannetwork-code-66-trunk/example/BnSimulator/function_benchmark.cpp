@@ -0,0 +1,161 @@
+/**
+ * @file function_benchmark.cpp
+ *
+ * Times the word-level operations of BooleanFunction (clamped(), isInfluent()
+ * and evaluation) for arities 1 to 16 against bit-at-a-time reference
+ * implementations, and checks on random functions that both give the same
+ * results.
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include <BnSimulator/core/BooleanFunction.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+using bn::BooleanFunction;
+
+/**
+ * Index of the entry of an arity @e k table corresponding to entry @a j of
+ * the table of the function clamped at input @a i.
+ */
+std::size_t expand(const std::size_t j, const std::size_t i, const bool v) {
+	const std::size_t low = j & ((std::size_t(1) << i) - 1);
+	return low | std::size_t(v) << i | (j >> i) << (i + 1);
+}
+
+BooleanFunction reference_clamped(const BooleanFunction& f,
+		const std::size_t i, const bool v) {
+	std::vector<int> tt(f.size() / 2);
+	for (std::size_t j = 0; j < tt.size(); ++j)
+		tt[j] = f[expand(j, i, v)];
+	return BooleanFunction(tt);
+}
+
+bool reference_influent(const BooleanFunction& f, const std::size_t i) {
+	for (std::size_t j = 0; j < f.size() / 2; ++j)
+		if (f[expand(j, i, false)] != f[expand(j, i, true)])
+			return true;
+	return false;
+}
+
+bool reference_eval(const BooleanFunction& f, const bn::State& x) {
+	boost::uint64_t index = 0;
+	for (std::size_t j = 0; j < x.size(); ++j)
+		index |= boost::uint64_t(x[j]) << j;
+	return f[index];
+}
+
+/**
+ * Returns a random function of arity @a k, which ignores input @a ignored if
+ * it is less than @a k.
+ */
+BooleanFunction random_function(const std::size_t k,
+		const std::size_t ignored) {
+	std::vector<int> tt(std::size_t(1) << k);
+	for (std::size_t j = 0; j < tt.size(); ++j)
+		tt[j] = (j >> ignored & 1) ? tt[j ^ std::size_t(1) << ignored]
+				: std::rand() % 2;
+	return BooleanFunction(tt);
+}
+
+bn::State random_input(const std::size_t k) {
+	bn::State x(k);
+	for (std::size_t j = 0; j < k; ++j)
+		x[j] = std::rand() % 2;
+	return x;
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of random functions per arity
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 3) {
+		std::cerr << "usage: " << argv[0] << " functions seed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t m = std::atoi(argv[1]);
+	std::srand(std::atoi(argv[2]));
+	bool ok = true;
+	for (std::size_t k = 1; k <= 16; ++k) {
+		std::vector<BooleanFunction> functions;
+		std::vector<State> inputs;
+		for (std::size_t f = 0; f < m; ++f) {
+			// some functions ignore an input, some are constant
+			if (f % 8 == 1 || f % 8 == 2)
+				functions.push_back(BooleanFunction(std::vector<int>(
+						std::size_t(1) << k, f % 8 == 1)));
+			else
+				functions.push_back(random_function(k, f % 2 ? std::rand()
+						% k : k));
+			inputs.push_back(random_input(k));
+		}
+		// equivalence
+		for (std::size_t f = 0; f < m; ++f) {
+			const BooleanFunction& g = functions[f];
+			for (std::size_t i = 0; i < k; ++i) {
+				ok = ok && g.isInfluent(i) == reference_influent(g, i);
+				ok = ok && g.clamped(i, false) == reference_clamped(g, i, false);
+				ok = ok && g.clamped(i, true) == reference_clamped(g, i, true);
+			}
+			ok = ok && g(inputs[f]) == reference_eval(g, inputs[f]);
+			const std::vector<int> tt = g.truthTable();
+			const bool allZeros = std::count(tt.begin(), tt.end(), 0)
+					== int(tt.size());
+			const bool allOnes = std::count(tt.begin(), tt.end(), 1)
+					== int(tt.size());
+			ok = ok && g.isConstant() == std::make_pair(allZeros || allOnes,
+					allOnes);
+		}
+		// timing
+		std::size_t sink = 0, ops = 0;
+		util::Stopwatch timer;
+		for (std::size_t f = 0; f < m; ++f)
+			for (std::size_t i = 0; i < k; ++i, ops += 3) {
+				sink += functions[f].isInfluent(i);
+				sink += functions[f].clamped(i, false).getArity();
+				sink += functions[f].clamped(i, true).getArity();
+			}
+		const double words = ops / timer.elapsed();
+		timer.restart();
+		for (std::size_t f = 0; f < m; ++f)
+			for (std::size_t i = 0; i < k; ++i) {
+				sink += reference_influent(functions[f], i);
+				sink += reference_clamped(functions[f], i, false).getArity();
+				sink += reference_clamped(functions[f], i, true).getArity();
+			}
+		const double bits = ops / timer.elapsed();
+		std::size_t evals = 0;
+		timer.restart();
+		for (std::size_t r = 0; r < 100; ++r)
+			for (std::size_t f = 0; f < m; ++f, ++evals)
+				sink += functions[f](inputs[f]);
+		const double fastEval = evals / timer.elapsed();
+		timer.restart();
+		for (std::size_t r = 0; r < 100; ++r)
+			for (std::size_t f = 0; f < m; ++f)
+				sink += reference_eval(functions[f], inputs[f]);
+		const double slowEval = evals / timer.elapsed();
+		std::cout << "k=" << k << ": clamp/influence " << words
+				<< " ops/s (" << words / bits << "x), evaluation " << fastEval
+				<< " ops/s (" << fastEval / slowEval << "x)" << (sink ? ""
+				: " ") << std::endl;
+	}
+	if (!ok) {
+		std::cerr << "word-level and reference results differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file hash_benchmark.cpp
+ *
+ * Compares the default state hash (BitsetHasher) with the former xor-fold
+ * hash (XorBitsetHasher) on three sets of states:
+ * @li the states visited by trajectories of a random network;
+ * @li all the states with exactly two active nodes;
+ * @li random states together with copies whose blocks are rotated.
+ *
+ * For each set and hash it prints the number of colliding full hashes, the
+ * largest bucket of a table as large as the set, the hashing throughput and
+ * the time taken to fill a hashed set.
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/unordered_set.hpp>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+using bn::State;
+
+template<class Hasher> void report(const std::string& name,
+		const std::string& set, const std::vector<State>& states) {
+	const Hasher hash = Hasher();
+	std::vector<std::size_t> hashes(states.size());
+	const std::size_t rounds = 1 + (1 << 22) / states.size();
+	bn::util::Stopwatch timer;
+	for (std::size_t r = 0; r < rounds; ++r)
+		for (std::size_t i = 0; i < states.size(); ++i)
+			hashes[i] = hash(states[i]);
+	const double rate = rounds * states.size() / timer.elapsed();
+	std::size_t buckets = 1;
+	while (buckets < states.size())
+		buckets *= 2;
+	std::vector<std::size_t> load(buckets);
+	for (std::size_t i = 0; i < hashes.size(); ++i)
+		++load[hashes[i] & (buckets - 1)];
+	const std::size_t maxLoad = *std::max_element(load.begin(), load.end());
+	std::sort(hashes.begin(), hashes.end());
+	const std::size_t collisions = hashes.size() - (std::unique(
+			hashes.begin(), hashes.end()) - hashes.begin());
+	timer.restart();
+	boost::unordered_set<State, Hasher> container(states.begin(),
+			states.end());
+	const double fill = timer.elapsed();
+	std::cout << set << ", " << name << ": " << collisions << " collisions, "
+			<< "largest bucket " << maxLoad << " of " << buckets << ", "
+			<< rate << " hashes/s, set filled in " << fill << " s ("
+			<< container.size() << " states)" << std::endl;
+}
+
+void compare(const std::string& set, std::vector<State> states) {
+	std::sort(states.begin(), states.end());
+	states.erase(std::unique(states.begin(), states.end()), states.end());
+	report<bn::BitsetHasher> ("wy", set, states);
+	report<bn::XorBitsetHasher> ("xor", set, states);
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li number of trajectories
+ * @li number of steps per trajectory
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0]
+				<< " nodes k trajectories steps seed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t trajectories = std::atoi(argv[3]);
+	const std::size_t steps = std::atoi(argv[4]);
+	std::srand(std::atoi(argv[5]));
+	CompiledNetwork net(make_random_network(n, k));
+	std::vector<State> states;
+	for (std::size_t t = 0; t < trajectories; ++t) {
+		State s = util::random_state(n);
+		for (std::size_t i = 0; i < steps; ++i, net.update(s))
+			states.push_back(s);
+	}
+	compare("trajectories", states);
+	states.clear();
+	for (std::size_t i = 0; i < n; ++i)
+		for (std::size_t j = i + 1; j < n; ++j) {
+			State s(n);
+			s.set(i);
+			s.set(j);
+			states.push_back(s);
+		}
+	compare("two active nodes", states);
+	states.clear();
+	for (std::size_t i = 0; i < trajectories * steps / 2; ++i) {
+		const State s = util::random_state(n);
+		states.push_back(s);
+		std::vector<State::block_type> blocks(s.num_blocks());
+		boost::to_block_range(s, blocks.begin());
+		std::rotate(blocks.begin(), blocks.begin() + 1, blocks.end());
+		if (n % State::bits_per_block) // bits beyond n must be 0
+			blocks.back() &= (State::block_type(1) << n % State::bits_per_block)
+					- 1;
+		State r(n);
+		boost::from_block_range(blocks.begin(), blocks.end(), r);
+		states.push_back(r);
+	}
+	compare("rotated blocks", states);
+	return EXIT_SUCCESS;
+}
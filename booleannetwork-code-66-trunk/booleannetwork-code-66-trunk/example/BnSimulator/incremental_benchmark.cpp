@@ -0,0 +1,82 @@
+/**
+ * @file incremental_benchmark.cpp
+ *
+ * Compares the throughput of the graph-based update(State&), of
+ * CompiledNetwork and of IncrementalNetwork on random networks of given bias,
+ * checking that the three produce the same trajectory. Networks with a small
+ * bias are ordered and most of their nodes freeze after a short transient,
+ * which is where the incremental update pays off.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/IncrementalNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Times @a steps updates of @a net from state @a s.
+ * @return steps per second
+ */
+double throughput(bn::BooleanDynamics& net, bn::State& s,
+		const std::size_t steps) {
+	bn::util::Stopwatch timer;
+	for (std::size_t i = 0; i < steps; ++i)
+		net.update(s);
+	return steps / timer.elapsed();
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li number of steps per network
+ * @li seed for the random number generator
+ * @li one or more biases, that is probabilities of a 1 in truth tables
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0] << " nodes k steps seed bias..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t steps = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	bool ok = true;
+	for (int i = 5; i < argc; ++i) {
+		const double bias = std::atof(argv[i]);
+		MutableBooleanNetwork graph = make_random_network(n, k, bias);
+		CompiledNetwork compiled(graph);
+		IncrementalNetwork incremental(graph);
+		const State init = util::random_state(n);
+		State a(init), b(init), c(init);
+		const double base = throughput(graph, a, steps);
+		const double flat = throughput(compiled, b, steps);
+		const double fast = throughput(incremental, c, steps);
+		std::cout << "N=" << n << " K=" << k << " p=" << bias << ": " << base
+				<< " steps/s graph, " << flat << " steps/s compiled, " << fast
+				<< " steps/s incremental (" << fast / base << "x graph, "
+				<< fast / flat << "x compiled, "
+				<< incremental.getIncrementalSteps() << " of " << steps
+				<< " steps incremental)" << std::endl;
+		ok = ok && a == b && b == c;
+	}
+	if (!ok) {
+		std::cerr << "trajectories differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
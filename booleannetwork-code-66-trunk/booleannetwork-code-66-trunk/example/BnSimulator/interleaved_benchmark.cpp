@@ -0,0 +1,118 @@
+/**
+ * @file interleaved_benchmark.cpp
+ *
+ * Measures how interleaving independent trajectories hides memory latency.
+ *
+ * For every network size, the program advances a number of trajectories of a
+ * random network one after the other with CompiledNetwork, then together
+ * with InterleavedNetwork in groups of 1, 4 and 8 lanes, with and without
+ * prefetching, and prints the state updates per second of each mode. Sizes
+ * should span from states that fit in L2 to states that only fit in memory.
+ * It checks that every mode produces the same states, and that basin
+ * sampling with the interleaved cycle finder counts the same attractors as
+ * with Brent's cycle finder.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/InterleavedNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/basin_of_attraction.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Advances @a states by @a steps steps in groups of @a lanes trajectories.
+ * @return state updates per second
+ */
+double interleaved(bn::InterleavedNetwork& net, std::vector<bn::State>& states,
+		const std::size_t lanes, const std::size_t steps) {
+	bn::util::Stopwatch timer;
+	for (std::size_t first = 0; first < states.size(); first += lanes) {
+		std::vector<bn::State> group(states.begin() + first, states.begin()
+				+ std::min(first + lanes, states.size()));
+		for (std::size_t i = 0; i < steps; ++i)
+			net.update(group);
+		std::copy(group.begin(), group.end(), states.begin() + first);
+	}
+	return states.size() * steps / timer.elapsed();
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of inputs per node
+ * @li number of trajectories
+ * @li number of steps per trajectory
+ * @li seed for the random number generator
+ * @li one or more network sizes
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0]
+				<< " k trajectories steps seed nodes..." << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t k = std::atoi(argv[1]);
+	const std::size_t trajectories = std::atoi(argv[2]);
+	const std::size_t steps = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	bool ok = true;
+	for (int a = 5; a < argc; ++a) {
+		const std::size_t n = std::atoi(argv[a]);
+		const MutableBooleanNetwork graph = make_random_network(n, k);
+		CompiledNetwork compiled(graph);
+		InterleavedNetwork net(graph);
+		std::vector<State> init;
+		for (std::size_t t = 0; t < trajectories; ++t)
+			init.push_back(util::random_state(n));
+		std::vector<State> serial(init);
+		util::Stopwatch timer;
+		for (std::size_t t = 0; t < trajectories; ++t)
+			for (std::size_t i = 0; i < steps; ++i)
+				compiled.update(serial[t]);
+		const double base = trajectories * steps / timer.elapsed();
+		std::cout << "N=" << n << " (" << n / 8192 << " KiB per state): "
+				<< base << " updates/s serial";
+		const std::size_t lanes[] = { 1, 4, 8 };
+		const std::size_t distance = net.getPrefetchDistance();
+		for (std::size_t l = 0; l < 3; ++l)
+			for (std::size_t prefetch = 0; prefetch < 2; ++prefetch) {
+				net.setPrefetchDistance(prefetch ? distance : 0);
+				std::vector<State> states(init);
+				const double rate = interleaved(net, states, lanes[l], steps);
+				std::cout << ", " << lanes[l] << " lanes" << (prefetch ? "+pf"
+						: "") << " " << rate / base << "x";
+				ok = ok && states == serial;
+			}
+		std::cout << std::endl;
+	}
+	// basin sampling in both execution modes
+	const MutableBooleanNetwork graph = make_random_network(1000, 2);
+	CompiledNetwork compiled(graph);
+	InterleavedNetwork net(graph);
+	std::vector<State> init;
+	for (std::size_t t = 0; t < trajectories; ++t)
+		init.push_back(util::random_state(graph.size()));
+	const util::Counter<Attractor> one = basin_of_attraction(init, brent(
+			compiled));
+	const util::Counter<Attractor> many = basin_of_attraction(init,
+			interleaved(net, 8));
+	ok = ok && one.insertions() == many.insertions() && std::equal(
+			one.begin(), one.end(), many.begin());
+	if (!ok) {
+		std::cerr << "serial and interleaved results differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
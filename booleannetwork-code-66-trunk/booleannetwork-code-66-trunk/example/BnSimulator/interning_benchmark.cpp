@@ -0,0 +1,65 @@
+/**
+ * @file interning_benchmark.cpp
+ *
+ * Builds an ensemble of random networks and reports how many distinct
+ * functions they contain, and the memory taken by their truth tables with
+ * and without the sharing provided by FunctionPool.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/FunctionPool.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of networks
+ * @li number of nodes per network
+ * @li number of inputs per node
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 5) {
+		std::cerr << "usage: " << argv[0] << " networks nodes k seed"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t m = std::atoi(argv[1]);
+	const std::size_t n = std::atoi(argv[2]);
+	const std::size_t k = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	util::Stopwatch timer;
+	std::vector<MutableBooleanNetwork> ensemble;
+	for (std::size_t i = 0; i < m; ++i)
+		ensemble.push_back(make_random_network(n, k));
+	const double elapsed = timer.elapsed();
+	const FunctionPool& pool = FunctionPool::global();
+	const std::size_t tableBytes = (((std::size_t(1) << k) + 63) / 64) * 8;
+	std::cout << m << " networks of " << n << " nodes, K=" << k << ": "
+			<< m * n << " functions, " << pool.size() << " distinct ("
+			<< pool.getHits() << " of " << pool.getLookups()
+			<< " lookups hit)\n" << "truth tables: " << m * n * tableBytes
+			<< " bytes unshared, " << pool.memory() << " bytes shared\n"
+			<< "built in " << elapsed << " s" << std::endl;
+	// interned functions are equal to the originals and share their storage
+	bool ok = true;
+	for (std::size_t i = 0; i < ensemble.size(); ++i)
+		for (std::size_t v = 0; v < n; ++v) {
+			const BooleanFunction f = ensemble[i].getFunction(v);
+			ok = ok && FunctionPool::global().intern(BooleanFunction(
+					f.truthTable())) == f;
+		}
+	if (!ok) {
+		std::cerr << "interned functions differ from the originals"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
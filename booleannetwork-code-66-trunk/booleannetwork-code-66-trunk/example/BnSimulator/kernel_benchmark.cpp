@@ -0,0 +1,108 @@
+/**
+ * @file kernel_benchmark.cpp
+ *
+ * Reports the throughput of every bucket of CompiledNetwork, that is of the
+ * kernel specialized on each in-degree, against the generic kernel.
+ *
+ * For every in-degree @e K from 0 to 10 the program times a random network
+ * with fixed @e K, which runs entirely in the bucket of that in-degree, and
+ * prints the node evaluations per second of both kernels. It then does the
+ * same on a network whose in-degrees are uniform between 1 and 10, and
+ * checks that both kernels always produce the same trajectory.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Times @a steps updates of @a net from state @a s, with the specialized
+ * kernels or the generic one.
+ * @return node evaluations per second
+ */
+double throughput(bn::CompiledNetwork& net, bn::State& s,
+		const std::size_t steps, const bool specialized) {
+	net.setSpecialized(specialized);
+	bn::util::Stopwatch timer;
+	for (std::size_t i = 0; i < steps; ++i)
+		net.update(s);
+	return steps * net.size() / timer.elapsed();
+}
+
+/**
+ * Prints the throughput of both kernels on @a net.
+ * @return @e true if they produce the same trajectory
+ */
+bool report(const char* name, bn::CompiledNetwork& net,
+		const std::size_t steps) {
+	const bn::State init = bn::util::random_state(net.size());
+	bn::State fast(init), slow(init);
+	const double specialized = throughput(net, fast, steps, true);
+	const double generic = throughput(net, slow, steps, false);
+	std::cout << name << ": " << specialized << " evaluations/s specialized, "
+			<< generic << " generic (" << specialized / generic << "x)"
+			<< std::endl;
+	return fast == slow;
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of steps per network
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 4) {
+		std::cerr << "usage: " << argv[0] << " nodes steps seed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t steps = std::atoi(argv[2]);
+	std::srand(std::atoi(argv[3]));
+	bool ok = true;
+	for (std::size_t k = 0; k <= 10; ++k) {
+		CompiledNetwork net(make_random_network(n, k));
+		std::cout << "K=" << k << " (" << (k
+				<= CompiledNetwork::MAX_SPECIALIZED_ARITY ? "specialized"
+				: "generic") << " bucket) ";
+		ok = report("", net, steps) && ok;
+	}
+	std::vector<std::vector<std::size_t> > topology(n);
+	std::vector<BooleanFunction> functions(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		const std::size_t k = 1 + std::rand() % 10;
+		for (std::size_t j = 0; j < k; ++j)
+			topology[i].push_back(std::rand() % n);
+		std::vector<int> table(std::size_t(1) << k);
+		for (std::size_t j = 0; j < table.size(); ++j)
+			table[j] = std::rand() % 2;
+		functions[i] = BooleanFunction(table);
+	}
+	CompiledNetwork mixed(ImmutableBooleanNetwork::makeNetwork(topology,
+			functions));
+	const std::vector<std::size_t> sizes = mixed.bucketSizes();
+	std::cout << "mixed network, bucket sizes:";
+	for (std::size_t k = 0; k < sizes.size(); ++k)
+		std::cout << " " << sizes[k];
+	std::cout << std::endl;
+	ok = report("mixed network", mixed, steps) && ok;
+	if (!ok) {
+		std::cerr << "specialized and generic kernels differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
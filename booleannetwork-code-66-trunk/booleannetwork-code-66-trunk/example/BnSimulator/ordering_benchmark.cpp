@@ -0,0 +1,121 @@
+/**
+ * @file ordering_benchmark.cpp
+ *
+ * Measures the effect of the node numbering on the update of an
+ * ImmutableBooleanNetwork.
+ *
+ * The network has local structure, as many genome-scale networks do: every
+ * node reads inputs among the nodes closest to it on a ring. Nodes are then
+ * shuffled, as if they had been numbered arbitrarily in the topology file.
+ * For each NodeOrdering the program prints the fraction of input reads that
+ * fall on a different 64-byte line of the state than the previous read,
+ * which approximates the cache miss rate of a step, and the throughput of
+ * update() and of update(State&), which both permute the state in and out,
+ * checking that all orderings produce the same trajectory.
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/node_ordering.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+const char* const NAMES[] = { "natural", "bfs", "rcm" };
+
+/**
+ * Fraction of input reads of a step, in the numbering given by @a order,
+ * that access a different line than the previous read.
+ */
+double line_changes(const std::vector<std::vector<std::size_t> >& topology,
+		const std::vector<std::size_t>& order) {
+	const std::size_t lineBits = 512;
+	std::vector<std::size_t> rank(order.size());
+	for (std::size_t i = 0; i < order.size(); ++i)
+		rank[order[i]] = i;
+	std::size_t reads = 0, changes = 0, line = std::size_t(-1);
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		const std::vector<std::size_t>& in = topology[order[i]];
+		for (std::size_t j = 0; j < in.size(); ++j, ++reads) {
+			changes += rank[in[j]] / lineBits != line;
+			line = rank[in[j]] / lineBits;
+		}
+	}
+	return double(changes) / reads;
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li width of the neighbourhood among which inputs are chosen
+ * @li number of steps per run
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0] << " nodes k width steps seed"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t width = std::atoi(argv[3]);
+	const std::size_t steps = std::atoi(argv[4]);
+	std::srand(std::atoi(argv[5]));
+	std::vector<std::size_t> label(n); // position on the ring -> node
+	for (std::size_t i = 0; i < n; ++i)
+		label[i] = i;
+	std::random_shuffle(label.begin(), label.end());
+	std::vector<std::vector<std::size_t> > topology(n);
+	std::vector<BooleanFunction> functions(n);
+	for (std::size_t p = 0; p < n; ++p) {
+		for (std::size_t j = 0; j < k; ++j)
+			topology[label[p]].push_back(label[(p + n - width / 2 + std::rand()
+					% (width + 1)) % n]);
+		std::vector<int> table(std::size_t(1) << k);
+		for (std::size_t j = 0; j < table.size(); ++j)
+			table[j] = std::rand() % 2;
+		functions[label[p]] = BooleanFunction(table);
+	}
+	const State init = util::random_state(n);
+	State expected;
+	bool ok = true;
+	for (int o = NATURAL_ORDER; o <= RCM_ORDER; ++o) {
+		const NodeOrdering ordering = NodeOrdering(o);
+		ImmutableBooleanNetwork net = ImmutableBooleanNetwork::makeNetwork(
+				topology, functions, ordering);
+		net.setState(init);
+		util::Stopwatch timer;
+		net.update(steps);
+		const double internal = steps / timer.elapsed();
+		State s(init);
+		timer.restart();
+		for (std::size_t i = 0; i < steps; ++i)
+			net.update(s);
+		const double external = steps / timer.elapsed();
+		std::cout << NAMES[o] << ": "
+				<< line_changes(topology, node_order(topology, ordering))
+				<< " line changes per read, " << internal
+				<< " steps/s update(), " << external
+				<< " steps/s update(State&)" << std::endl;
+		if (o == NATURAL_ORDER)
+			expected = s;
+		ok = ok && s == expected && net.getState() == expected;
+	}
+	if (!ok) {
+		std::cerr << "trajectories differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
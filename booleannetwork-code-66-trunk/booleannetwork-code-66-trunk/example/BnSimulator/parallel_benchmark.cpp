@@ -0,0 +1,77 @@
+/**
+ * @file parallel_benchmark.cpp
+ *
+ * Measures how the throughput of ParallelNetwork scales with the number of
+ * threads on a random network, against the serial CompiledNetwork, checking
+ * that every run produces the same trajectory.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/ParallelNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Times @a steps updates of @a net from state @a s.
+ * @return steps per second
+ */
+double throughput(bn::BooleanDynamics& net, bn::State& s,
+		const std::size_t steps) {
+	bn::util::Stopwatch timer;
+	for (std::size_t i = 0; i < steps; ++i)
+		net.update(s);
+	return steps / timer.elapsed();
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li number of steps per run
+ * @li seed for the random number generator
+ * @li one or more thread counts
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0] << " nodes k steps seed threads..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t steps = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	const MutableBooleanNetwork graph = make_random_network(n, k);
+	const State init = util::random_state(n);
+	CompiledNetwork compiled(graph);
+	State serial(init);
+	const double base = throughput(compiled, serial, steps);
+	std::cout << "N=" << n << " K=" << k << ": " << base
+			<< " steps/s serial" << std::endl;
+	bool ok = true;
+	for (int i = 5; i < argc; ++i) {
+		ParallelNetwork parallel(graph, std::atoi(argv[i]));
+		State s(init);
+		const double fast = throughput(parallel, s, steps);
+		std::cout << parallel.numThreads() << " threads: " << fast
+				<< " steps/s (" << fast / base << "x)" << std::endl;
+		ok = ok && s == serial;
+	}
+	if (!ok) {
+		std::cerr << "serial and parallel trajectories differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file search_benchmark.cpp
+ *
+ * Measures how the throughput of the parallel cycle finder scales with the
+ * number of threads on a random network, against the serial pipeline.
+ *
+ * For every thread count, the program pipes the same random initial states
+ * into parallel(brent(...)) on a CompiledNetwork and prints the searches per
+ * second, the speedup over the serial pipeline and the number of attractors
+ * found. It fails if any run finds other attractors, or other counts, than
+ * the serial one.
+ */
+
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/parallel_cycle_finder.hpp>
+#include <BnSimulator/gen/RandomStateGen.hpp>
+#include <BnSimulator/util/Counter.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li number of initial states
+ * @li seed for the random number generator
+ * @li one or more thread counts
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0] << " nodes k states seed threads..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t states = std::atoi(argv[3]);
+	const int seed = std::atoi(argv[4]);
+	std::srand(seed);
+	const MutableBooleanNetwork graph = make_random_network(n, k);
+	CompiledNetwork compiled(graph);
+	// every run draws the same initial states
+	std::srand(seed + 1);
+	util::Stopwatch timer;
+	const util::Counter<Attractor> serial(gen::random_states(n, states)
+			| brent(compiled));
+	const double base = states / timer.elapsed();
+	std::cout << "N=" << n << " K=" << k << ": " << base
+			<< " searches/s serial, " << serial.size() << " attractors"
+			<< std::endl;
+	bool ok = true;
+	for (int i = 5; i < argc; ++i) {
+		const std::size_t threads = std::atoi(argv[i]);
+		std::srand(seed + 1);
+		timer.restart();
+		const util::Counter<Attractor> found = gen::random_states(n, states)
+				| parallel(brent(compiled), threads);
+		const double fast = states / timer.elapsed();
+		std::cout << threads << " threads: " << fast << " searches/s ("
+				<< fast / base << "x), " << found.size() << " attractors"
+				<< std::endl;
+		ok = ok && found.size() == serial.size() && found.insertions()
+				== serial.insertions() && std::equal(found.begin(),
+				found.end(), serial.begin());
+	}
+	if (!ok) {
+		std::cerr << "serial and parallel searches differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file shared_network.cpp
+ *
+ * Simulates one network from many threads at once, checking the results
+ * against a serial run.
+ *
+ * Every thread advances its own trajectories of a random network through the
+ * const step() of a single CompiledNetwork and of a single reordered
+ * ImmutableBooleanNetwork, each with a Scratch of its own, and through a
+ * clone of each of them. The program prints the time of a clone next to that
+ * of a step, and fails if any thread computes a state other than the serial
+ * one. It is meant to be built with -fsanitize=thread as well, which reports
+ * any data race on the shared networks.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Advances every state of @a states by @a steps steps through the const
+ * step() of @a net, and through a clone of it.
+ * @return @e true if the results equal @a expected
+ */
+template<class Network> bool advance(const Network& net,
+		const std::vector<bn::State>& states,
+		const std::vector<bn::State>& expected, const std::size_t steps) {
+	typename Network::Scratch scratch;
+	const boost::scoped_ptr<bn::BooleanDynamics> clone(net.clone());
+	bool ok = true;
+	for (std::size_t t = 0; t < states.size(); ++t) {
+		bn::State s(states[t]), next;
+		for (std::size_t i = 0; i < steps; ++i) {
+			net.step(s, next, scratch);
+			s.swap(next);
+		}
+		bn::State c(states[t]);
+		for (std::size_t i = 0; i < steps; ++i)
+			clone->update(c);
+		ok = ok && s == expected[t] && c == expected[t];
+	}
+	return ok;
+}
+
+/**
+ * Body of a thread, which stores its outcome in @a ok.
+ */
+void work(const bn::CompiledNetwork& compiled,
+		const bn::ImmutableBooleanNetwork& net,
+		const std::vector<bn::State>& states,
+		const std::vector<bn::State>& expected, const std::size_t steps,
+		int& ok) {
+	ok = advance(compiled, states, expected, steps) && advance(net, states,
+			expected, steps);
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li number of threads
+ * @li number of trajectories per thread
+ * @li number of steps per trajectory
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 7) {
+		std::cerr << "usage: " << argv[0]
+				<< " nodes k threads trajectories steps seed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t threads = std::atoi(argv[3]);
+	const std::size_t trajectories = std::atoi(argv[4]);
+	const std::size_t steps = std::atoi(argv[5]);
+	std::srand(std::atoi(argv[6]));
+	const MutableBooleanNetwork graph = make_random_network(n, k);
+	std::vector<std::vector<std::size_t> > topology;
+	for (std::size_t i = 0; i < n; ++i)
+		topology.push_back(graph.getInputs(i));
+	const ImmutableBooleanNetwork net = ImmutableBooleanNetwork::makeNetwork(
+			topology, graph.getFunctions(), BFS_ORDER);
+	const CompiledNetwork compiled(graph);
+	// serial reference
+	std::vector<State> states, expected;
+	CompiledNetwork serial(compiled);
+	for (std::size_t t = 0; t < trajectories; ++t) {
+		states.push_back(util::random_state(n));
+		expected.push_back(states.back());
+		for (std::size_t i = 0; i < steps; ++i)
+			serial.update(expected.back());
+	}
+	util::Stopwatch timer;
+	const std::size_t clones = 1000;
+	for (std::size_t i = 0; i < clones; ++i)
+		delete compiled.clone();
+	const double cloneTime = timer.elapsed() / clones;
+	timer.restart();
+	for (std::size_t i = 0; i < clones; ++i)
+		delete net.clone();
+	const double netCloneTime = timer.elapsed() / clones;
+	CompiledNetwork::Scratch scratch;
+	State s(states[0]), next;
+	timer.restart();
+	for (std::size_t i = 0; i < steps; ++i) {
+		compiled.step(s, next, scratch);
+		s.swap(next);
+	}
+	std::cout << "clone: CompiledNetwork " << cloneTime
+			<< " s, ImmutableBooleanNetwork " << netCloneTime
+			<< " s; CompiledNetwork step " << timer.elapsed() / steps << " s"
+			<< std::endl;
+	// all threads share compiled and net
+	std::vector<int> ok(threads, false);
+	boost::thread_group group;
+	for (std::size_t t = 0; t < threads; ++t)
+		group.create_thread(boost::bind(work, boost::cref(compiled),
+				boost::cref(net), boost::cref(states), boost::cref(expected),
+				steps, boost::ref(ok[t])));
+	group.join_all();
+	for (std::size_t t = 0; t < threads; ++t)
+		if (!ok[t]) {
+			std::cerr << "thread " << t << " computed a wrong state"
+					<< std::endl;
+			return EXIT_FAILURE;
+		}
+	std::cout << threads << " threads agree with the serial run" << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file sparse_benchmark.cpp
+ *
+ * Compares dense states simulated by CompiledNetwork with SparseState objects
+ * simulated by SparseNetwork on random networks of given bias. A network
+ * with a small bias has about that fraction of active nodes at every step,
+ * like large signalling networks in which few nodes are ON at any time.
+ *
+ * For each bias the program prints the fraction of active nodes, the memory
+ * taken by a state in both representations and the throughput of both
+ * updates. It checks that both produce the same trajectory, and that the
+ * Brent cycle finder gives the same attractor on both state types when it
+ * finds one within the given number of steps.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/SparseNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/cycle_finder/brent.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Makes cycle finders give up after a number of steps.
+ */
+class StepLimit {
+public:
+	explicit StepLimit(const std::size_t steps) :
+		steps(steps) {
+	}
+
+	bool operator()(const std::size_t iter) const {
+		return iter >= steps;
+	}
+
+private:
+	std::size_t steps;
+};
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of inputs per node
+ * @li number of steps per network
+ * @li seed for the random number generator
+ * @li one or more biases, that is probabilities of a 1 in truth tables
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 6) {
+		std::cerr << "usage: " << argv[0] << " nodes k steps seed bias..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	const std::size_t steps = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	bool ok = true;
+	for (int i = 5; i < argc; ++i) {
+		const double bias = std::atof(argv[i]);
+		const MutableBooleanNetwork graph = make_random_network(n, k, bias);
+		CompiledNetwork compiled(graph);
+		SparseNetwork sparse(graph);
+		State dense = util::random_state(n);
+		compiled.update(dense); // start from a state of typical activity
+		SparseState s(dense);
+		std::size_t active = 0, sparseBytes = 0;
+		util::Stopwatch timer;
+		for (std::size_t j = 0; j < steps; ++j)
+			compiled.update(dense);
+		const double denseRate = steps / timer.elapsed();
+		timer.restart();
+		for (std::size_t j = 0; j < steps; ++j)
+			sparse.update(s);
+		const double sparseRate = steps / timer.elapsed();
+		ok = ok && s.toState() == dense;
+		// activity and memory along the same trajectory
+		for (std::size_t j = 0; j < steps; ++j, sparse.update(s)) {
+			active += s.count();
+			sparseBytes += SparseState(s).memory();
+		}
+		std::cout << "bias " << bias << ": " << double(active) / steps / n
+				<< " active, " << dense.num_blocks() * sizeof(State::block_type)
+				<< " bytes per dense state, " << sparseBytes / steps
+				<< " per sparse state, " << denseRate << " steps/s dense, "
+				<< sparseRate << " steps/s sparse (" << sparseRate / denseRate
+				<< "x)" << std::endl;
+		const Attractor a = cycle_finder::brent(compiled, dense,
+				StepLimit(steps));
+		const BasicAttractor<SparseState> b = cycle_finder::brent(sparse,
+				SparseState(dense), StepLimit(steps));
+		ok = ok && a.empty() == b.empty();
+		if (!a.empty() && !b.empty()) {
+			ok = ok && a.getLength() == b.getLength()
+					&& b.getRepresentant().toState() == a.getRepresentant();
+			std::cout << "attractor of length " << a.getLength() << std::endl;
+		}
+	}
+	if (!ok) {
+		std::cerr << "dense and sparse dynamics differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
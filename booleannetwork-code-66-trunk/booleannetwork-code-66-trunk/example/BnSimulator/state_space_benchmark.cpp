@@ -0,0 +1,113 @@
+/**
+ * @file state_space_benchmark.cpp
+ *
+ * Analyzes the whole state space of a random network with FunctionalGraph,
+ * against sampling every state with Brent's cycle finder.
+ *
+ * The program prints the attractors with their basin sizes, the number of
+ * Garden-of-Eden states, the largest transient and in-degree, and the time of
+ * the analysis. Up to 20 nodes it also runs the cycle finder from every
+ * state, prints its time and fails if the attractors or the basin sizes
+ * differ. In any case it checks that the distributions account for every
+ * state, and that random states reach their attractor in exactly as many
+ * steps as their transient length.
+ */
+
+#include <cstdlib>
+#include <iostream>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/experiment/FunctionalGraph.hpp>
+#include <BnSimulator/experiment/cycle_finder.hpp>
+#include <BnSimulator/gen/StateEnumerator.hpp>
+#include <BnSimulator/util/Counter.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+/**
+ * Tells whether a distribution accounts for @a states states, weighted by
+ * @a weighted.
+ */
+bool accounts(const bn::FunctionalGraph::Distribution& distribution,
+		const boost::uint64_t states, const bool weighted) {
+	boost::uint64_t sum = 0;
+	for (bn::FunctionalGraph::Distribution::const_iterator d =
+			distribution.begin(); d != distribution.end(); ++d)
+		sum += d->second * (weighted ? d->first : 1);
+	return sum == states;
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes, at most 32
+ * @li number of inputs per node
+ * @li seed for the random number generator
+ * @li number of threads
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 5) {
+		std::cerr << "usage: " << argv[0] << " nodes k seed threads"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t k = std::atoi(argv[2]);
+	std::srand(std::atoi(argv[3]));
+	const std::size_t threads = std::atoi(argv[4]);
+	if (n == 0 || n > FunctionalGraph::MAX_NODES) {
+		std::cerr << "networks have 1 to " << FunctionalGraph::MAX_NODES
+				<< " nodes" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const MutableBooleanNetwork graph = make_random_network(n, k);
+	CompiledNetwork compiled(graph);
+	util::Stopwatch timer;
+	const FunctionalGraph space(compiled, threads);
+	const double elapsed = timer.elapsed();
+	for (std::size_t i = 0; i < space.numAttractors(); ++i)
+		std::cout << space.getAttractor(i) << ' ' << space.getBasinSize(i)
+				<< '\n';
+	std::cout << "N=" << n << " K=" << k << ": " << space.numAttractors()
+			<< " attractors, " << space.getGardenOfEden()
+			<< " Garden-of-Eden states, transients up to "
+			<< space.getTransients().rbegin()->first << ", in-degrees up to "
+			<< space.getInDegrees().rbegin()->first << "; " << elapsed << " s with "
+			<< threads << " threads" << std::endl;
+	const boost::uint64_t states = space.numStates();
+	bool ok = accounts(space.getTransients(), states, false) && accounts(
+			space.getInDegrees(), states, false) && accounts(
+			space.getInDegrees(), states, true);
+	for (std::size_t t = 0; t < 1000; ++t) {
+		State s = util::random_state(n);
+		const std::size_t a = space.getAttractorOf(s);
+		for (std::size_t i = space.getTransient(s); i > 0; --i) {
+			compiled.update(s);
+			ok = ok && space.getTransient(s) == i - 1;
+		}
+		ok = ok && space.getAttractorOf(s) == a;
+	}
+	if (n <= 20) {
+		timer.restart();
+		const util::Counter<Attractor> sampled(gen::enumerate_states(n)
+				| brent(compiled));
+		std::cout << "cycle finder on every state: " << timer.elapsed()
+				<< " s" << std::endl;
+		ok = ok && sampled.size() == space.numAttractors();
+		for (std::size_t i = 0; i < space.numAttractors(); ++i)
+			ok = ok && sampled[space.getAttractor(i)] == space.getBasinSize(i);
+	}
+	if (!ok) {
+		std::cerr << "the analysis is inconsistent" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
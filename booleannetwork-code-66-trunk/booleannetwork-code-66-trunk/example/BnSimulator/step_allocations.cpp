@@ -0,0 +1,122 @@
+/**
+ * @file step_allocations.cpp
+ *
+ * Counts the heap allocations performed by the stepping API of every network
+ * class once its buffers have been warmed up, and reports the throughput of
+ * update(State&). The program fails if any steady-state step allocates.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include <boost/scoped_ptr.hpp>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/ControllableBooleanNetwork.hpp>
+#include <BnSimulator/experiment/TrajectoryRange.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+std::size_t allocations = 0;
+
+/**
+ * Runs @a steps calls of update(State&) and step(const State&, State&) on
+ * @a dyn after a warm-up step, and prints how many allocations they made.
+ * @return the number of allocations
+ */
+std::size_t measure(const char name[], bn::BooleanDynamics& dyn,
+		const std::size_t steps) {
+	using namespace bn;
+	State s = util::random_state(dyn.size());
+	State next(dyn.size());
+	dyn.update(s); // warm-up: grows the internal buffer
+	std::size_t before = allocations;
+	util::Stopwatch timer;
+	for (std::size_t i = 0; i < steps; ++i)
+		dyn.update(s);
+	const double elapsed = timer.elapsed();
+	const std::size_t updateAllocs = allocations - before;
+	before = allocations;
+	for (std::size_t i = 0; i < steps; ++i) {
+		dyn.step(s, next);
+		s.swap(next);
+	}
+	const std::size_t stepAllocs = allocations - before;
+	// a trajectory iterator only allocates its two states when constructed
+	TrajectoryRange r(dyn, s, steps);
+	TrajectoryRange::iterator it = r.begin();
+	before = allocations;
+	for (; it != r.end(); ++it)
+		;
+	const std::size_t rangeAllocs = allocations - before;
+	std::cout << name << ": " << updateAllocs << " (update) " << stepAllocs
+			<< " (step) " << rangeAllocs << " (trajectory) allocations in "
+			<< steps << " steps, " << steps / elapsed << " steps/s"
+			<< std::endl;
+	return updateAllocs + stepAllocs + rangeAllocs;
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+	++allocations;
+	if (void* p = std::malloc(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+
+void operator delete(void* p) throw () {
+	std::free(p);
+}
+
+void operator delete[](void* p) throw () {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) throw () {
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) throw () {
+	std::free(p);
+}
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following required parameters in order:
+ * @li path to topology file
+ * @li path to node function file
+ * @li number of steps
+ * @li seed for the random number generator
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 5) {
+		std::cerr << "usage: " << argv[0] << " topology functions steps seed"
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t steps = std::atoi(argv[3]);
+	std::srand(std::atoi(argv[4]));
+	ImmutableBooleanNetwork inet = ImmutableBooleanNetwork::makeNetwork(
+			argv[1], argv[2]);
+	MutableBooleanNetwork mnet = MutableBooleanNetwork::makeNetwork(argv[1],
+			argv[2]);
+	ControllableBooleanNetwork cnet(mnet, 1, 2);
+	boost::scoped_ptr<BooleanDynamics> updater(mnet.simulate());
+	std::size_t total = 0;
+	total += measure("ImmutableBooleanNetwork", inet, steps);
+	total += measure("MutableBooleanNetwork", mnet, steps);
+	total += measure("MutableBooleanNetwork::Updater", *updater, steps);
+	total += measure("ControllableBooleanNetwork", cnet, steps);
+	return total == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
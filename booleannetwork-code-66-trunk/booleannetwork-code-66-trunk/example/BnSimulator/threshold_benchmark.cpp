@@ -0,0 +1,223 @@
+/**
+ * @file threshold_benchmark.cpp
+ *
+ * Compares threshold nodes with their truth tables.
+ *
+ * It first checks on random threshold functions of arity 0 to 12, with small
+ * weights and with weights close to the limits of their type, that
+ * evaluation, clamped(), isInfluent(), isConstant() and the function file
+ * format agree with the truth table of the function. Then, for every
+ * in-degree, it builds a random threshold network (see
+ * make_random_threshold_network()), the same network with truth tables, and
+ * a mix of the two, and checks that every network class follows the same
+ * trajectory on them. It prints the memory taken by weights and tables and
+ * the state updates per second of CompiledNetwork on each encoding.
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+#include <BnSimulator/core/IncrementalNetwork.hpp>
+#include <BnSimulator/core/InterleavedNetwork.hpp>
+#include <BnSimulator/core/ParallelNetwork.hpp>
+#include <BnSimulator/core/SparseNetwork.hpp>
+#include <BnSimulator/core/bn_factory.hpp>
+#include <BnSimulator/util/state_util.hpp>
+#include <BnSimulator/util/Stopwatch.hpp>
+
+namespace {
+
+using bn::BooleanFunction;
+using bn::ThresholdFunction;
+
+/**
+ * Evaluates a threshold function by its definition.
+ */
+bool reference_eval(const ThresholdFunction& f, const boost::uint64_t index) {
+	ThresholdFunction::sum_type sum = 0;
+	for (std::size_t j = 0; j < f.getArity(); ++j)
+		sum += (index >> j & 1) * f.getWeights()[j];
+	if (sum != f.getThreshold())
+		return sum > f.getThreshold();
+	if (f.getTieRule() == ThresholdFunction::TIE_KEEP)
+		return index >> f.getKeptInput() & 1;
+	return f.getTieRule() == ThresholdFunction::TIE_TRUE;
+}
+
+/**
+ * Returns a random threshold function of arity @a k whose weights range
+ * from -@a w to @a w.
+ */
+ThresholdFunction random_threshold(const std::size_t k, const int w) {
+	std::vector<ThresholdFunction::weight_type> weights;
+	for (std::size_t j = 0; j < k; ++j)
+		weights.push_back(std::rand() % (2 * w + 1) - w);
+	const ThresholdFunction::TieRule tie = ThresholdFunction::TieRule(
+			std::rand() % (k > 0 ? 3 : 2));
+	return ThresholdFunction(weights, std::rand() % (2 * w + 1) - w, tie, k
+			> 0 ? std::rand() % k : 0);
+}
+
+/**
+ * Returns a random threshold function of arity @a k whose weights are
+ * about -1e9, 0 or 1e9, and whose threshold is the sum of a random subset of
+ * them, so that ties occur.
+ */
+ThresholdFunction large_threshold(const std::size_t k) {
+	std::vector<ThresholdFunction::weight_type> weights;
+	ThresholdFunction::sum_type threshold = 0;
+	for (std::size_t j = 0; j < k; ++j) {
+		weights.push_back((std::rand() % 3 - 1) * 1000000000
+				+ std::rand() % 7 - 3);
+		if (std::rand() % 2)
+			threshold += weights.back();
+	}
+	const ThresholdFunction::TieRule tie = ThresholdFunction::TieRule(
+			std::rand() % (k > 0 ? 3 : 2));
+	return ThresholdFunction(weights, threshold, tie, k > 0 ? std::rand() % k
+			: 0);
+}
+
+/**
+ * Checks the operations of a threshold function against its truth table.
+ */
+bool check_function(const ThresholdFunction& t) {
+	const BooleanFunction f(t);
+	const BooleanFunction g(f.truthTable());
+	bool ok = f.usesThreshold() && !g.usesThreshold() && f.size() == g.size();
+	for (std::size_t j = 0; j < g.size(); ++j)
+		ok = ok && f[j] == g[j] && g[j] == reference_eval(t, j);
+	ok = ok && f.isConstant() == g.isConstant();
+	for (std::size_t i = 0; i < f.getArity(); ++i) {
+		ok = ok && f.isInfluent(i) == g.isInfluent(i);
+		for (int v = 0; v < 2; ++v)
+			ok = ok && BooleanFunction(f.clamped(i, v).truthTable())
+					== g.clamped(i, v);
+	}
+	std::stringstream file;
+	file << f << '\n';
+	const std::vector<BooleanFunction> read = bn::read_functions(file);
+	return ok && read.size() == 1 && read[0] == f;
+}
+
+/**
+ * Returns a copy of a network in which the function of every node whose
+ * index is a multiple of @a every is a truth table.
+ */
+bn::MutableBooleanNetwork tabulated(const bn::MutableBooleanNetwork& net,
+		const std::size_t every) {
+	bn::MutableBooleanNetwork res(net);
+	for (std::size_t i = 0; i < res.size(); i += every)
+		res.topology()[vertex(i, res.topology())] = BooleanFunction(
+				net.getFunction(i).truthTable());
+	return res;
+}
+
+/**
+ * Returns the number of bytes taken by the weights or tables of a network.
+ */
+std::size_t function_memory(const bn::MutableBooleanNetwork& net) {
+	std::size_t res = 0;
+	for (std::size_t i = 0; i < net.size(); ++i) {
+		const BooleanFunction f = net.getFunction(i);
+		res += f.usesThreshold() ? f.toThreshold().memory() : std::max(
+				f.size() / 8, sizeof(bn::State::block_type));
+	}
+	return res;
+}
+
+/**
+ * Advances @a s by @a steps steps.
+ * @return state updates per second
+ */
+template<class Network> double run(Network& net, bn::State& s,
+		const std::size_t steps) {
+	bn::util::Stopwatch timer;
+	for (std::size_t i = 0; i < steps; ++i)
+		net.update(s);
+	return steps / timer.elapsed();
+}
+
+} // namespace
+
+/**
+ * Entry point for this program.
+ *
+ * It accepts the following parameters in order:
+ * @li number of nodes
+ * @li number of steps
+ * @li seed for the random number generator
+ * @li one or more in-degrees
+ */
+int main(int argc, char* argv[]) {
+	using namespace bn;
+	if (argc < 5) {
+		std::cerr << "usage: " << argv[0] << " nodes steps seed k..."
+				<< std::endl;
+		return EXIT_FAILURE;
+	}
+	const std::size_t n = std::atoi(argv[1]);
+	const std::size_t steps = std::atoi(argv[2]);
+	std::srand(std::atoi(argv[3]));
+	bool ok = true;
+	for (std::size_t k = 0; k <= 12; ++k)
+		for (std::size_t t = 0; t < 200; ++t)
+			ok = ok && check_function(random_threshold(k, t % 2 ? 1 : 3))
+					&& check_function(large_threshold(k));
+	for (int a = 4; a < argc; ++a) {
+		const std::size_t k = std::atoi(argv[a]);
+		const MutableBooleanNetwork net = make_random_threshold_network(n, k);
+		const State init = util::random_state(n);
+		State reference(init);
+		MutableBooleanNetwork graph(net);
+		run(graph, reference, steps);
+		CompiledNetwork compiled(net);
+		State s(init);
+		const double rate = run(compiled, s, steps);
+		ok = ok && s == reference;
+		SparseNetwork sparse(net);
+		SparseState sp(init);
+		for (std::size_t i = 0; i < steps; ++i)
+			sparse.update(sp);
+		ok = ok && sp.toState() == reference;
+		IncrementalNetwork incremental(net);
+		s = init;
+		run(incremental, s, steps);
+		ok = ok && s == reference;
+		InterleavedNetwork interleaved(net);
+		std::vector<State> group(4, init);
+		for (std::size_t i = 0; i < steps; ++i)
+			interleaved.update(group);
+		ok = ok && group == std::vector<State>(4, reference);
+		ParallelNetwork parallel(net, 2);
+		s = init;
+		run(parallel, s, steps);
+		ok = ok && s == reference;
+		std::cout << "K=" << k << ": weights " << function_memory(net)
+				<< " bytes, threshold " << rate << " updates/s";
+		if (k < BooleanFunction::MAX_TABLE_ARITY) {
+			const MutableBooleanNetwork table = tabulated(net, 1);
+			const MutableBooleanNetwork mixed = tabulated(net, 2);
+			CompiledNetwork compiledTable(table), compiledMixed(mixed);
+			s = init;
+			const double tableRate = run(compiledTable, s, steps);
+			ok = ok && s == reference;
+			s = init;
+			const double mixedRate = run(compiledMixed, s, steps);
+			ok = ok && s == reference;
+			std::cout << "; tables " << function_memory(table) << " bytes, "
+					<< tableRate << " updates/s; mixed " << mixedRate
+					<< " updates/s";
+		}
+		std::cout << std::endl;
+	}
+	if (!ok) {
+		std::cerr << "threshold and truth table results differ" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
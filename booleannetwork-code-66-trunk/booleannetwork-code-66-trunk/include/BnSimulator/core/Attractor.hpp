@@ -10,7 +10,7 @@
 
 #include <cassert>
 #include <cstddef>
-#include <iosfwd>
+#include <ostream>
 #include <vector>
 
 #include <boost/mpl/assert.hpp>
@@ -22,6 +22,7 @@
 #include <boost/range/algorithm/min_element.hpp>
 
 #include "network_state.hpp"
+#include "Attractor_fwd.hpp"
 
 /**
  * @file Attractor.hpp
@@ -46,19 +47,24 @@ namespace bn {
  * This property makes these suitable objects to be inserted in an STL set.
  *
  * Instances of this class are immutable.
+ *
+ * Type parameter @a S is the state type; ImplicitAttractor is the
+ * instantiation for State.
  */
-class ImplicitAttractor {
+template<class S> class BasicImplicitAttractor {
 public:
-	ImplicitAttractor(const State& s, const std::size_t length) :
+	typedef S state_type;
+
+	BasicImplicitAttractor(const S& s, const std::size_t length) :
 		representant(s), length(length) {
 		assert(length > 0);
 	}
 
-	ImplicitAttractor() :
+	BasicImplicitAttractor() :
 		length(0) {
 	}
 
-	ImplicitAttractor(const ImplicitAttractor& other) :
+	BasicImplicitAttractor(const BasicImplicitAttractor& other) :
 		representant(other.representant), length(other.length) {
 	}
 
@@ -67,7 +73,7 @@ public:
 	 *
 	 * Does nothing.
 	 */
-	virtual ~ImplicitAttractor() {
+	virtual ~BasicImplicitAttractor() {
 	}
 
 	/**
@@ -82,7 +88,7 @@ public:
 	 * Returns the representant of this attractor.
 	 * @return the representant state
 	 */
-	const State& getRepresentant() const {
+	const S& getRepresentant() const {
 		return representant;
 	}
 
@@ -96,7 +102,7 @@ public:
 	 * @param other the other attractor
 	 * @return @e true attractors are the same otherwise @e false
 	 */
-	bool operator==(const ImplicitAttractor& other) const {
+	bool operator==(const BasicImplicitAttractor& other) const {
 		return representant == other.representant;
 	}
 
@@ -110,7 +116,7 @@ public:
 	 * @param other the other attractor
 	 * @return @e true if attractors are different otherwise @e false
 	 */
-	bool operator!=(const ImplicitAttractor& other) const {
+	bool operator!=(const BasicImplicitAttractor& other) const {
 		return !operator==(other);
 	}
 
@@ -124,25 +130,24 @@ public:
 	 * @param other the other attractor
 	 * @return @e true this attractor is less than the other, otherwise @e false
 	 */
-	bool operator<(const ImplicitAttractor& other) const {
+	bool operator<(const BasicImplicitAttractor& other) const {
 		return representant < other.representant;
 	}
 
 	/**
-	 * Prints this attractor to a stream.
-	 *
-	 * It prints only its representant.
-	 * @param out a stream
-	 * @param a an attractor
-	 * @return the stream passed as argument
+	 * Tests whether this is the empty attractor, that is the value cycle
+	 * finders return when they give up.
+	 * @return @e true if this attractor has no states
 	 */
-	friend std::ostream& operator<<(std::ostream&, const ImplicitAttractor&);
+	bool empty() const {
+		return length == 0;
+	}
 
 protected:
 	/**
 	 * Representant state of this attractor.
 	 */
-	State representant;
+	S representant;
 	/**
 	 * Length of this attractor.
 	 */
@@ -156,19 +161,24 @@ protected:
  * its states.
  *
  * Instances of this class are immutable.
+ *
+ * Type parameter @a S is the state type; Attractor is the instantiation for
+ * State.
  */
-class Attractor : public ImplicitAttractor {
+template<class S> class BasicAttractor : public BasicImplicitAttractor<S> {
 private:
+	typedef BasicImplicitAttractor<S> base;
+
 	/**
 	 * The state sequence in this attractor.
 	 */
-	std::vector<State> states;
+	std::vector<S> states;
 
 public:
 	/**
 	 * Constant iterator type for this class.
 	 */
-	typedef std::vector<State>::const_iterator const_iterator;
+	typedef typename std::vector<S>::const_iterator const_iterator;
 	/**
 	 * Iterator type for this class.
 	 *
@@ -177,19 +187,20 @@ public:
 	 */
 	typedef const_iterator iterator;
 
-	template<class SinglePassRange> explicit Attractor(const SinglePassRange& cycle) :
+	template<class SinglePassRange> explicit BasicAttractor(
+			const SinglePassRange& cycle) :
 		states(boost::begin(cycle), boost::end(cycle)) {
-		representant = *boost::min_element(states);
-		length = states.size();
+		base::representant = *boost::min_element(states);
+		base::length = states.size();
 		assert(!boost::empty(cycle));
-		assert(representant == *boost::min_element(states));
+		assert(base::representant == *boost::min_element(states));
 	}
 
-	Attractor() {
+	BasicAttractor() {
 	}
 
-	Attractor(const Attractor& other) :
-		ImplicitAttractor(other), states(other.states) {
+	BasicAttractor(const BasicAttractor& other) :
+		base(other), states(other.states) {
 	}
 
 	/**
@@ -209,17 +220,37 @@ public:
 		return states.end();
 	}
 
-	/**
-	 * Prints an attractor to a stream.
-	 *
-	 * It prints all of its states in lexicographical order, one for each line.
-	 * @param out a stream
-	 * @param a an attractor
-	 * @return the stream passed as argument
-	 */
-	friend std::ostream& operator<<(std::ostream&, const Attractor&);
 };
 
+/**
+ * Prints an attractor to a stream.
+ *
+ * It prints only its representant.
+ * @param out a stream
+ * @param a an attractor
+ * @return the stream passed as argument
+ */
+template<class S> std::ostream& operator<<(std::ostream& out,
+		const BasicImplicitAttractor<S>& a) {
+	return out << a.getRepresentant();
+}
+
+/**
+ * Prints an attractor to a stream.
+ *
+ * It prints all of its states in lexicographical order, one for each line.
+ * @param out a stream
+ * @param a an attractor
+ * @return the stream passed as argument
+ */
+template<class S> std::ostream& operator<<(std::ostream& out,
+		const BasicAttractor<S>& a) {
+	for (typename BasicAttractor<S>::const_iterator it = a.begin(), end =
+			a.end(); it != end; ++it)
+		out << *it << '\n';
+	return out;
+}
+
 static const Attractor EMPTY_ATTRACTOR = Attractor();
 
 }
@@ -0,0 +1,25 @@
+/*
+ * Attractor_fwd.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef ATTRACTOR_FWD_HPP_
+#define ATTRACTOR_FWD_HPP_
+
+#include "network_state.hpp"
+
+namespace bn {
+
+template<class S> class BasicImplicitAttractor;
+
+template<class S> class BasicAttractor;
+
+typedef BasicImplicitAttractor<State> ImplicitAttractor;
+
+typedef BasicAttractor<State> Attractor;
+
+} // namespace bn
+
+#endif /* ATTRACTOR_FWD_HPP_ */
@@ -0,0 +1,217 @@
+/*
+ * BatchState.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef BATCHSTATE_HPP_
+#define BATCHSTATE_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+#include <boost/cstdint.hpp>
+
+#include "network_state.hpp"
+
+namespace bn {
+
+/**
+ * A batch of network states stored transposed (bit-sliced).
+ *
+ * Instead of storing each state as a sequence of node values, a batch stores,
+ * for each node, the value that node takes in every state of the batch. Every
+ * state occupies a @e lane, that is a bit position in the words associated to
+ * the nodes. Lanes are grouped in blocks of 64 and the blocks of a node are
+ * contiguous in memory, so that a single machine word (or a vector register
+ * spanning several contiguous words) holds the value of a node in many states.
+ *
+ * This layout lets BitslicedNetwork evaluate a node function for all of the
+ * states in the batch with a handful of bitwise operations.
+ */
+class BatchState {
+public:
+	typedef boost::uint64_t word_type;
+
+	static const std::size_t bits_per_word = 64;
+
+	BatchState() :
+		n(0), blocks(0) {
+	}
+
+	/**
+	 * Initializes a batch of all-zero states.
+	 * @param n number of nodes of each state
+	 * @param lanes number of states in the batch, rounded up to a multiple of
+	 * 	64
+	 */
+	explicit BatchState(const std::size_t n, const std::size_t lanes =
+			bits_per_word) :
+		n(n), blocks((lanes + bits_per_word - 1) / bits_per_word), words(
+				n * blocks) {
+	}
+
+	/**
+	 * Returns the number of nodes of the states in this batch.
+	 * @return the length of each state
+	 */
+	std::size_t size() const {
+		return n;
+	}
+
+	/**
+	 * Returns the number of states (lanes) in this batch.
+	 * @return the number of lanes
+	 */
+	std::size_t lanes() const {
+		return blocks * bits_per_word;
+	}
+
+	/**
+	 * Returns the number of words used to store the value of a node.
+	 * @return the number of lane blocks
+	 */
+	std::size_t numBlocks() const {
+		return blocks;
+	}
+
+	/**
+	 * Returns a pointer to the numBlocks() contiguous words of node @a i.
+	 * @param i a node index
+	 * @return the lane words of node @a i
+	 */
+	word_type* node(const std::size_t i) {
+		assert(i < n);
+		return &words[i * blocks];
+	}
+
+	const word_type* node(const std::size_t i) const {
+		assert(i < n);
+		return &words[i * blocks];
+	}
+
+	/**
+	 * Returns the value of node @a i in the state stored in lane @a lane.
+	 */
+	bool get(const std::size_t i, const std::size_t lane) const {
+		assert(lane < lanes());
+		return (node(i)[lane / bits_per_word] >> (lane % bits_per_word)) & 1;
+	}
+
+	/**
+	 * Sets the value of node @a i in the state stored in lane @a lane.
+	 */
+	void set(const std::size_t i, const std::size_t lane, const bool v) {
+		assert(lane < lanes());
+		word_type& w = node(i)[lane / bits_per_word];
+		const word_type mask = word_type(1) << (lane % bits_per_word);
+		w = (w & ~mask) | (-word_type(v) & mask);
+	}
+
+	void setLane(const std::size_t lane, const State& s);
+
+	State getLane(const std::size_t lane) const;
+
+	/**
+	 * Transposes a sequence of states into this batch.
+	 *
+	 * State <em>i</em>-th of the sequence is stored in lane @e i; lanes that
+	 * are not covered by the sequence are cleared. At most lanes() states are
+	 * read.
+	 * @param first input iterator to the first state
+	 * @param last input iterator one past the last state
+	 * @return the number of states loaded
+	 */
+	template<class InputIterator> std::size_t load(InputIterator first,
+			const InputIterator last) {
+		const std::size_t chunks = numChunks();
+		std::vector<word_type> rows;
+		std::size_t count = 0;
+		for (; first != last && count < lanes(); ++first, ++count) {
+			assert(first->size() == n);
+			appendWords(*first, rows);
+		}
+		rows.resize(lanes() * chunks);
+		loadWords(rows);
+		return count;
+	}
+
+	/**
+	 * Transposes the states of this batch back to State objects.
+	 * @param out output iterator receiving the states of lanes
+	 * 	0 ... @a count - 1
+	 * @param count number of lanes to store
+	 * @return the output iterator after the last state written
+	 */
+	template<class OutputIterator> OutputIterator store(OutputIterator out,
+			const std::size_t count) const {
+		assert(count <= lanes());
+		std::vector<word_type> rows;
+		storeWords(rows);
+		const std::size_t chunks = numChunks();
+		for (std::size_t l = 0; l < count; ++l, ++out)
+			*out = makeState(&rows[l * chunks]);
+		return out;
+	}
+
+	void swap(BatchState& other) {
+		using std::swap;
+		swap(n, other.n);
+		swap(blocks, other.blocks);
+		words.swap(other.words);
+	}
+
+	bool operator==(const BatchState& other) const {
+		return n == other.n && blocks == other.blocks && words == other.words;
+	}
+
+	bool operator!=(const BatchState& other) const {
+		return !operator==(other);
+	}
+
+private:
+	/**
+	 * Number of nodes.
+	 */
+	std::size_t n;
+	/**
+	 * Number of words per node.
+	 */
+	std::size_t blocks;
+	/**
+	 * Node-major lane words.
+	 */
+	std::vector<word_type> words;
+
+	/**
+	 * Number of 64-node chunks a state is split in during transposition.
+	 */
+	std::size_t numChunks() const {
+		return (n + bits_per_word - 1) / bits_per_word;
+	}
+
+	void appendWords(const State& s, std::vector<word_type>& rows) const;
+
+	State makeState(const word_type* row) const;
+
+	void loadWords(std::vector<word_type>& rows);
+
+	void storeWords(std::vector<word_type>& rows) const;
+};
+
+inline void swap(BatchState& a, BatchState& b) {
+	a.swap(b);
+}
+
+namespace util {
+
+void transpose64(BatchState::word_type m[64]);
+
+} // namespace util
+
+} // namespace bn
+
+#endif /* BATCHSTATE_HPP_ */
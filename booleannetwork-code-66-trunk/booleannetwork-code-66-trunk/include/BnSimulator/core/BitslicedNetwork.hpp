@@ -0,0 +1,122 @@
+/*
+ * BitslicedNetwork.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef BITSLICEDNETWORK_HPP_
+#define BITSLICEDNETWORK_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "BatchState.hpp"
+#include "lane_kernel.hpp"
+
+namespace bn {
+
+class ImmutableBooleanNetwork;
+
+class MutableBooleanNetwork;
+
+/**
+ * Batch simulator that advances many independent trajectories of the same
+ * network at once.
+ *
+ * States are kept in a BatchState, so each node holds one bit per trajectory.
+ * A node function of arity @e k is evaluated for all of the lanes by a
+ * multiplexer tree of \f$2^k - 1\f$ bitwise selections, the <em>j</em>-th
+ * level of which is driven by the lane words of the <em>j</em>-th input.
+ * Nodes without a truth table (like the inputs of a ControllableBooleanNetwork)
+ * keep their value. Functions stored as a DecisionDiagram or ThresholdFunction
+ * are expanded into truth tables, so they must have a manageable arity.
+ *
+ * The tree is evaluated by a LaneKernel: by default the widest one supported
+ * by the running CPU (best_lane_kernel()), so that AVX2 processes 256 and
+ * AVX-512 processes 512 lanes per operation. Batches whose lanes are a
+ * multiple of 512 are processed entirely in vector registers.
+ *
+ * The network is copied at construction time: later modifications to the
+ * source network are not seen by this object.
+ */
+class BitslicedNetwork {
+public:
+	typedef BatchState::word_type word_type;
+
+	explicit BitslicedNetwork(const ImmutableBooleanNetwork& net);
+
+	explicit BitslicedNetwork(const MutableBooleanNetwork& net);
+
+	/**
+	 * Returns the number of nodes in the network.
+	 * @return the number of nodes
+	 */
+	std::size_t size() const {
+		return offsets.size() - 1;
+	}
+
+	void step(const BatchState& in, BatchState& out);
+
+	void update(BatchState& s);
+
+	void update(BatchState& s, const std::size_t n);
+
+	/**
+	 * Returns the kernel used to evaluate node functions.
+	 * @return the current kernel
+	 */
+	const LaneKernel& getKernel() const {
+		return *kernel;
+	}
+
+	/**
+	 * Sets the kernel used to evaluate node functions.
+	 * @param k a kernel supported by the running CPU (see find_lane_kernel())
+	 */
+	void setKernel(const LaneKernel& k) {
+		kernel = &k;
+	}
+
+private:
+	/**
+	 * Node @e i reads inputs[offsets[i]] ... inputs[offsets[i + 1] - 1].
+	 */
+	std::vector<std::size_t> offsets;
+	/**
+	 * Concatenated input lists, least significant input first.
+	 */
+	std::vector<std::size_t> inputs;
+	/**
+	 * Node @e i uses tables[tableOffsets[i]] ... tables[tableOffsets[i + 1] - 1].
+	 */
+	std::vector<std::size_t> tableOffsets;
+	/**
+	 * Concatenated truth tables, one entry per byte.
+	 */
+	std::vector<unsigned char> tables;
+	/**
+	 * Multiplexer tree levels.
+	 */
+	std::vector<word_type> scratch;
+	/**
+	 * Lane words of the inputs of the node being evaluated.
+	 */
+	std::vector<const word_type*> inputWords;
+	/**
+	 * Evaluation kernel.
+	 */
+	const LaneKernel* kernel;
+	/**
+	 * Buffer for the next batch used by update().
+	 */
+	BatchState next;
+
+	template<class Network> void init(const Network& net);
+
+	void evalNode(const std::size_t i, const BatchState& in, BatchState& out);
+};
+
+} // namespace bn
+
+#endif /* BITSLICEDNETWORK_HPP_ */
@@ -10,16 +10,122 @@
 
 #include <cstddef>
 
+#include <boost/type_traits/integral_constant.hpp>
+
 #include "BooleanFunction.hpp"
 #include "network_state.hpp"
 
 namespace bn {
 
-class BooleanDynamics {
+/**
+ * Synchronous dynamics over states of type @a S.
+ *
+ * This is the minimal interface required by the cycle finders, by Trajectory
+ * and by the attractor classes. @a S is either State or a fixed-width state
+ * type such as State64 (see FixedState).
+ */
+template<class S> class BasicBooleanDynamics {
+public:
+	typedef S state_type;
+
+	virtual ~BasicBooleanDynamics() {
+	}
+
+	virtual std::size_t size() const = 0;
+
+	virtual S operator()(const S& s) {
+		S result(s);
+		update(result);
+		return result;
+	}
+
+	virtual void update(S& s) = 0;
+
+	/**
+	 * Computes the successor of @a in into @a out.
+	 *
+	 * Unlike operator(), this method lets the caller own both buffers, so a
+	 * loop that alternates between two states does not allocate memory once
+	 * they have the right size. The default implementation copies @a in into
+	 * @a out and updates the latter; network classes override it.
+	 * @param in the current state
+	 * @param out the next state; it must not alias @a in
+	 */
+	virtual void step(const S& in, S& out) {
+		out = in;
+		update(out);
+	}
+};
+
+/**
+ * Tells whether no class derived from dynamics type @a D overrides its
+ * step().
+ *
+ * Generic code like the cycle finders is templated on the type of the
+ * dynamics, and calls D::step() without virtual dispatch when this trait
+ * holds, so that the compiler can inline it into the loop when it is defined
+ * in a header. It is false by default, which is always correct: the call is
+ * then virtual. Network classes that are never derived from specialize it.
+ */
+template<class D> struct is_leaf_dynamics : boost::false_type {
+};
+
+namespace detail {
+
+template<class D> inline void static_step(D& dyn,
+		const typename D::state_type& in, typename D::state_type& out,
+		boost::true_type) {
+	dyn.D::step(in, out);
+}
+
+template<class D> inline void static_step(D& dyn,
+		const typename D::state_type& in, typename D::state_type& out,
+		boost::false_type) {
+	dyn.step(in, out);
+}
+
+/**
+ * Calls dyn.step(in, out), without virtual dispatch if is_leaf_dynamics<D>
+ * holds.
+ */
+template<class D> inline void static_step(D& dyn,
+		const typename D::state_type& in, typename D::state_type& out) {
+	static_step(dyn, in, out, typename is_leaf_dynamics<D>::type());
+}
+
+template<class D> inline D* copy_dynamics(const D& dyn, boost::true_type) {
+	return new D(dyn);
+}
+
+template<class D> inline D* copy_dynamics(const D& dyn, boost::false_type) {
+	return dyn.clone();
+}
+
+/**
+ * Returns a copy of @a dyn owned by the caller: a copy of the network class
+ * if is_leaf_dynamics<D> holds, and a clone() otherwise, which only
+ * BooleanDynamics provides.
+ */
+template<class D> inline D* copy_dynamics(const D& dyn) {
+	return copy_dynamics(dyn, typename is_leaf_dynamics<D>::type());
+}
+
+} // namespace detail
+
+class BooleanDynamics : public BasicBooleanDynamics<State> {
 public:
 	virtual ~BooleanDynamics() {
 	}
 
+	/**
+	 * Returns a copy of these dynamics, owned by the caller.
+	 *
+	 * Networks whose nodes never change, like ImmutableBooleanNetwork and
+	 * CompiledNetwork, share them with their clones, so that a clone costs
+	 * about as much as a state: giving each thread a clone is the simplest way
+	 * to simulate one network from several threads.
+	 * @return a new object
+	 */
 	virtual BooleanDynamics* clone() const = 0;
 
 	/**
@@ -49,12 +155,6 @@ public:
 		return getState().size();
 	}
 
-	virtual State operator()(const State& s) {
-		State result(s);
-		update(result);
-		return result;
-	}
-
 	virtual void update(State& s) = 0;
 
 	virtual BooleanFunction getFunction(const std::size_t i) const = 0;
@@ -8,6 +8,7 @@
 #ifndef BOOLEANFUNCTION_HPP_
 #define BOOLEANFUNCTION_HPP_
 
+#include <cassert>
 #include <cstddef>
 #include <cmath>
 #include <iosfwd>
@@ -15,39 +16,122 @@
 #include <vector>
 
 #include <boost/concept_check.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/range/concepts.hpp>
 #include <boost/range/iterator.hpp>
 #include <boost/range/begin.hpp>
 #include <boost/range/size.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
 
 #include "network_state.hpp"
+#include "DecisionDiagram.hpp"
+#include "ThresholdFunction.hpp"
 
 namespace bn {
 
+/**
+ * A boolean function of @e k inputs.
+ *
+ * Functions are stored either as a truth table of \f$2^k\f$ bits or, for
+ * high-arity functions, as a DecisionDiagram. The representation is chosen
+ * automatically from the function itself: functions of at most
+ * MAX_TABLE_ARITY inputs are always tables, larger ones are diagrams whenever
+ * the diagram is smaller than the table. Since the choice does not depend on
+ * how a function was built, equal functions always have the same
+ * representation. The exception are functions built from a
+ * ThresholdFunction, which keep its weights at any arity: they are evaluated
+ * from the weights and compare equal only to the same threshold function.
+ *
+ * A function built from an empty table has no value at all: network classes
+ * use it for nodes that keep their value (see empty()).
+ *
+ * Functions are immutable values whose storage is shared among copies, so
+ * copying one does not allocate memory. A FunctionPool makes equal functions
+ * built independently share their storage too.
+ */
 class BooleanFunction {
 public:
+	/**
+	 * Largest arity for which truth tables are always used.
+	 */
+	static const std::size_t MAX_TABLE_ARITY = 16;
+
 	template<class RandomAccessRange> BooleanFunction(
 			const RandomAccessRange& r) :
-		def(boost::size(r)), arity(arityFromSize(def.size())) {
+		arity(arityFromSize(boost::size(r))) {
 		BOOST_CONCEPT_ASSERT((boost::RandomAccessRangeConcept<RandomAccessRange>));
+		State t(boost::size(r));
 		typename boost::range_iterator<const RandomAccessRange>::type it =
 				boost::begin(r);
-		for (std::size_t i = 0; i < def.size(); ++i, ++it)
-			def[i] = *it;
+		for (std::size_t i = 0; i < t.size(); ++i, ++it)
+			t[i] = *it;
+		store(t);
+	}
+
+	template<class InputIterator> BooleanFunction(InputIterator first,
+			InputIterator last) {
+		State t;
+		for (; first != last; ++first)
+			t.push_back(*first != 0);
+		arity = arityFromSize(t.size());
+		store(t);
 	}
 
 	BooleanFunction(const bool val = false) :
-		def(1, val), arity(0) {
+		arity(0) {
+		store(State(1, val));
 	}
 
 	explicit BooleanFunction(const State& s);
 
+	explicit BooleanFunction(const DecisionDiagram& d);
+
+	explicit BooleanFunction(const ThresholdFunction& t);
+
 	std::size_t getArity() const {
 		return arity;
 	}
 
+	/**
+	 * Returns the number of entries of the truth table of this function.
+	 * @return \f$2^k\f$, or 0 if this function is empty
+	 */
 	std::size_t size() const {
-		return def.size();
+		return diagram || threshold || !table->empty() ? std::size_t(1)
+				<< arity : 0;
+	}
+
+	/**
+	 * Tells whether this function has no value, that is whether it was built
+	 * from an empty table.
+	 */
+	bool empty() const {
+		return !diagram && !threshold && table->empty();
+	}
+
+	/**
+	 * Tells whether this function is stored as a decision diagram.
+	 */
+	bool usesDiagram() const {
+		return diagram.get() != NULL;
+	}
+
+	DecisionDiagram toDiagram() const;
+
+	/**
+	 * Tells whether this function is stored as a threshold function.
+	 */
+	bool usesThreshold() const {
+		return threshold.get() != NULL;
+	}
+
+	/**
+	 * Returns the threshold function this function was built from.
+	 * @return a threshold function of the same arity
+	 */
+	const ThresholdFunction& toThreshold() const {
+		assert(threshold);
+		return *threshold;
 	}
 
 	std::vector<int> truthTable() const;
@@ -58,18 +142,27 @@ public:
 
 	void clamp(const std::size_t i, const bool v);
 
-	std::pair<bool, bool> isConstant() const {
-		const bool allZeros = def.none();
-		const bool allOnes = (~def).none();
-		return std::make_pair(allZeros || allOnes, allOnes);
-	}
+	std::pair<bool, bool> isConstant() const;
 
 	bool operator()(const State& x) const;
 
-	bool operator==(const BooleanFunction& other) const {
-		return def == other.def;
+	/**
+	 * Evaluates this function on a truth table index.
+	 * @param index an input assignment, input @e j being bit @e j
+	 * @return the value of the function
+	 */
+	bool operator[](const boost::uint64_t index) const {
+		if (diagram)
+			return (*diagram)(index);
+		if (threshold)
+			return (*threshold)(index);
+		assert(index < size());
+		return (bits[index / State::bits_per_block] >> (index
+				% State::bits_per_block)) & 1;
 	}
 
+	bool operator==(const BooleanFunction& other) const;
+
 	bool operator<(const BooleanFunction& other) const;
 
 	friend std::ostream
@@ -79,17 +172,45 @@ public:
 
 	friend void swap(BooleanFunction&, BooleanFunction&);
 
+	friend class FunctionPool;
+
 private:
-	State def;
-	std::size_t arity;
+	typedef std::vector<State::block_type> Table;
 
-	std::pair<State, State> demultiplex(const std::size_t i) const;
+	std::size_t arity;
+	/**
+	 * Blocks of the truth table, shared among copies, or NULL if the function
+	 * is stored as a diagram or threshold function.
+	 */
+	boost::shared_ptr<const Table> table;
+	/**
+	 * First block of table, cached to save an indirection in operator[].
+	 */
+	const State::block_type* bits;
+	/**
+	 * Decision diagram, shared among copies, or NULL.
+	 */
+	boost::shared_ptr<const DecisionDiagram> diagram;
+	/**
+	 * Threshold function, shared among copies, or NULL.
+	 */
+	boost::shared_ptr<const ThresholdFunction> threshold;
+
+	BooleanFunction(const std::size_t arity, Table& blocks);
+
+	Table cofactor(const std::size_t i, const bool v) const;
+
+	void store(const State& t);
+
+	State tableState() const;
 
 	static std::size_t arityFromSize(const std::size_t n) {
-		return static_cast<std::size_t> (log2(n));
+		return n > 0 ? static_cast<std::size_t> (log2(n)) : 0;
 	}
 };
 
+std::vector<BooleanFunction> read_functions(std::istream& in);
+
 } // namespace bn
 
 #endif /* BOOLEANFUNCTION_HPP_ */
@@ -0,0 +1,263 @@
+/*
+ * CompiledNetwork.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef COMPILEDNETWORK_HPP_
+#define COMPILEDNETWORK_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "BooleanDynamics.hpp"
+
+namespace bn {
+
+class ImmutableBooleanNetwork;
+
+class MutableBooleanNetwork;
+
+/**
+ * Flat snapshot of a network, optimized for simulation speed.
+ *
+ * Nodes are grouped at construction time into buckets of equal in-degree.
+ * Every bucket stores the inputs of its nodes as one contiguous array of
+ * 32-bit node indices and their truth tables bit-packed in word-aligned
+ * slots, so that a function of arity @e k takes \f$2^k\f$ bits instead of
+ * \f$2^k\f$ ints. States are unpacked into 64-bit words before a step, and
+ * each bucket of in-degree up to MAX_SPECIALIZED_ARITY is evaluated by a
+ * kernel specialized on its arity, whose index computation is fully unrolled;
+ * larger in-degrees share a generic kernel. A random network with fixed
+ * @e K thus runs entirely in a single specialized kernel. Nodes without a
+ * truth table (like the inputs of a ControllableBooleanNetwork) are compiled
+ * as the identity of themselves, so that they keep their value. Nodes whose
+ * function is stored as a DecisionDiagram are evaluated by the diagram after
+ * the other ones. Nodes whose function is a ThresholdFunction are evaluated
+ * by their weights after them, unless their truth table fits in a word: in
+ * that case it is both smaller and faster, so they are compiled into a
+ * bucket and getFunction() returns their truth table.
+ *
+ * This class implements BooleanDynamics, hence it can be used in place of the
+ * network it was built from by cycle finders and runners. Later
+ * modifications to the source network are not seen by this object.
+ *
+ * The compiled nodes never change after construction and are shared by
+ * copies, so that clone() only copies a state and the buffers of a step. The
+ * const step() takes these buffers from the caller and may be called
+ * concurrently on one object; to simulate one network from several threads,
+ * either give every thread a Scratch, or a clone on which it calls any
+ * method.
+ */
+class CompiledNetwork : public BooleanDynamics {
+public:
+	typedef boost::uint64_t word_type;
+
+	/**
+	 * Largest in-degree evaluated by a specialized kernel.
+	 */
+	static const std::size_t MAX_SPECIALIZED_ARITY = 8;
+
+	/**
+	 * Buffers of a step, which hold the unpacked current and next states.
+	 */
+	struct Scratch {
+		std::vector<word_type> in, out;
+	};
+
+	using BooleanDynamics::update; // make update(size_t) visible
+
+	explicit CompiledNetwork(const ImmutableBooleanNetwork& net);
+
+	explicit CompiledNetwork(const MutableBooleanNetwork& net);
+
+	CompiledNetwork* clone() const {
+		return new CompiledNetwork(*this);
+	}
+
+	/**
+	 * Returns the number of nodes in the network.
+	 * @return the number of nodes
+	 */
+	std::size_t size() const {
+		return program->offsets.size() - 1;
+	}
+
+	/**
+	 * Sets the state of this network.
+	 * @param s the new state
+	 */
+	void setState(const State& s) {
+		assert(size() == s.size());
+		state = s;
+	}
+
+	/**
+	 * Returns a reference to the current state of this network.
+	 * @return the state of this network
+	 */
+	const State& getState() const {
+		return state;
+	}
+
+	void update();
+
+	State operator()(const State& s);
+
+	void update(State& s);
+
+	void step(const State& in, State& out);
+
+	void step(const State& in, State& out, Scratch& scratch) const;
+
+	BooleanFunction getFunction(const std::size_t i) const;
+
+	/**
+	 * Returns the number of nodes in each bucket.
+	 * @return a vector whose <em>k</em>-th element is the number of nodes of
+	 * 	in-degree @e k evaluated from truth tables
+	 */
+	std::vector<std::size_t> bucketSizes() const;
+
+	/**
+	 * Tells whether buckets of small in-degree use their specialized kernel.
+	 * @return @e true unless disabled by setSpecialized()
+	 */
+	bool isSpecialized() const {
+		return specialized;
+	}
+
+	/**
+	 * Chooses between the specialized kernels (the default) and the generic
+	 * kernel for every bucket, which is meant for comparisons.
+	 * @param s @e false to evaluate every bucket with the generic kernel
+	 */
+	void setSpecialized(const bool s) {
+		specialized = s;
+	}
+
+private:
+	/**
+	 * A node whose function is a decision diagram.
+	 */
+	struct DiagramNode {
+		std::size_t node;
+		std::vector<boost::uint32_t> inputs;
+		BooleanFunction function;
+	};
+
+	/**
+	 * Nodes whose function is a threshold function.
+	 */
+	struct ThresholdNodes {
+		/**
+		 * Nodes, in increasing order.
+		 */
+		std::vector<boost::uint32_t> nodes;
+		/**
+		 * Inputs of nodes[p] at offsets[p] ... offsets[p + 1] - 1.
+		 */
+		std::vector<boost::uint32_t> offsets, inputs;
+		std::vector<ThresholdFunction> functions;
+	};
+
+	/**
+	 * Nodes of equal in-degree.
+	 */
+	struct Bucket {
+		/**
+		 * Nodes of this bucket, in increasing order.
+		 */
+		std::vector<boost::uint32_t> nodes;
+		/**
+		 * Inputs of nodes[p] at p * k ... p * k + k - 1, least significant
+		 * input first.
+		 */
+		std::vector<boost::uint32_t> inputs;
+		/**
+		 * Truth table of nodes[p] in the p-th slot of max(1, 2^k / 64) words.
+		 */
+		std::vector<word_type> tables;
+	};
+
+	/**
+	 * The compiled nodes, which are shared by copies.
+	 */
+	struct Program {
+		/**
+		 * Node @e i has offsets[i + 1] - offsets[i] inputs.
+		 */
+		std::vector<boost::uint32_t> offsets;
+		/**
+		 * Bucket @e k holds the nodes of in-degree @e k.
+		 */
+		std::vector<Bucket> buckets;
+		/**
+		 * Position of every node in its bucket.
+		 */
+		std::vector<boost::uint32_t> slots;
+		/**
+		 * Nodes with a decision diagram, in increasing order.
+		 */
+		std::vector<DiagramNode> diagrams;
+		ThresholdNodes thresholds;
+		/**
+		 * Nodes that had no truth table in the source network.
+		 */
+		State held;
+	};
+
+	boost::shared_ptr<const Program> program;
+	/**
+	 * The current state of the network.
+	 */
+	State state;
+	/**
+	 * Buffers of step().
+	 */
+	Scratch scratch;
+	/**
+	 * Buffer for the next state used by update().
+	 */
+	State next;
+	bool specialized;
+
+	friend class ParallelNetwork;
+	friend class InterleavedNetwork;
+
+	/**
+	 * Number of words of the truth table of a function of arity @a k.
+	 */
+	static std::size_t tableWords(const std::size_t k) {
+		return k <= 6 ? 1 : std::size_t(1) << (k - 6);
+	}
+
+	template<class Network> void init(const Network& net);
+
+	void eval(Scratch& s, const std::size_t first,
+			const std::size_t last) const;
+
+	void evalBuckets(Scratch& s, const std::size_t first,
+			const std::size_t last) const;
+
+	void evalDiagrams(Scratch& s, const std::size_t first,
+			const std::size_t last) const;
+
+	void evalThresholds(Scratch& s, const std::size_t first,
+			const std::size_t last) const;
+
+	template<std::size_t K> void evalBucket(const std::size_t k, Scratch& s,
+			const std::size_t first, const std::size_t last) const;
+};
+
+template<> struct is_leaf_dynamics<CompiledNetwork> : boost::true_type {
+};
+
+} // namespace bn
+
+#endif /* COMPILEDNETWORK_HPP_ */
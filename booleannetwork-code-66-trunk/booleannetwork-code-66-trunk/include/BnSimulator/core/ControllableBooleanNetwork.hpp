@@ -45,6 +45,10 @@ public:
 	ControllableBooleanNetwork(const MutableBooleanNetwork& bn,
 			const std::size_t inputs, const std::size_t outputs);
 
+	ControllableBooleanNetwork* clone() const {
+		return new ControllableBooleanNetwork(*this);
+	}
+
 	void setState(const State& s);
 
 	State getInput() const;
@@ -70,6 +74,8 @@ public:
 
 	void update(State& s);
 
+	void step(const State& in, State& out);
+
 	ControllableBooleanNetwork& operator=(ControllableBooleanNetwork other);
 
 protected:
@@ -80,6 +86,10 @@ protected:
 	State sliceState(const std::size_t from, const std::size_t to) const;
 };
 
+template<> struct is_leaf_dynamics<ControllableBooleanNetwork> :
+	boost::true_type {
+};
+
 void swap(ControllableBooleanNetwork& a, ControllableBooleanNetwork& b);
 
 } // namespace bn
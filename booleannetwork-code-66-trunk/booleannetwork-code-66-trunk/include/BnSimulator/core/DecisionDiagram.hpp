@@ -0,0 +1,152 @@
+/*
+ * DecisionDiagram.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef DECISIONDIAGRAM_HPP_
+#define DECISIONDIAGRAM_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "network_state.hpp"
+
+namespace bn {
+
+/**
+ * A boolean function stored as a reduced ordered binary decision diagram.
+ *
+ * Memory is proportional to the number of decision nodes rather than to the
+ * \f$2^k\f$ entries of a truth table, and an evaluation follows a single
+ * path of at most @e k nodes. Variable @e j is the <em>j</em>-th input of
+ * the function (bit @e j of a truth table index): variables are tested in
+ * decreasing order from the root.
+ *
+ * Diagrams are canonical: two diagrams of the same arity are equal if and
+ * only if they represent the same function.
+ */
+class DecisionDiagram {
+public:
+	typedef boost::uint32_t node_id;
+
+	/**
+	 * Identifier of the constant false node.
+	 */
+	static const node_id FALSE_NODE = 0;
+	/**
+	 * Identifier of the constant true node.
+	 */
+	static const node_id TRUE_NODE = 1;
+
+	/**
+	 * A decision node: it leads to @a hi if variable @a var is true, to
+	 * @a lo otherwise.
+	 */
+	struct Node {
+		node_id var;
+		node_id lo;
+		node_id hi;
+
+		bool operator==(const Node& other) const {
+			return var == other.var && lo == other.lo && hi == other.hi;
+		}
+	};
+
+	explicit DecisionDiagram(const bool value = false, const std::size_t arity =
+			0);
+
+	static DecisionDiagram fromTable(const State& table);
+
+	static DecisionDiagram fromTable(const std::vector<int>& table);
+
+	static DecisionDiagram fromCubes(const std::size_t arity, const std::vector<
+			std::string>& cubes);
+
+	std::size_t getArity() const {
+		return arity;
+	}
+
+	/**
+	 * Returns the number of nodes of this diagram, terminals included.
+	 * @return the number of nodes
+	 */
+	std::size_t numNodes() const {
+		return nodes.size();
+	}
+
+	/**
+	 * Returns the number of bytes used by the nodes of this diagram.
+	 * @return the memory footprint of the nodes
+	 */
+	std::size_t memory() const {
+		return nodes.size() * sizeof(Node);
+	}
+
+	/**
+	 * Evaluates the function on a truth table index.
+	 * @param index an input assignment, input @e j being bit @e j
+	 * @return the value of the function
+	 */
+	bool operator()(const boost::uint64_t index) const {
+		assert(arity <= 64);
+		node_id n = root;
+		while (n > TRUE_NODE) {
+			const Node& node = nodes[n];
+			n = (index >> node.var) & 1 ? node.hi : node.lo;
+		}
+		return n == TRUE_NODE;
+	}
+
+	bool operator()(const State& x) const;
+
+	bool isConstant() const {
+		return root <= TRUE_NODE;
+	}
+
+	bool dependsOn(const std::size_t i) const;
+
+	DecisionDiagram clamped(const std::size_t i, const bool v) const;
+
+	State table() const;
+
+	bool operator==(const DecisionDiagram& other) const {
+		return arity == other.arity && root == other.root && nodes
+				== other.nodes;
+	}
+
+	bool operator<(const DecisionDiagram& other) const;
+
+	friend std::ostream& operator<<(std::ostream& out,
+			const DecisionDiagram& d);
+
+	friend std::size_t hash_value(const DecisionDiagram& d);
+
+private:
+	class Builder;
+
+	std::size_t arity;
+	/**
+	 * Nodes in post-order from the root (low branch first), after the two
+	 * terminals. This numbering is a function of the diagram shape only,
+	 * which makes diagrams canonical.
+	 */
+	std::vector<Node> nodes;
+	node_id root;
+
+	DecisionDiagram(const std::size_t arity, const Builder& b,
+			const node_id root);
+
+	void printCubes(std::ostream& out, const node_id n, std::string& cube,
+			bool& first) const;
+};
+
+} // namespace bn
+
+#endif /* DECISIONDIAGRAM_HPP_ */
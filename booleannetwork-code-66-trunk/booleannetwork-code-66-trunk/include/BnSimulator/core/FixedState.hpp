@@ -0,0 +1,367 @@
+/*
+ * FixedState.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef FIXEDSTATE_HPP_
+#define FIXEDSTATE_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <climits>
+#include <ostream>
+
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include "network_state.hpp"
+
+namespace bn {
+
+/**
+ * A network state with compile-time capacity and inline storage.
+ *
+ * This class is a drop-in replacement for State (boost::dynamic_bitset) for
+ * networks of at most @a Bits nodes: it provides the subset of the
+ * dynamic_bitset interface used throughout the library, with the same
+ * semantics and ordering. Since its words live inside the object, copies,
+ * comparisons and hashes do not touch the heap, and all of the loops over
+ * words have a compile-time trip count.
+ *
+ * Bits beyond size() are always zero.
+ */
+template<std::size_t Bits> class FixedState {
+public:
+	typedef boost::uint64_t block_type;
+	typedef std::size_t size_type;
+
+	BOOST_STATIC_CONSTANT(size_type, bits_per_block = 64);
+	BOOST_STATIC_CONSTANT(size_type, capacity = Bits);
+	BOOST_STATIC_CONSTANT(size_type, num_words = (Bits + 63) / 64);
+
+	BOOST_STATIC_ASSERT(Bits > 0);
+
+	/**
+	 * Proxy returned by the non-const operator[].
+	 */
+	class reference {
+	public:
+		operator bool() const {
+			return (*w & mask) != 0;
+		}
+
+		bool operator~() const {
+			return (*w & mask) == 0;
+		}
+
+		reference& operator=(const bool v) {
+			*w = (*w & ~mask) | (-block_type(v) & mask);
+			return *this;
+		}
+
+		reference& operator=(const reference& other) {
+			return operator=(bool(other));
+		}
+
+		reference& flip() {
+			*w ^= mask;
+			return *this;
+		}
+
+	private:
+		friend class FixedState;
+
+		block_type* w;
+		block_type mask;
+
+		reference(block_type& w, const size_type i) :
+			w(&w), mask(block_type(1) << (i % bits_per_block)) {
+		}
+	};
+
+	FixedState() :
+		n(0) {
+		clear();
+	}
+
+	/**
+	 * Initializes a state of @a n nodes whose first bits are set from
+	 * @a value, like the dynamic_bitset constructor.
+	 */
+	explicit FixedState(const size_type n, const unsigned long value = 0) :
+		n(n) {
+		assert(n <= Bits);
+		clear();
+		words[0] = value;
+		trim();
+	}
+
+	/**
+	 * Converts a dynamic state.
+	 * @param s a state of at most @a Bits nodes
+	 */
+	explicit FixedState(const State& s) :
+		n(s.size()) {
+		assert(n <= Bits);
+		clear();
+		const size_type bpb = sizeof(State::block_type) * CHAR_BIT;
+		State::block_type tmp[(Bits + bpb - 1) / bpb];
+		boost::to_block_range(s, tmp);
+		for (size_type i = 0; i < s.num_blocks(); ++i)
+			words[i * bpb / bits_per_block] |= block_type(tmp[i]) << (i * bpb
+					% bits_per_block);
+	}
+
+	/**
+	 * Converts this state to a dynamic one.
+	 * @return a State equal to this object
+	 */
+	State toState() const {
+		State s(n);
+		for (size_type i = 0; i < n; ++i)
+			if (test(i))
+				s.set(i);
+		return s;
+	}
+
+	size_type size() const {
+		return n;
+	}
+
+	size_type num_blocks() const {
+		return num_words;
+	}
+
+	bool test(const size_type i) const {
+		assert(i < n);
+		return (words[i / bits_per_block] >> (i % bits_per_block)) & 1;
+	}
+
+	bool operator[](const size_type i) const {
+		return test(i);
+	}
+
+	reference operator[](const size_type i) {
+		assert(i < n);
+		return reference(words[i / bits_per_block], i);
+	}
+
+	FixedState& set(const size_type i, const bool v = true) {
+		operator[](i) = v;
+		return *this;
+	}
+
+	FixedState& set() {
+		for (size_type w = 0; w < num_words; ++w)
+			words[w] = ~block_type(0);
+		trim();
+		return *this;
+	}
+
+	FixedState& reset(const size_type i) {
+		return set(i, false);
+	}
+
+	FixedState& reset() {
+		clear();
+		return *this;
+	}
+
+	FixedState& flip(const size_type i) {
+		operator[](i).flip();
+		return *this;
+	}
+
+	FixedState& flip() {
+		for (size_type w = 0; w < num_words; ++w)
+			words[w] = ~words[w];
+		trim();
+		return *this;
+	}
+
+	size_type count() const {
+		size_type c = 0;
+		for (size_type w = 0; w < num_words; ++w)
+			c += __builtin_popcountll(words[w]);
+		return c;
+	}
+
+	bool any() const {
+		block_type acc = 0;
+		for (size_type w = 0; w < num_words; ++w)
+			acc |= words[w];
+		return acc != 0;
+	}
+
+	bool none() const {
+		return !any();
+	}
+
+	/**
+	 * Returns the <em>i</em>-th 64-bit word of this state.
+	 */
+	block_type word(const size_type i) const {
+		assert(i < num_words);
+		return words[i];
+	}
+
+	/**
+	 * Sets the <em>i</em>-th 64-bit word of this state. Bits beyond size()
+	 * are discarded.
+	 */
+	void setWord(const size_type i, const block_type w) {
+		assert(i < num_words);
+		words[i] = w & wordMask(i);
+	}
+
+	FixedState& operator&=(const FixedState& other) {
+		assert(n == other.n);
+		for (size_type w = 0; w < num_words; ++w)
+			words[w] &= other.words[w];
+		return *this;
+	}
+
+	FixedState& operator|=(const FixedState& other) {
+		assert(n == other.n);
+		for (size_type w = 0; w < num_words; ++w)
+			words[w] |= other.words[w];
+		return *this;
+	}
+
+	FixedState& operator^=(const FixedState& other) {
+		assert(n == other.n);
+		for (size_type w = 0; w < num_words; ++w)
+			words[w] ^= other.words[w];
+		return *this;
+	}
+
+	FixedState operator~() const {
+		return FixedState(*this).flip();
+	}
+
+	bool operator==(const FixedState& other) const {
+		if (n != other.n)
+			return false;
+		block_type diff = 0;
+		for (size_type w = 0; w < num_words; ++w)
+			diff |= words[w] ^ other.words[w];
+		return diff == 0;
+	}
+
+	bool operator!=(const FixedState& other) const {
+		return !operator==(other);
+	}
+
+	/**
+	 * Compares two states with the same ordering as dynamic_bitset, that is
+	 * lexicographically starting from the most significant (last) node.
+	 */
+	bool operator<(const FixedState& other) const {
+		if (other.n == 0)
+			return false;
+		if (n == 0)
+			return true;
+		assert(n == other.n);
+		for (size_type w = num_words; w > 0; --w) {
+			if (words[w - 1] != other.words[w - 1])
+				return words[w - 1] < other.words[w - 1];
+		}
+		return false;
+	}
+
+	bool operator>(const FixedState& other) const {
+		return other < *this;
+	}
+
+	bool operator<=(const FixedState& other) const {
+		return !(other < *this);
+	}
+
+	bool operator>=(const FixedState& other) const {
+		return !(*this < other);
+	}
+
+private:
+	size_type n;
+	block_type words[num_words];
+
+	void clear() {
+		for (size_type w = 0; w < num_words; ++w)
+			words[w] = 0;
+	}
+
+	/**
+	 * Returns the mask of the bits of word @a w that are below size().
+	 */
+	block_type wordMask(const size_type w) const {
+		const size_type first = w * bits_per_block;
+		if (first >= n)
+			return 0;
+		if (n - first >= bits_per_block)
+			return ~block_type(0);
+		return (block_type(1) << (n - first)) - 1;
+	}
+
+	/**
+	 * Clears the bits beyond size().
+	 */
+	void trim() {
+		for (size_type w = 0; w < num_words; ++w)
+			words[w] &= wordMask(w);
+	}
+};
+
+template<std::size_t Bits> FixedState<Bits> operator&(FixedState<Bits> a,
+		const FixedState<Bits>& b) {
+	return a &= b;
+}
+
+template<std::size_t Bits> FixedState<Bits> operator|(FixedState<Bits> a,
+		const FixedState<Bits>& b) {
+	return a |= b;
+}
+
+template<std::size_t Bits> FixedState<Bits> operator^(FixedState<Bits> a,
+		const FixedState<Bits>& b) {
+	return a ^= b;
+}
+
+/**
+ * Prints a state like dynamic_bitset does, most significant node first.
+ */
+template<std::size_t Bits> std::ostream& operator<<(std::ostream& out,
+		const FixedState<Bits>& s) {
+	for (std::size_t i = s.size(); i > 0; --i)
+		out << (s.test(i - 1) ? '1' : '0');
+	return out;
+}
+
+/**
+ * Hashes a state with the default mixer of BitsetHasher, so that a FixedState
+ * and the State holding the same bits have the same hash.
+ */
+template<std::size_t Bits> std::size_t hash_value(const FixedState<Bits>& s) {
+	WyMixer mixer;
+	for (std::size_t w = 0; w < (s.size() + 63) / 64; ++w)
+		mixer(s.word(w));
+	return mixer.result(s.size());
+}
+
+/**
+ * State of networks with at most 64 nodes.
+ */
+typedef FixedState<64> State64;
+/**
+ * State of networks with at most 128 nodes.
+ */
+typedef FixedState<128> State128;
+/**
+ * State of networks with at most 256 nodes.
+ */
+typedef FixedState<256> State256;
+
+} // namespace bn
+
+#endif /* FIXEDSTATE_HPP_ */
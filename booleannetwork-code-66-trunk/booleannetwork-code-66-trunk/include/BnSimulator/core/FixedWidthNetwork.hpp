@@ -0,0 +1,102 @@
+/*
+ * FixedWidthNetwork.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef FIXEDWIDTHNETWORK_HPP_
+#define FIXEDWIDTHNETWORK_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "BooleanDynamics.hpp"
+#include "FixedState.hpp"
+
+namespace bn {
+
+/**
+ * Dynamics of a network of at most @a Bits nodes over FixedState objects.
+ *
+ * It is a snapshot of an ImmutableBooleanNetwork or MutableBooleanNetwork
+ * taken at construction time. Since states have inline storage, a simulation
+ * step never allocates memory, and the cycle finders instantiated on this
+ * class compare and copy states with a fixed number of word operations.
+ *
+ * Typical usage:
+ * @code
+ * ImmutableBooleanNetwork net = ImmutableBooleanNetwork::makeNetwork(t, f);
+ * FixedWidthNetwork<64> fast(net);
+ * BasicAttractor<State64> a = cycle_finder::brent(fast, State64(s));
+ * @endcode
+ */
+template<std::size_t Bits> class FixedWidthNetwork : public BasicBooleanDynamics<
+		FixedState<Bits> > {
+public:
+	typedef FixedState<Bits> state_type;
+
+	/**
+	 * Copies the topology and functions of a network.
+	 * @param net an ImmutableBooleanNetwork or a MutableBooleanNetwork of at
+	 * 	most @a Bits nodes; functions stored as a DecisionDiagram or
+	 * 	ThresholdFunction are expanded into truth tables
+	 */
+	template<class Network> explicit FixedWidthNetwork(const Network& net) {
+		assert(net.size() <= Bits);
+		offsets.push_back(0);
+		tableOffsets.push_back(0);
+		for (std::size_t i = 0; i < net.size(); ++i) {
+			const std::vector<std::size_t> in = net.getInputs(i);
+			inputs.insert(inputs.end(), in.begin(), in.end());
+			offsets.push_back(inputs.size());
+			const std::vector<int> tt = net.getFunction(i).truthTable();
+			tables.insert(tables.end(), tt.begin(), tt.end());
+			tableOffsets.push_back(tables.size());
+		}
+	}
+
+	std::size_t size() const {
+		return offsets.size() - 1;
+	}
+
+	void update(state_type& s) {
+		state_type next;
+		step(s, next);
+		s = next;
+	}
+
+	void step(const state_type& in, state_type& out) {
+		assert(in.size() == size());
+		out = state_type(in.size());
+		for (std::size_t i = 0; i < size(); ++i) {
+			const std::size_t t = tableOffsets[i];
+			if (tableOffsets[i + 1] == t) { // no function: hold value
+				out.set(i, in.test(i));
+				continue;
+			}
+			std::size_t index = 0;
+			for (std::size_t j = offsets[i], b = 0; j < offsets[i + 1]; ++j, ++b)
+				index |= std::size_t(in.test(inputs[j])) << b;
+			out.set(i, tables[t + index]);
+		}
+	}
+
+private:
+	std::vector<std::size_t> offsets;
+
+	std::vector<std::size_t> inputs;
+
+	std::vector<std::size_t> tableOffsets;
+
+	std::vector<unsigned char> tables;
+};
+
+template<std::size_t Bits> struct is_leaf_dynamics<FixedWidthNetwork<Bits> > :
+	boost::true_type {
+};
+
+} // namespace bn
+
+#endif /* FIXEDWIDTHNETWORK_HPP_ */
@@ -0,0 +1,97 @@
+/*
+ * FunctionPool.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef FUNCTIONPOOL_HPP_
+#define FUNCTIONPOOL_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_set.hpp>
+
+#include "BooleanFunction.hpp"
+
+namespace bn {
+
+/**
+ * Set of distinct boolean functions, used to make equal functions share
+ * their storage.
+ *
+ * Random and curated networks repeat a few functions (AND, OR, canalizing
+ * functions) many times. Interning them makes every node that computes the
+ * same function point to the same truth table, diagram or weights, which
+ * reduces the memory and cache footprint of large networks and of ensembles
+ * held in memory at once, and makes comparisons of interned functions a
+ * pointer comparison.
+ *
+ * Functions are looked up by hash_value(). The pool holds a reference to
+ * each of its functions: those which are no longer used by anyone else are
+ * released by purge(), which intern() calls whenever the pool has doubled
+ * since the last purge. All methods may be called concurrently.
+ */
+class FunctionPool {
+public:
+	FunctionPool();
+
+	BooleanFunction intern(const BooleanFunction& f);
+
+	void purge();
+
+	/**
+	 * Returns the number of distinct functions in this pool.
+	 * @return a function count
+	 */
+	std::size_t size() const;
+
+	std::size_t memory() const;
+
+	/**
+	 * Returns the number of calls to intern().
+	 * @return a call count
+	 */
+	std::size_t getLookups() const {
+		return lookups;
+	}
+
+	/**
+	 * Returns the number of calls to intern() that found an equal function
+	 * in the pool.
+	 * @return a call count
+	 */
+	std::size_t getHits() const {
+		return hits;
+	}
+
+	std::vector<BooleanFunction> functions() const;
+
+	static FunctionPool& global();
+
+private:
+	boost::unordered_set<BooleanFunction> pool;
+	std::size_t lookups, hits;
+	/**
+	 * Size of the pool after the last purge.
+	 */
+	std::size_t purged;
+	mutable boost::mutex mutex;
+
+	/**
+	 * This class disallows copy.
+	 */
+	FunctionPool(const FunctionPool&);
+
+	FunctionPool& operator=(const FunctionPool&);
+};
+
+std::vector<BooleanFunction> intern_functions(
+		const std::vector<BooleanFunction>& functions, FunctionPool& pool =
+				FunctionPool::global());
+
+} // namespace bn
+
+#endif /* FUNCTIONPOOL_HPP_ */
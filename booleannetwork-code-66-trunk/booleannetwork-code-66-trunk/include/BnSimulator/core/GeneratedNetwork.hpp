@@ -0,0 +1,174 @@
+/*
+ * GeneratedNetwork.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef GENERATEDNETWORK_HPP_
+#define GENERATEDNETWORK_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+#include "BooleanDynamics.hpp"
+#include "CompiledNetwork.hpp"
+
+namespace bn {
+
+class ImmutableBooleanNetwork;
+
+class MutableBooleanNetwork;
+
+/**
+ * Network whose update function is generated C++ code, compiled with the
+ * system compiler and loaded at run time.
+ *
+ * The generated function is straight-line code: input indices are
+ * immediates and truth tables are constant bitmasks (see generate()). It is
+ * compiled into a shared object which is loaded with @c dlopen.
+ *
+ * Shared objects are cached under a directory by hash of the generated
+ * source and of the compiler command, so each network is compiled once. The
+ * directory is @c $BN_CODEGEN_CACHE if set, or @c bn-codegen under
+ * @c $XDG_CACHE_HOME, or <tt>/tmp/bn-codegen-</tt><em>uid</em> otherwise; it
+ * is created with mode 0700. An object is only loaded if it and the
+ * directory are owned by the user and not writable by group or others, and
+ * it is discarded unless the source and compiler command embedded in it
+ * match. The compiler is @c $BN_CXX if set, or the compiler this library
+ * was built with otherwise; it is run directly rather than through a shell,
+ * hence it must name a program without arguments.
+ *
+ * If the network has functions stored as a DecisionDiagram or a
+ * ThresholdFunction, which the generator does not support, if no compiler
+ * is available, or if compilation or loading fails, this object falls back
+ * to a CompiledNetwork: results are the same, only slower. isNative() tells
+ * which path is in use.
+ *
+ * Later modifications to the source network are not seen by this object.
+ */
+class GeneratedNetwork : public BooleanDynamics {
+public:
+	typedef CompiledNetwork::word_type word_type;
+
+	/**
+	 * Signature of the generated function: it reads the current state as
+	 * 64-bit words and writes the next one.
+	 */
+	typedef void (*StepFunction)(const word_type* in, word_type* out);
+
+	using BooleanDynamics::update; // make update(size_t) visible
+
+	explicit GeneratedNetwork(const ImmutableBooleanNetwork& net);
+
+	explicit GeneratedNetwork(const MutableBooleanNetwork& net);
+
+	GeneratedNetwork* clone() const {
+		return new GeneratedNetwork(*this);
+	}
+
+	/**
+	 * Returns the number of nodes in the network.
+	 * @return the number of nodes
+	 */
+	std::size_t size() const {
+		return interpreted.size();
+	}
+
+	/**
+	 * Sets the state of this network.
+	 * @param s the new state
+	 */
+	void setState(const State& s) {
+		assert(size() == s.size());
+		state = s;
+	}
+
+	/**
+	 * Returns a reference to the current state of this network.
+	 * @return the state of this network
+	 */
+	const State& getState() const {
+		return state;
+	}
+
+	/**
+	 * Tells whether steps run generated code.
+	 * @return false if this object fell back to the interpreted path
+	 */
+	bool isNative() const {
+		return function != NULL;
+	}
+
+	/**
+	 * Returns the path of the loaded shared object.
+	 * @return a path, or the empty string if isNative() is false
+	 */
+	const std::string& getLibrary() const {
+		return library;
+	}
+
+	void update();
+
+	State operator()(const State& s);
+
+	void update(State& s);
+
+	void step(const State& in, State& out);
+
+	BooleanFunction getFunction(const std::size_t i) const {
+		return interpreted.getFunction(i);
+	}
+
+	static void generate(const ImmutableBooleanNetwork& net, std::ostream& out);
+
+	static void generate(const MutableBooleanNetwork& net, std::ostream& out);
+
+private:
+	/**
+	 * Fallback and source of node functions.
+	 */
+	CompiledNetwork interpreted;
+	/**
+	 * Handle of the shared object, closed with the last copy of this object.
+	 */
+	boost::shared_ptr<void> handle;
+	/**
+	 * Generated function, or NULL.
+	 */
+	StepFunction function;
+	/**
+	 * Path of the shared object.
+	 */
+	std::string library;
+	/**
+	 * The current state of the network.
+	 */
+	State state;
+	/**
+	 * Unpacked current and next states.
+	 */
+	std::vector<word_type> inWords, outWords;
+	/**
+	 * Buffer for the next state used by update().
+	 */
+	State next;
+
+	template<class Network> void init(const Network& net);
+
+	template<class Network> static void generateSource(const Network& net,
+			std::ostream& out);
+};
+
+template<> struct is_leaf_dynamics<GeneratedNetwork> : boost::true_type {
+};
+
+} // namespace bn
+
+#endif /* GENERATEDNETWORK_HPP_ */
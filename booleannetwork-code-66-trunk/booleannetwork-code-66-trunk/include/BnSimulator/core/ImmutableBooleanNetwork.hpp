@@ -15,14 +15,39 @@
 
 #include <boost/graph/graph_selectors.hpp>
 #include <boost/graph/compressed_sparse_row_graph.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "BooleanDynamics.hpp"
 #include "BooleanFunction.hpp"
+#include "node_ordering.hpp"
 
 namespace bn {
 
+/**
+ * Network backed by a compressed sparse row graph.
+ *
+ * A network may be loaded with a NodeOrdering other than NATURAL_ORDER, in
+ * which case the graph and the internal state use a numbering that keeps
+ * nodes close to their inputs. The permutation is hidden: states, node
+ * indices and printing always use the numbering of the input files, and so
+ * does the state of the network, so that getState() only reads it. Steps
+ * permute their state in and out, which costs two passes over the state.
+ *
+ * The graph and the numbering never change after makeNetwork() and are
+ * shared by copies, so that clone() only copies the states of the network.
+ * The const step() takes its buffers from the caller, so threads may share
+ * one network by passing a Scratch each; size(), getFunction() and
+ * getInputs() are safe to call concurrently as well.
+ */
 class ImmutableBooleanNetwork : public BooleanDynamics {
 public:
+	/**
+	 * Buffers of a step, which hold permuted states.
+	 */
+	struct Scratch {
+		State in, out;
+	};
+
 	using BooleanDynamics::update; // make update(size_t) visible
 
 	/**
@@ -30,7 +55,7 @@ public:
 	 * @return the number of nodes
 	 */
 	size_t size() const {
-		return boost::num_vertices(net);
+		return boost::num_vertices(graph->net);
 	}
 
 	/**
@@ -54,24 +79,44 @@ public:
 		return state;
 	}
 
+	/**
+	 * Tells whether this network uses an internal numbering of its nodes.
+	 * @return false if the network was loaded with NATURAL_ORDER
+	 */
+	bool isReordered() const {
+		return !graph->order.empty();
+	}
+
 	void update();
 
 	State operator()(const State& s);
 
 	void update(State& s);
 
+	void step(const State& in, State& out);
+
+	void step(const State& in, State& out, Scratch& scratch) const;
+
 	BooleanFunction getFunction(const size_t i) const;
 
 	std::vector<BooleanFunction> getFunctions() const;
 
+	std::vector<std::size_t> getInputs(const size_t i) const;
+
 	static ImmutableBooleanNetwork makeNetwork(const char topologyFilename[],
-			const char functionFilename[]);
+			const char functionFilename[], const NodeOrdering ordering =
+					NATURAL_ORDER);
+
+	static ImmutableBooleanNetwork makeNetwork(const std::vector<std::vector<
+			std::size_t> >& topology,
+			const std::vector<BooleanFunction>& functions,
+			const NodeOrdering ordering = NATURAL_ORDER);
 
 	friend std::ostream& operator<<(std::ostream& out,
 			const ImmutableBooleanNetwork& rbn);
 
 protected:
-	typedef std::vector<int> TruthTable;
+	typedef BooleanFunction TruthTable;
 	typedef boost::compressed_sparse_row_graph<boost::directedS, TruthTable>
 			Network;
 	/**
@@ -79,15 +124,49 @@ protected:
 	 */
 	State state;
 
-	Network net;
+	/**
+	 * Buffer for the next state used by update().
+	 */
+	State next;
 
 private:
+	/**
+	 * The part of a network that is shared by copies.
+	 */
+	struct Graph {
+		Network net;
+		/**
+		 * The node numbered @e i internally is node order[i] of the input
+		 * files; empty for NATURAL_ORDER.
+		 */
+		std::vector<std::size_t> order;
+		/**
+		 * Inverse of order.
+		 */
+		std::vector<std::size_t> rank;
+	};
+
+	boost::shared_ptr<const Graph> graph;
+	/**
+	 * Buffers of step().
+	 */
+	Scratch scratch;
+
+	void eval(const State& in, State& out) const;
+
+	void permuteIn(const State& s, State& internal) const;
+
+	void permuteOut(const State& internal, State& s) const;
+
 	/**
 	 * This class disallows assignment.
 	 */
 	ImmutableBooleanNetwork& operator=(const ImmutableBooleanNetwork&);
 };
 
+template<> struct is_leaf_dynamics<ImmutableBooleanNetwork> : boost::true_type {
+};
+
 }
 
 #endif /* IMMUTABLEBOOLEANNETWORK_HPP_ */
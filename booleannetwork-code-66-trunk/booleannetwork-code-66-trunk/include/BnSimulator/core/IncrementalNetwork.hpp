@@ -0,0 +1,193 @@
+/*
+ * IncrementalNetwork.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef INCREMENTALNETWORK_HPP_
+#define INCREMENTALNETWORK_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "BooleanDynamics.hpp"
+
+namespace bn {
+
+class ImmutableBooleanNetwork;
+
+class MutableBooleanNetwork;
+
+/**
+ * Event-driven snapshot of a network, which re-evaluates only the nodes
+ * whose inputs changed in the previous step.
+ *
+ * Near an attractor, and in ordered networks dominated by a frozen core, few
+ * nodes flip at each step. This class keeps, for every node, the truth table
+ * index of its current inputs. When a node flips, the corresponding bit of
+ * the index of each of its out-neighbours is toggled and those neighbours are
+ * scheduled for evaluation; a node none of whose inputs changed keeps its
+ * value. The cost of a step is thus proportional to the number of edges
+ * leaving flipped nodes rather than to the size of the network.
+ *
+ * When the fraction of flipped nodes exceeds a threshold (see setThreshold())
+ * the bookkeeping costs more than it saves, and the step falls back to
+ * evaluating every node.
+ *
+ * The tracked state is the last state computed by step(). A call to step()
+ * with any other state, which is the case of the first one, evaluates every
+ * node and restarts tracking from there. Cycle finders and update(), which
+ * always pass the previous successor, get the incremental path.
+ *
+ * Nodes without a function (like the inputs of a ControllableBooleanNetwork)
+ * keep their value. Later modifications to the source network are not seen by
+ * this object.
+ */
+class IncrementalNetwork : public BooleanDynamics {
+public:
+	using BooleanDynamics::update; // make update(size_t) visible
+
+	explicit IncrementalNetwork(const ImmutableBooleanNetwork& net);
+
+	explicit IncrementalNetwork(const MutableBooleanNetwork& net);
+
+	IncrementalNetwork* clone() const {
+		return new IncrementalNetwork(*this);
+	}
+
+	/**
+	 * Returns the number of nodes in the network.
+	 * @return the number of nodes
+	 */
+	std::size_t size() const {
+		return functions.size();
+	}
+
+	/**
+	 * Sets the state of this network.
+	 * @param s the new state
+	 */
+	void setState(const State& s) {
+		assert(size() == s.size());
+		state = s;
+	}
+
+	/**
+	 * Returns a reference to the current state of this network.
+	 * @return the state of this network
+	 */
+	const State& getState() const {
+		return state;
+	}
+
+	/**
+	 * Returns the fraction of flipped nodes above which a step evaluates
+	 * every node.
+	 * @return a number between 0 and 1
+	 */
+	double getThreshold() const {
+		return threshold;
+	}
+
+	/**
+	 * Sets the fraction of flipped nodes above which a step evaluates every
+	 * node: 0 disables incremental steps, 1 always uses them.
+	 * @param t a number between 0 and 1
+	 */
+	void setThreshold(const double t) {
+		assert(t >= 0 && t <= 1);
+		threshold = t;
+	}
+
+	/**
+	 * Returns the number of steps that evaluated every node.
+	 * @return a step count
+	 */
+	std::size_t getFullSteps() const {
+		return fullSteps;
+	}
+
+	/**
+	 * Returns the number of steps that evaluated only the neighbours of
+	 * flipped nodes.
+	 * @return a step count
+	 */
+	std::size_t getIncrementalSteps() const {
+		return incrementalSteps;
+	}
+
+	void update();
+
+	State operator()(const State& s);
+
+	void update(State& s);
+
+	void step(const State& in, State& out);
+
+	BooleanFunction getFunction(const std::size_t i) const {
+		assert(i < size());
+		return functions[i];
+	}
+
+private:
+	/**
+	 * Node @e i reads inputs[inOffsets[i]] ... inputs[inOffsets[i + 1] - 1],
+	 * least significant input first.
+	 */
+	std::vector<boost::uint32_t> inOffsets, inputs;
+	/**
+	 * Node @e i feeds outputs[outOffsets[i]] ... outputs[outOffsets[i + 1] - 1].
+	 */
+	std::vector<boost::uint32_t> outOffsets;
+	/**
+	 * Out-edges as pairs of target node and position of the source among the
+	 * inputs of the target.
+	 */
+	std::vector<std::pair<boost::uint32_t, boost::uint32_t> > outputs;
+	std::vector<BooleanFunction> functions;
+	/**
+	 * The current state of the network.
+	 */
+	State state;
+	/**
+	 * Buffer for the next state used by update().
+	 */
+	State next;
+	/**
+	 * Last state computed by step().
+	 */
+	State tracked;
+	/**
+	 * Truth table index of every node on the state that preceded tracked.
+	 */
+	std::vector<boost::uint64_t> indices;
+	/**
+	 * Nodes that flipped in the last step.
+	 */
+	std::vector<boost::uint32_t> flipped;
+	/**
+	 * Nodes scheduled for evaluation, and the corresponding flags.
+	 */
+	std::vector<boost::uint32_t> scheduled;
+	std::vector<bool> isScheduled;
+	double threshold;
+	std::size_t fullSteps, incrementalSteps;
+
+	template<class Network> void init(const Network& net);
+
+	void fullStep(const State& in);
+
+	void incrementalStep();
+};
+
+template<> struct is_leaf_dynamics<IncrementalNetwork> : boost::true_type {
+};
+
+} // namespace bn
+
+#endif /* INCREMENTALNETWORK_HPP_ */
@@ -0,0 +1,122 @@
+/*
+ * InterleavedNetwork.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef INTERLEAVEDNETWORK_HPP_
+#define INTERLEAVEDNETWORK_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "BooleanDynamics.hpp"
+#include "CompiledNetwork.hpp"
+
+namespace bn {
+
+/**
+ * Snapshot of a network that advances several independent trajectories
+ * together on one thread, to hide the latency of memory.
+ *
+ * In a network whose state does not fit in cache, every input read by a node
+ * is likely to miss, and a single trajectory leaves the processor waiting on
+ * memory. This class steps a group of trajectories (lanes) node by node in
+ * round-robin: each node is evaluated in every lane before moving to the
+ * next one, so that the inputs and truth table of the node are loaded once
+ * for the whole group. The words of the states are interleaved, so that the
+ * lanes of an input share its cache lines and a miss is paid once for up to
+ * eight lanes. Moreover, while evaluating a node, the input words of the node
+ * getPrefetchDistance() positions ahead are prefetched.
+ *
+ * Nodes are stored in the buckets of a CompiledNetwork, whose results this
+ * class reproduces exactly. A single state can be advanced with update() or
+ * step() too, so that the object can be passed to the cycle finders; the
+ * interleaved cycle finder (see cycle_finder::interleaved_brent()) keeps a
+ * whole group of trajectories busy.
+ */
+class InterleavedNetwork : public BasicBooleanDynamics<State> {
+public:
+	typedef CompiledNetwork::word_type word_type;
+
+	explicit InterleavedNetwork(const ImmutableBooleanNetwork& net);
+
+	explicit InterleavedNetwork(const MutableBooleanNetwork& net);
+
+	std::size_t size() const {
+		return compiled.size();
+	}
+
+	/**
+	 * Returns the number of nodes ahead of the current one whose inputs are
+	 * prefetched.
+	 * @return a distance in nodes, 0 if prefetching is disabled
+	 */
+	std::size_t getPrefetchDistance() const {
+		return distance;
+	}
+
+	/**
+	 * Sets the number of nodes ahead of the current one whose inputs are
+	 * prefetched.
+	 * @param d a distance in nodes, 0 to disable prefetching
+	 */
+	void setPrefetchDistance(const std::size_t d) {
+		distance = d;
+	}
+
+	State operator()(const State& s);
+
+	void update(State& s);
+
+	void step(const State& in, State& out);
+
+	/**
+	 * Advances every state of a group by one step.
+	 * @param states the states of the trajectories, all of size()
+	 */
+	void update(std::vector<State>& states);
+
+	void step(const std::vector<State>& in, std::vector<State>& out);
+
+private:
+	CompiledNetwork compiled;
+	std::size_t distance;
+	/**
+	 * Number of states in the group being advanced.
+	 */
+	std::size_t lanes;
+	/**
+	 * Unpacked current states: word @e w of lane @e t is at w * lanes + t.
+	 */
+	std::vector<word_type> inWords;
+	/**
+	 * Unpacked next states, laid out like inWords.
+	 */
+	std::vector<word_type> outWords;
+	/**
+	 * Output bits of the current word in every lane.
+	 */
+	std::vector<word_type> accs;
+	/**
+	 * Buffers used by update().
+	 */
+	State next;
+	std::vector<State> nextGroup;
+
+	void eval();
+
+	template<std::size_t L> void evalBuckets();
+
+	template<std::size_t K, std::size_t L> void evalBucket(const std::size_t k);
+
+	void flush(const std::size_t w);
+};
+
+template<> struct is_leaf_dynamics<InterleavedNetwork> : boost::true_type {
+};
+
+} // namespace bn
+
+#endif /* INTERLEAVEDNETWORK_HPP_ */
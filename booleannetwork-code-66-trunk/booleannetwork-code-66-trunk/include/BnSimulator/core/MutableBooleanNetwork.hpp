@@ -27,7 +27,7 @@ private:
 	friend class Updater;
 
 public:
-	typedef std::vector<int> TruthTable;
+	typedef BooleanFunction TruthTable;
 	typedef boost::adjacency_list<boost::vecS, boost::vecS,
 			boost::bidirectionalS, TruthTable> Network;
 
@@ -76,7 +76,17 @@ public:
 
 	std::vector<BooleanFunction> getFunctions() const;
 
-	BooleanDynamics* simulate() {
+	std::vector<std::size_t> getInputs(const size_t i) const;
+
+	/**
+	 * Returns dynamics that run on the current topology of this network,
+	 * with a state of their own.
+	 *
+	 * The result reads this network, which must outlive it and must not be
+	 * modified while it is used, but never modifies it.
+	 * @return new dynamics, owned by the caller
+	 */
+	BooleanDynamics* simulate() const {
 		return new Updater(*this);
 	}
 
@@ -93,6 +103,8 @@ public:
 
 	void update(State& s);
 
+	void step(const State& in, State& out);
+
 	static MutableBooleanNetwork makeNetwork(const char topologyFilename[],
 			const char functionFilename[]);
 
@@ -107,12 +119,19 @@ protected:
 
 	Network net;
 
+	/**
+	 * Buffer for the next state used by update().
+	 */
+	State next;
+
 private:
+	void eval(const State& in, State& out) const;
+
 	class Updater : public BooleanDynamics {
 	public:
 		using BooleanDynamics::update;
 
-		Updater(MutableBooleanNetwork& bn) :
+		Updater(const MutableBooleanNetwork& bn) :
 			bn(&bn) {
 		}
 
@@ -132,6 +151,10 @@ private:
 
 		void update(State& s);
 
+		void step(const State& in, State& out) {
+			bn->eval(in, out);
+		}
+
 		size_t size() const {
 			return bn->size();
 		}
@@ -141,9 +164,11 @@ private:
 		}
 
 	private:
-		MutableBooleanNetwork* bn;
+		const MutableBooleanNetwork* bn;
 
 		State state;
+
+		State next;
 	};
 };
 
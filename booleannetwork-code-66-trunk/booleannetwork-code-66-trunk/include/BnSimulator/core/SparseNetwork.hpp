@@ -0,0 +1,120 @@
+/*
+ * SparseNetwork.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef SPARSENETWORK_HPP_
+#define SPARSENETWORK_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "BooleanDynamics.hpp"
+#include "CompiledNetwork.hpp"
+#include "SparseState.hpp"
+
+namespace bn {
+
+class ImmutableBooleanNetwork;
+
+class MutableBooleanNetwork;
+
+/**
+ * Dynamics of a network over SparseState objects.
+ *
+ * It is a snapshot of an ImmutableBooleanNetwork or MutableBooleanNetwork
+ * taken at construction time. A node none of whose inputs is active takes
+ * the value of its function on the all-zero input, which is computed once.
+ * The successor of a sparse state is therefore obtained by evaluating only
+ * the out-neighbours of its active nodes, at a cost proportional to the
+ * number of edges leaving them plus the number of nodes that are active on
+ * the all-zero input. Dense states are evaluated by a CompiledNetwork. In
+ * both cases the successor chooses its own representation by density.
+ *
+ * Typical usage:
+ * @code
+ * SparseNetwork sparse(net);
+ * BasicAttractor<SparseState> a = cycle_finder::brent(sparse, SparseState(s));
+ * @endcode
+ *
+ * Nodes without a function (like the inputs of a ControllableBooleanNetwork)
+ * keep their value.
+ */
+class SparseNetwork : public BasicBooleanDynamics<SparseState> {
+public:
+	explicit SparseNetwork(const ImmutableBooleanNetwork& net);
+
+	explicit SparseNetwork(const MutableBooleanNetwork& net);
+
+	std::size_t size() const {
+		return functions.size();
+	}
+
+	SparseState operator()(const SparseState& s);
+
+	void update(SparseState& s);
+
+	void step(const SparseState& in, SparseState& out);
+
+private:
+	/**
+	 * Node @e i reads inputs[inOffsets[i]] ... inputs[inOffsets[i + 1] - 1],
+	 * least significant input first.
+	 */
+	std::vector<boost::uint32_t> inOffsets, inputs;
+	/**
+	 * Node @e i feeds outputs[outOffsets[i]] ... outputs[outOffsets[i + 1] - 1].
+	 */
+	std::vector<boost::uint32_t> outOffsets;
+	/**
+	 * Out-edges as pairs of target node and position of the source among the
+	 * inputs of the target.
+	 */
+	std::vector<std::pair<boost::uint32_t, boost::uint32_t> > outputs;
+	std::vector<BooleanFunction> functions;
+	/**
+	 * Nodes with a function whose value on the all-zero input is 1.
+	 */
+	std::vector<SparseState::index_type> baseline;
+	/**
+	 * Truth table index of the nodes with an active input; it is zero for
+	 * every node between two steps.
+	 */
+	std::vector<boost::uint64_t> indices;
+	/**
+	 * Nodes with an active input in the current step.
+	 */
+	std::vector<boost::uint32_t> touched;
+	/**
+	 * Active nodes of the successor being computed.
+	 */
+	std::vector<SparseState::index_type> result;
+	/**
+	 * Evaluates dense states.
+	 */
+	CompiledNetwork compiled;
+	/**
+	 * Successor of a dense state, swapped into the result.
+	 */
+	State denseNext;
+	/**
+	 * Buffer for the next state used by update().
+	 */
+	SparseState next;
+
+	template<class Network> void init(const Network& net);
+
+	void sparseStep(const SparseState& in);
+};
+
+template<> struct is_leaf_dynamics<SparseNetwork> : boost::true_type {
+};
+
+} // namespace bn
+
+#endif /* SPARSENETWORK_HPP_ */
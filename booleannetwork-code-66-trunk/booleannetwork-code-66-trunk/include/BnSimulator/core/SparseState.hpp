@@ -0,0 +1,252 @@
+/*
+ * SparseState.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef SPARSESTATE_HPP_
+#define SPARSESTATE_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "network_state.hpp"
+
+namespace bn {
+
+/**
+ * A network state that stores the indices of its active nodes when they are
+ * few, and a bitset otherwise.
+ *
+ * In large networks where only a small fraction of the nodes is active, a
+ * dense State costs size() bits for copies, comparisons and hashes whatever
+ * the activity. This class keeps the sorted list of the active nodes as long
+ * as it takes less memory than the bitset, that is as long as count() is at
+ * most size() / density_ratio, and switches to a bitset beyond that. The
+ * representation is a function of count() and size() only, so two equal
+ * states always use the same one; isSparse() tells which one is in use.
+ *
+ * The class provides the subset of the dynamic_bitset interface used by
+ * BasicAttractor, BasicTrajectory and the cycle finders, with the same
+ * semantics and ordering; SparseNetwork is the matching dynamics. Single bit
+ * modifications that cross the density threshold convert the whole state,
+ * so states are best built in bulk with assign().
+ */
+class SparseState {
+public:
+	typedef std::size_t size_type;
+	typedef boost::uint32_t index_type;
+
+	/**
+	 * A state is sparse while count() * density_ratio <= size().
+	 */
+	static const size_type density_ratio = 32;
+
+	SparseState() :
+		n(0), ones(0) {
+	}
+
+	/**
+	 * Initializes a state of @a n inactive nodes.
+	 */
+	explicit SparseState(const size_type n) :
+		n(n), ones(0) {
+	}
+
+	/**
+	 * Converts a dense state.
+	 * @param s a state
+	 */
+	explicit SparseState(const State& s);
+
+	/**
+	 * Initializes a state of @a n nodes whose active nodes are given by a
+	 * range of indices, in any order and possibly repeated.
+	 */
+	template<class InputIterator> SparseState(const size_type n,
+			InputIterator first, InputIterator last) :
+		n(n), active(first, last) {
+		std::sort(active.begin(), active.end());
+		active.erase(std::unique(active.begin(), active.end()), active.end());
+		assert(active.empty() || active.back() < n);
+		ones = active.size();
+		normalize();
+	}
+
+	/**
+	 * Replaces this state with a state of @a n nodes whose active nodes are
+	 * @a indices. The content of @a indices is swapped in, so that a caller
+	 * that reuses the same vector does not allocate memory.
+	 * @param n the number of nodes
+	 * @param indices strictly increasing node indices less than @a n; on
+	 * 	return it holds unspecified values
+	 */
+	void assign(const size_type n, std::vector<index_type>& indices);
+
+	/**
+	 * Replaces this state with a dense state, whose content is swapped in.
+	 * @param s a state; on return it holds unspecified values
+	 */
+	void assign(State& s);
+
+	/**
+	 * Converts this state to a dense one.
+	 * @return a State equal to this object
+	 */
+	State toState() const;
+
+	size_type size() const {
+		return n;
+	}
+
+	size_type count() const {
+		return ones;
+	}
+
+	bool any() const {
+		return ones != 0;
+	}
+
+	bool none() const {
+		return ones == 0;
+	}
+
+	/**
+	 * Tests whether this state stores the list of its active nodes.
+	 * @return @e true if the state is sparse, @e false if it is a bitset
+	 */
+	bool isSparse() const {
+		return dense.empty();
+	}
+
+	/**
+	 * Returns the active nodes of a sparse state.
+	 * @return the sorted indices of the active nodes
+	 */
+	const std::vector<index_type>& indices() const {
+		assert(isSparse());
+		return active;
+	}
+
+	/**
+	 * Returns the bitset of a dense state.
+	 * @return the bitset
+	 */
+	const State& bits() const {
+		assert(!isSparse());
+		return dense;
+	}
+
+	/**
+	 * Returns the number of bytes of heap memory used by this state.
+	 * @return a size in bytes
+	 */
+	size_type memory() const {
+		return active.capacity() * sizeof(index_type) + dense.num_blocks()
+				* sizeof(State::block_type);
+	}
+
+	bool test(const size_type i) const {
+		assert(i < n);
+		return isSparse() ? std::binary_search(active.begin(), active.end(),
+				index_type(i)) : dense.test(i);
+	}
+
+	bool operator[](const size_type i) const {
+		return test(i);
+	}
+
+	SparseState& set(const size_type i, const bool v = true);
+
+	SparseState& reset(const size_type i) {
+		return set(i, false);
+	}
+
+	SparseState& reset();
+
+	SparseState& flip(const size_type i) {
+		return set(i, !test(i));
+	}
+
+	void swap(SparseState& other) {
+		std::swap(n, other.n);
+		std::swap(ones, other.ones);
+		active.swap(other.active);
+		dense.swap(other.dense);
+	}
+
+	bool operator==(const SparseState& other) const {
+		// the representation depends on count() and size() only
+		return n == other.n && ones == other.ones && (isSparse() ? active
+				== other.active : dense == other.dense);
+	}
+
+	bool operator!=(const SparseState& other) const {
+		return !operator==(other);
+	}
+
+	/**
+	 * Compares two states with the same ordering as dynamic_bitset, that is
+	 * lexicographically starting from the most significant (last) node.
+	 */
+	bool operator<(const SparseState& other) const;
+
+	bool operator>(const SparseState& other) const {
+		return other < *this;
+	}
+
+	bool operator<=(const SparseState& other) const {
+		return !(other < *this);
+	}
+
+	bool operator>=(const SparseState& other) const {
+		return !(*this < other);
+	}
+
+private:
+	size_type n;
+	/**
+	 * Number of active nodes.
+	 */
+	size_type ones;
+	/**
+	 * Sorted indices of the active nodes if the state is sparse, otherwise
+	 * empty.
+	 */
+	std::vector<index_type> active;
+	/**
+	 * Value of every node if the state is dense, otherwise empty.
+	 */
+	State dense;
+
+	/**
+	 * Switches representation if the density crossed the threshold.
+	 */
+	void normalize();
+};
+
+inline void swap(SparseState& a, SparseState& b) {
+	a.swap(b);
+}
+
+/**
+ * Prints a state like dynamic_bitset does, most significant node first.
+ */
+std::ostream& operator<<(std::ostream& out, const SparseState& s);
+
+/**
+ * Hashes a state with the default mixer of BitsetHasher. Sparse states are
+ * hashed through the indices of their active nodes, so their hash differs
+ * from that of the State holding the same bits.
+ */
+std::size_t hash_value(const SparseState& s);
+
+} // namespace bn
+
+#endif /* SPARSESTATE_HPP_ */
@@ -0,0 +1,169 @@
+/*
+ * ThresholdFunction.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef THRESHOLDFUNCTION_HPP_
+#define THRESHOLDFUNCTION_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <iosfwd>
+#include <utility>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include "network_state.hpp"
+
+namespace bn {
+
+/**
+ * A boolean function defined by a weighted sum of its inputs.
+ *
+ * The function is true if \f$\sum_j w_j x_j > \theta\f$ and false if the sum
+ * is lower than \f$\theta\f$. A sum equal to \f$\theta\f$ is resolved by the
+ * tie rule: to false, to true, or to the value of one of the inputs
+ * (usually the node itself, as in Hopfield-like gene regulatory models).
+ *
+ * Memory is proportional to the arity @e k rather than to \f$2^k\f$. When
+ * every weight is -1, 0 or 1 (and @e k is at most 64), the sum on a truth
+ * table index is the difference of the population counts of two masks of the
+ * index; other weights are summed over the active inputs.
+ *
+ * Equality is structural: two threshold functions are equal if they have the
+ * same weights, threshold and tie rule.
+ */
+class ThresholdFunction {
+public:
+	typedef boost::int32_t weight_type;
+	/**
+	 * Type of the threshold and of weighted sums, which cannot overflow with
+	 * up to \f$2^{32}\f$ weights.
+	 */
+	typedef boost::int64_t sum_type;
+
+	/**
+	 * Value of the function when the weighted sum equals the threshold.
+	 */
+	enum TieRule {
+		TIE_FALSE, TIE_TRUE, TIE_KEEP
+	};
+
+	ThresholdFunction(const std::vector<weight_type>& weights,
+			const sum_type threshold, const TieRule tie = TIE_FALSE,
+			const std::size_t kept = 0);
+
+	std::size_t getArity() const {
+		return weights.size();
+	}
+
+	const std::vector<weight_type>& getWeights() const {
+		return weights;
+	}
+
+	sum_type getThreshold() const {
+		return threshold;
+	}
+
+	TieRule getTieRule() const {
+		return tie;
+	}
+
+	/**
+	 * Returns the input whose value is taken on ties by TIE_KEEP.
+	 * @return an input position, 0 unless the tie rule is TIE_KEEP
+	 */
+	std::size_t getKeptInput() const {
+		return kept;
+	}
+
+	/**
+	 * Tells whether every weight is -1, 0 or 1 and the arity is at most 64,
+	 * so that evaluations use population counts.
+	 */
+	bool isUnit() const {
+		return unit;
+	}
+
+	/**
+	 * Returns the number of bytes used by this function.
+	 * @return the memory footprint of the weights
+	 */
+	std::size_t memory() const {
+		return weights.size() * sizeof(weight_type);
+	}
+
+	/**
+	 * Evaluates the function on a truth table index.
+	 * @param index an input assignment, input @e j being bit @e j
+	 * @return the value of the function
+	 */
+	bool operator()(const boost::uint64_t index) const {
+		assert(weights.size() <= 64);
+		sum_type sum;
+		if (unit)
+			sum = __builtin_popcountll(index & positive)
+					- __builtin_popcountll(index & negative);
+		else {
+			sum = 0;
+			for (boost::uint64_t x = index; x; x &= x - 1)
+				sum += weights[__builtin_ctzll(x)];
+		}
+		// without branches: sums equal to the threshold are unpredictable
+		const bool onTie = (index & keptMask) != 0 || tie == TIE_TRUE;
+		return (sum > threshold) | ((sum == threshold) & onTie);
+	}
+
+	bool operator()(const State& x) const;
+
+	bool dependsOn(const std::size_t i) const;
+
+	std::pair<bool, bool> isConstant() const;
+
+	ThresholdFunction clamped(const std::size_t i, const bool v) const;
+
+	State table() const;
+
+	bool operator==(const ThresholdFunction& other) const {
+		return threshold == other.threshold && tie == other.tie && kept
+				== other.kept && weights == other.weights;
+	}
+
+	bool operator<(const ThresholdFunction& other) const;
+
+	friend std::ostream& operator<<(std::ostream& out,
+			const ThresholdFunction& f);
+
+	friend std::size_t hash_value(const ThresholdFunction& f);
+
+private:
+	std::vector<weight_type> weights;
+	sum_type threshold;
+	TieRule tie;
+	std::size_t kept;
+	/**
+	 * Inputs of weight 1 and -1, if unit.
+	 */
+	boost::uint64_t positive, negative;
+	/**
+	 * The kept input as a mask of a truth table index, if the tie rule is
+	 * TIE_KEEP.
+	 */
+	boost::uint64_t keptMask;
+	bool unit;
+
+	bool value(const sum_type sum, const bool keptValue) const {
+		return sum != threshold ? sum > threshold : tie == TIE_KEEP ? keptValue
+				: tie == TIE_TRUE;
+	}
+
+	bool sums(const std::size_t skip1, const std::size_t skip2, std::vector<
+			sum_type>& res) const;
+};
+
+} // namespace bn
+
+#endif /* THRESHOLDFUNCTION_HPP_ */
@@ -34,13 +34,16 @@ namespace bn {
  * - cycle
  *
  * both of which can possibly be empty.
+ *
+ * Type parameter @a S is the state type; Trajectory is the instantiation for
+ * State.
  */
-class Trajectory : public boost::noncopyable {
+template<class S> class BasicTrajectory : public boost::noncopyable {
 private:
 	/**
 	 * Type of container.
 	 */
-	typedef std::vector<State> StateContainer;
+	typedef std::vector<S> StateContainer;
 
 	/**
 	 * This class help to print a sequence of states to a stream.
@@ -110,7 +113,7 @@ public:
 	 * @param cycleStart an iterator pointing to the beginning of the cycle in
 	 * 	the sequence
 	 */
-	template<class SinglePassRange> Trajectory(const SinglePassRange& r,
+	template<class SinglePassRange> BasicTrajectory(const SinglePassRange& r,
 			typename boost::range_iterator<SinglePassRange>::type cycleStart) :
 		trans(boost::begin(r), cycleStart), cycle(cycleStart, boost::end(r)) {
 	}
@@ -121,7 +124,7 @@ public:
 	 * It simply swaps internal state containers of the two Trajectory objects.
 	 * @param t the other trajectory
 	 */
-	void swap(Trajectory& t) {
+	void swap(BasicTrajectory& t) {
 		std::swap(trans, t.trans);
 		std::swap(cycle, t.cycle);
 	}
@@ -179,7 +182,7 @@ public:
 	 * @param sep a string separator that interleaves state representations
 	 * @return an inaccessible (private) proxy object used for printing
 	 */
-	util::Printer<StateContainer> printCycle(const char sep[] = "\n") const {
+	util::detail::Printer<StateContainer> printCycle(const char sep[] = "\n") const {
 		return util::dump(cycle, sep);
 	}
 
@@ -190,7 +193,7 @@ public:
 	 * @param sep a string separator that interleaves state representations
 	 * @return an inaccessible proxy object used for printing
 	 */
-	util::Printer<StateContainer> printTransient(const char sep[] = "\n") const {
+	util::detail::Printer<StateContainer> printTransient(const char sep[] = "\n") const {
 		return util::dump(trans, sep);
 	}
 
@@ -206,11 +209,17 @@ public:
 	 * @param t a Trajectory object
 	 * @return the stream passed as argument
 	 */
-	friend std::ostream& operator<<(std::ostream& out, const Trajectory& t) {
+	friend std::ostream& operator<<(std::ostream& out, const BasicTrajectory& t) {
 		return out << t.printTransient() << t.printCycle();
 	}
 };
 
+typedef BasicTrajectory<State> Trajectory;
+
+template<class S> void swap(BasicTrajectory<S>& a, BasicTrajectory<S>& b) {
+	a.swap(b);
+}
+
 }
 
 namespace std {
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "MutableBooleanNetwork.hpp"
+#include "ThresholdFunction.hpp"
 
 namespace bn {
 
@@ -19,6 +20,13 @@ MutableBooleanNetwork make_network(
 		const std::vector<std::vector<size_t> >& topology, const std::vector<
 				std::vector<int> >& functions);
 
+MutableBooleanNetwork make_random_network(const std::size_t n,
+		const std::size_t k, const double bias = 0.5);
+
+MutableBooleanNetwork make_random_threshold_network(const std::size_t n,
+		const std::size_t k, const ThresholdFunction::TieRule tie =
+				ThresholdFunction::TIE_KEEP);
+
 } // namespace bn
 
 #endif /* FACTORY_HPP_ */
@@ -0,0 +1,85 @@
+/*
+ * lane_kernel.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef LANE_KERNEL_HPP_
+#define LANE_KERNEL_HPP_
+
+#include <cstddef>
+
+#include "BatchState.hpp"
+
+namespace bn {
+
+/**
+ * Instruction-set specific implementation of the node evaluation of
+ * BitslicedNetwork.
+ *
+ * A kernel evaluates the multiplexer tree of one node on @a blocks
+ * consecutive lane words, processing @a width words per register. Kernels for
+ * SSE2, AVX2 and AVX-512 are compiled in separate translation units with the
+ * matching compiler flags and are only invoked when the running CPU supports
+ * them.
+ */
+struct LaneKernel {
+	typedef BatchState::word_type word_type;
+
+	/**
+	 * Signature of an evaluation routine.
+	 *
+	 * @param in lane words of each input, least significant input first
+	 * @param k arity of the node (at least 1)
+	 * @param table the \f$2^k\f$ truth table entries, one per byte
+	 * @param blocks number of lane words per node
+	 * @param scratch buffer of at least \f$2^{k-1}\f$ registers
+	 * @param dst the @a blocks lane words of the output
+	 */
+	typedef void (*Eval)(const word_type* const * in, const std::size_t k,
+			const unsigned char* table, const std::size_t blocks,
+			word_type* scratch, word_type* dst);
+
+	/**
+	 * Name of the instruction set: "scalar", "sse2", "avx2" or "avx512".
+	 */
+	const char* name;
+	/**
+	 * Number of 64-bit words processed at once.
+	 */
+	std::size_t width;
+
+	Eval eval;
+};
+
+namespace detail {
+
+void scalar_lane_eval(const LaneKernel::word_type* const * in,
+		const std::size_t k, const unsigned char* table,
+		const std::size_t blocks, LaneKernel::word_type* scratch,
+		LaneKernel::word_type* dst);
+
+/*
+ * These return NULL when the kernel was not compiled in.
+ */
+const LaneKernel* sse2_lane_kernel();
+
+const LaneKernel* avx2_lane_kernel();
+
+const LaneKernel* avx512_lane_kernel();
+
+} // namespace detail
+
+/**
+ * Maximum number of 64-bit words a kernel processes at once.
+ */
+static const std::size_t MAX_LANE_KERNEL_WIDTH = 8;
+
+const LaneKernel& best_lane_kernel();
+
+const LaneKernel* find_lane_kernel(const char name[]);
+
+} // namespace bn
+
+#endif /* LANE_KERNEL_HPP_ */
@@ -10,6 +10,7 @@
 
 #include <cstddef>
 
+#include <boost/cstdint.hpp>
 #include <boost/function_output_iterator.hpp>
 #include <boost/dynamic_bitset.hpp>
 
@@ -20,35 +21,131 @@ namespace bn {
  */
 typedef boost::dynamic_bitset<> State;
 
-class BitsetHasher {
+/**
+ * Block mixer in the style of wyhash: every 64-bit block is folded into the
+ * accumulator by a 64x64->128 bit multiplication, whose two halves are xored
+ * together. Every input bit affects every output bit, so states that differ
+ * by a few bits, or by a permutation of their blocks, get unrelated hashes.
+ *
+ * A mixer is fed with operator() and read with result(), which also mixes in
+ * the number of bits of the state.
+ */
+class WyMixer {
+public:
+	WyMixer() :
+		h(0xa0761d6478bd642fULL) {
+	}
+
+	void operator()(const boost::uint64_t block) {
+		h = mum(block ^ 0xe7037ed1a0b428dbULL, h ^ 0x8ebc6af09c88c6e3ULL);
+	}
+
+	std::size_t result(const std::size_t bits) const {
+		return static_cast<std::size_t> (mum(h ^ bits, 0x589965cc75374cc3ULL));
+	}
+
 private:
-	template<class BlockType> class BlockHasher {
+	boost::uint64_t h;
+
+	static boost::uint64_t mum(const boost::uint64_t a, const boost::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+		const unsigned __int128 r = static_cast<unsigned __int128> (a) * b;
+		return static_cast<boost::uint64_t> (r) ^ static_cast<boost::uint64_t> (r
+				>> 64);
+#else
+		const boost::uint64_t al = a & 0xffffffffULL, ah = a >> 32;
+		const boost::uint64_t bl = b & 0xffffffffULL, bh = b >> 32;
+		const boost::uint64_t ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah
+				* bh;
+		const boost::uint64_t mid = (ll >> 32) + (lh & 0xffffffffULL) + (hl
+				& 0xffffffffULL);
+		const boost::uint64_t lo = (mid << 32) | (ll & 0xffffffffULL);
+		const boost::uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+		return lo ^ hi;
+#endif
+	}
+};
+
+/**
+ * Block mixer that xors all blocks together.
+ *
+ * It is the hash used by this library up to now: it is fast, but states
+ * whose blocks are permuted collide, and so do many structured states. It is
+ * kept for comparison only.
+ */
+class XorMixer {
+public:
+	XorMixer() :
+		h(0) {
+	}
+
+	void operator()(const boost::uint64_t block) {
+		h ^= block;
+	}
+
+	std::size_t result(const std::size_t) const {
+		return static_cast<std::size_t> (h);
+	}
+
+private:
+	boost::uint64_t h;
+};
+
+/**
+ * Hash function of states, parameterized by a block mixer (see WyMixer).
+ *
+ * Every hashed container of states in this library uses BitsetHasher, which
+ * is this template with the default mixer; containers that take a hasher as
+ * a template parameter accept any other instance.
+ */
+template<class Mixer> class BasicBitsetHasher {
+private:
+	class BlockHasher {
 	private:
-		BlockType& acc;
+		Mixer& mixer;
 
 	public:
-
-		BlockHasher(BlockType& acc) :
-			acc(acc) {
+		BlockHasher(Mixer& mixer) :
+			mixer(mixer) {
 		}
 
-		void operator()(const BlockType b) const {
-			acc ^= b;
+		template<class BlockType> void operator()(const BlockType b) const {
+			mixer(b);
 		}
 	};
 
 public:
-
 	template<class BlockType> std::size_t operator()(
 			const boost::dynamic_bitset<BlockType>& b) const {
-		BlockType h = 0;
-		boost::to_block_range(
-				b,
-				boost::make_function_output_iterator(BlockHasher<BlockType> (h)));
-		return h;
+		Mixer mixer;
+		boost::to_block_range(b, boost::make_function_output_iterator(
+				BlockHasher(mixer)));
+		return mixer.result(b.size());
+	}
+
+	/**
+	 * Hashes a range of 64-bit blocks holding @a bits bits.
+	 */
+	template<class InputIterator> std::size_t operator()(InputIterator first,
+			InputIterator last, const std::size_t bits) const {
+		Mixer mixer;
+		for (; first != last; ++first)
+			mixer(*first);
+		return mixer.result(bits);
+	}
+
+	/**
+	 * Hashes any other state type through its hash_value() function.
+	 */
+	template<class S> std::size_t operator()(const S& s) const {
+		return hash_value(s);
 	}
 };
 
+typedef BasicBitsetHasher<WyMixer> BitsetHasher;
+
+typedef BasicBitsetHasher<XorMixer> XorBitsetHasher;
+
 static const BitsetHasher bitset_hash = BitsetHasher();
 
 } // namespace bn
@@ -0,0 +1,42 @@
+/*
+ * node_ordering.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef NODE_ORDERING_HPP_
+#define NODE_ORDERING_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace bn {
+
+/**
+ * Numbering of the nodes of a network in memory.
+ */
+enum NodeOrdering {
+	/**
+	 * The numbering of the topology file.
+	 */
+	NATURAL_ORDER,
+	/**
+	 * Breadth-first visit order of the undirected graph, one connected
+	 * component after the other.
+	 */
+	BFS_ORDER,
+	/**
+	 * Reverse Cuthill-McKee order, which tends to minimize the bandwidth of
+	 * the adjacency matrix.
+	 */
+	RCM_ORDER
+};
+
+std::vector<std::size_t> node_order(
+		const std::vector<std::vector<std::size_t> >& topology,
+		const NodeOrdering ordering);
+
+} // namespace bn
+
+#endif /* NODE_ORDERING_HPP_ */
@@ -0,0 +1,242 @@
+/*
+ * AttractorCache.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef ATTRACTORCACHE_HPP_
+#define ATTRACTORCACHE_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "../core/Attractor.hpp"
+
+namespace bn {
+
+/**
+ * Bounded map from visited states to the attractor they reach, shared by the
+ * threads of an experiment.
+ *
+ * Every attractor is interned once and gets an ID, which is its index in the
+ * order of interning; a cycle finder that reaches a cached state knows the
+ * attractor without following the rest of the trajectory (see cached()).
+ * Interned attractors never move, hence they are read without a lock.
+ *
+ * States are stored as words in set-associative buckets of WAYS entries,
+ * which are split into shards with a mutex each, so that threads that look up
+ * distinct states seldom wait for each other. The table takes at most the
+ * memory given to the constructor and is allocated at once; when the bucket
+ * of a new state is full, the eviction policy picks the entry it replaces.
+ * The interned attractors are not part of that memory.
+ */
+class AttractorCache : private boost::noncopyable {
+public:
+	typedef State::block_type block_type;
+
+	/**
+	 * Policies for a new state whose bucket is full.
+	 */
+	enum Eviction {
+		/**
+		 * Replaces the first entry, in order of insertion, that was not found
+		 * since the last time the policy passed it (second chance).
+		 */
+		CLOCK,
+		/**
+		 * Replaces the oldest entry.
+		 */
+		FIFO,
+		/**
+		 * Drops the new state: the cache keeps the first states it was given.
+		 */
+		NONE
+	};
+
+	/**
+	 * Counters of the operations on a cache.
+	 */
+	struct Statistics {
+		boost::uint64_t lookups, hits, insertions, evictions;
+
+		Statistics() :
+			lookups(0), hits(0), insertions(0), evictions(0) {
+		}
+
+		/**
+		 * Returns the fraction of the lookups that found their state.
+		 * @return a hit rate in [0, 1], 0 if no state was looked up
+		 */
+		double hitRate() const {
+			return lookups ? double(hits) / lookups : 0;
+		}
+
+		Statistics& operator+=(const Statistics& other) {
+			lookups += other.lookups;
+			hits += other.hits;
+			insertions += other.insertions;
+			evictions += other.evictions;
+			return *this;
+		}
+	};
+
+	/**
+	 * Entries per bucket.
+	 */
+	static const std::size_t WAYS = 8;
+
+	/**
+	 * Default memory for the entries: 64 MiB.
+	 */
+	static const std::size_t DEFAULT_MEMORY = std::size_t(64) << 20;
+
+	/**
+	 * Default number of shards.
+	 */
+	static const std::size_t DEFAULT_SHARDS = 64;
+
+	AttractorCache(const std::size_t nodes, const std::size_t memory =
+			DEFAULT_MEMORY, const Eviction eviction = CLOCK,
+			const std::size_t shards = DEFAULT_SHARDS);
+
+	/**
+	 * Returns the number of nodes of the cached states.
+	 * @return the number of nodes
+	 */
+	std::size_t size() const {
+		return nodes;
+	}
+
+	/**
+	 * Returns the number of blocks of a key, that is of a state converted
+	 * with boost::to_block_range().
+	 * @return a block count
+	 */
+	std::size_t blocks() const {
+		return keyBlocks;
+	}
+
+	/**
+	 * Returns the number of states that fit in this cache.
+	 * @return a state count
+	 */
+	std::size_t capacity() const {
+		return shardCount * buckets * WAYS;
+	}
+
+	std::size_t memory() const;
+
+	Eviction getEviction() const {
+		return eviction;
+	}
+
+	bool find(const block_type* key, std::size_t& id);
+
+	void insert(const block_type* key, const std::size_t id);
+
+	bool find(const State& s, std::size_t& id);
+
+	void insert(const State& s, const std::size_t id);
+
+	std::size_t intern(const Attractor& a);
+
+	/**
+	 * Returns an interned attractor, without locking.
+	 *
+	 * The ID must come from intern() or from find(), which make the
+	 * attractor visible to the calling thread.
+	 * @param id its ID
+	 * @return the attractor, which stays in place until clear()
+	 */
+	const Attractor& getAttractor(const std::size_t id) const {
+		std::size_t k = 0;
+		while ((id + 1) >> (k + 1))
+			++k;
+		return segments[k][id + 1 - (std::size_t(1) << k)];
+	}
+
+	std::size_t numAttractors() const;
+
+	Statistics getStatistics() const;
+
+	void resetStatistics();
+
+	void clear();
+
+private:
+	/**
+	 * An entry, whose key is at the same index of the key array of its shard.
+	 */
+	struct Slot {
+		std::size_t hash;
+		boost::uint32_t id;
+		bool used;
+		/**
+		 * Set when the entry is found, cleared when CLOCK passes it.
+		 */
+		bool referenced;
+	};
+
+	struct Shard {
+		boost::mutex mutex;
+		std::vector<Slot> slots;
+		std::vector<block_type> keys;
+		/**
+		 * Next entry of every bucket the eviction policy looks at.
+		 */
+		std::vector<unsigned char> hands;
+		Statistics statistics;
+	};
+
+	std::size_t nodes, keyBlocks;
+	Eviction eviction;
+	std::size_t shardCount;
+	/**
+	 * Buckets per shard.
+	 */
+	std::size_t buckets;
+	boost::scoped_array<Shard> shards;
+
+	/**
+	 * Number of segments of the interned attractors.
+	 */
+	static const std::size_t SEGMENTS = 32;
+
+	/**
+	 * Protects the interned attractors and their index, which are only
+	 * appended to.
+	 */
+	mutable boost::mutex internMutex;
+	/**
+	 * Interned attractors: segment @e k holds \f$2^k\f$ of them, from ID
+	 * \f$2^k - 1\f$ on, and is allocated once, so that attractors never move.
+	 */
+	boost::scoped_array<Attractor> segments[SEGMENTS];
+	std::size_t interned;
+	std::map<State, std::size_t> ids;
+
+	Shard& shardOf(const std::size_t hash) {
+		return shards[hash % shardCount];
+	}
+
+	/**
+	 * Returns the first slot of the bucket of a hash in its shard.
+	 */
+	std::size_t bucketOf(const std::size_t hash) const {
+		return hash / shardCount % buckets * WAYS;
+	}
+
+	std::size_t victim(Shard& shard, const std::size_t bucket);
+};
+
+} // namespace bn
+
+#endif /* ATTRACTORCACHE_HPP_ */
@@ -0,0 +1,258 @@
+/*
+ * ExperimentArena.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef EXPERIMENTARENA_HPP_
+#define EXPERIMENTARENA_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "../core/Attractor.hpp"
+#include "../core/BooleanDynamics.hpp"
+#include "../util/Arena.hpp"
+#include "cycle_finder/brent.hpp"
+
+namespace bn {
+
+/**
+ * Owner of the attractors found by one experiment, with the number of times
+ * each of them was found.
+ *
+ * An Attractor holds a vector of states, each of which is a separate heap
+ * block, and counting attractors in a util::Counter copies them into the
+ * nodes of a map. This class instead stores the states of each distinct
+ * attractor as contiguous words in a util::Arena, and finds them again by a
+ * hash of their representant. Trajectories are followed in scratch states
+ * owned by this object, so that, once the scratch states and the hash index
+ * have grown, sampling a basin allocates memory only when a new attractor is
+ * found, and all of it is released in one shot by release() or by the
+ * destructor.
+ *
+ * Typical usage, which counts the attractors reached from every state of a
+ * range (see basin_of_attraction()):
+ * @code
+ * ExperimentArena arena;
+ * basin_of_attraction(states, brent(net), arena);
+ * for (ExperimentArena::const_iterator it = arena.begin(); it != arena.end(); ++it)
+ * 	std::cout << it->getRepresentant() << ' ' << it->getCount() << '\n';
+ * @endcode
+ *
+ * References to attractors are valid until the arena is released.
+ */
+class ExperimentArena : private boost::noncopyable {
+private:
+	/**
+	 * Header of a stored attractor, followed by its states.
+	 */
+	struct Entry {
+		std::size_t hash;
+		std::size_t count;
+		std::size_t length;
+	};
+
+public:
+	typedef State::block_type block_type;
+
+	/**
+	 * An attractor stored in an ExperimentArena.
+	 *
+	 * Its states are kept in cycle order starting from the representant.
+	 */
+	class AttractorRef {
+	public:
+		/**
+		 * Builds the empty attractor, which stands for a trajectory that gave
+		 * up.
+		 */
+		AttractorRef() :
+			entry(NULL), nodes(0) {
+		}
+
+		bool empty() const {
+			return !entry;
+		}
+
+		std::size_t getLength() const {
+			return entry->length;
+		}
+
+		/**
+		 * Returns the number of times this attractor was found.
+		 * @return an insertion count
+		 */
+		std::size_t getCount() const {
+			return entry->count;
+		}
+
+		State getRepresentant() const {
+			return getState(0);
+		}
+
+		State getState(const std::size_t i) const;
+
+		Attractor toAttractor() const;
+
+		bool operator==(const AttractorRef& other) const {
+			return entry == other.entry;
+		}
+
+		bool operator!=(const AttractorRef& other) const {
+			return entry != other.entry;
+		}
+
+		/**
+		 * Compares representants, like Attractor::operator<().
+		 */
+		bool operator<(const AttractorRef& other) const {
+			return getRepresentant() < other.getRepresentant();
+		}
+
+	private:
+		const Entry* entry;
+		std::size_t nodes;
+
+		AttractorRef(const Entry* entry, const std::size_t nodes) :
+			entry(entry), nodes(nodes) {
+		}
+
+		friend class ExperimentArena;
+	};
+
+	typedef std::vector<AttractorRef>::const_iterator const_iterator;
+
+	typedef const_iterator iterator;
+
+	explicit ExperimentArena(const std::size_t blockSize =
+			util::Arena::DEFAULT_BLOCK_SIZE);
+
+	/**
+	 * Runs Brent's cycle finder from a state and counts the attractor it
+	 * reaches, like cycle_finder::brent(), whose steps it dispatches in the
+	 * same way.
+	 * @param dyn the dynamics
+	 * @param s an initial state
+	 * @param term the terminator of cycle_finder::brent(): the trajectory
+	 * 	gives up when it returns @e true
+	 * @return the attractor, or the empty attractor if the trajectory gave up
+	 */
+	template<class D, class Terminator> AttractorRef find(D& dyn,
+			const State& s, Terminator term) {
+		using std::swap;
+		std::size_t power = 1, lambda = 1;
+		tortoise = s;
+		detail::static_step(dyn, tortoise, hare);
+		for (std::size_t iter = 0; tortoise != hare; ++iter) {
+			if (term(iter))
+				return AttractorRef();
+			if (power == lambda) {
+				tortoise = hare;
+				power *= 2;
+				lambda = 0;
+			}
+			detail::static_step(dyn, hare, next);
+			swap(hare, next);
+			++lambda;
+		}
+		return insert(dyn, hare, lambda);
+	}
+
+	/**
+	 * Runs Brent's cycle finder from a state until it reaches an attractor,
+	 * and counts the attractor.
+	 * @param dyn the dynamics
+	 * @param s an initial state
+	 * @return the attractor
+	 */
+	template<class D> AttractorRef find(D& dyn, const State& s) {
+		return find(dyn, s, cycle_finder::NeverGiveUp());
+	}
+
+	AttractorRef insert(BasicBooleanDynamics<State>& dyn, const State& s,
+			const std::size_t length);
+
+	AttractorRef insert(const Attractor& a);
+
+	/**
+	 * Returns the number of distinct attractors in this arena.
+	 * @return an attractor count
+	 */
+	std::size_t size() const {
+		return found.size();
+	}
+
+	/**
+	 * Returns the number of insertions, which is the sum of the counts of the
+	 * attractors.
+	 * @return an insertion count
+	 */
+	std::size_t insertions() const {
+		return count;
+	}
+
+	/**
+	 * Returns an iterator to the first attractor, in order of insertion.
+	 */
+	const_iterator begin() const {
+		return found.begin();
+	}
+
+	const_iterator end() const {
+		return found.end();
+	}
+
+	std::size_t memory() const;
+
+	void release();
+
+private:
+	util::Arena arena;
+	/**
+	 * Number of nodes of the states, and of blocks per state.
+	 */
+	std::size_t nodes, blocks;
+	/**
+	 * Open addressing hash table of the stored attractors, by representant.
+	 */
+	std::vector<Entry*> index;
+	/**
+	 * Stored attractors in order of insertion.
+	 */
+	std::vector<AttractorRef> found;
+	std::size_t count;
+	/**
+	 * Scratch states for trajectories.
+	 */
+	State tortoise, hare, next, least;
+	/**
+	 * Blocks of the representant being looked up.
+	 */
+	std::vector<block_type> key;
+
+	static const block_type* words(const Entry* e) {
+		return reinterpret_cast<const block_type*> (e + 1);
+	}
+
+	static block_type* words(Entry* e) {
+		return reinterpret_cast<block_type*> (e + 1);
+	}
+
+	void setSize(const std::size_t n);
+
+	Entry* lookup(const std::size_t hash);
+
+	Entry* store(const std::size_t hash, const std::size_t length);
+
+	void rehash();
+};
+
+} // namespace bn
+
+#endif /* EXPERIMENTARENA_HPP_ */
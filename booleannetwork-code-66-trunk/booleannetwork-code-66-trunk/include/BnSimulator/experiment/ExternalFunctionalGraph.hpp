@@ -0,0 +1,477 @@
+/*
+ * ExternalFunctionalGraph.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef EXTERNALFUNCTIONALGRAPH_HPP_
+#define EXTERNALFUNCTIONALGRAPH_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../core/Attractor.hpp"
+#include "../core/BooleanDynamics.hpp"
+#include "../core/network_state.hpp"
+#include "../util/Histogram.hpp"
+#include "../util/MappedArray.hpp"
+
+namespace bn {
+
+/**
+ * Exhaustive analysis of the state space of a network too large for the
+ * arrays of FunctionalGraph to fit in memory, with arrays in memory-mapped
+ * files.
+ *
+ * It gives the same results as FunctionalGraph, attractors included in the
+ * same order, but reads and writes its arrays only in sequential sweeps:
+ * @li the successors of all states are computed in chunks on a pool of
+ * 	threads, as by FunctionalGraph;
+ * @li every random access \f$a[p(x)]\f$ is served by an external sort:
+ * 	pairs \f$(p(x), x)\f$ are written in runs that fit in memory, each
+ * 	sorted by \f$p(x)\f$, the runs are merged, the sorted pairs are joined
+ * 	with @e a in one sweep, and the results are sorted back by @e x;
+ * @li the in-degrees are counted on the successors sorted that way;
+ * @li pointer jumping squares \f$f^{2^r}\f$ until its image stops shrinking,
+ * 	which happens as soon as \f$2^r\f$ reaches the longest transient: that
+ * 	image is the set of the attractor states, which are loaded in memory,
+ * 	and \f$f^{2^r}\f$ maps every state into its attractor;
+ * @li transient lengths are summed by pointer jumping as well, in the same
+ * 	number of rounds.
+ *
+ * A sort of the pairs of the \f$2^n\f$ states sweeps over them once per
+ * merge pass, each of which merges up to @e memory / 256 KiB runs; hence a
+ * round of pointer jumping costs \f$O(2^n \log_M 2^n)\f$ sequential I/O,
+ * where @e M is the size of a run, and the analysis takes about
+ * \f$2 \log_2\f$ of the longest transient rounds, on top of one step per
+ * state. A run is the largest power of two of pairs that takes at most
+ * @e memory bytes.
+ *
+ * Every file is stored in a directory given to the constructor, together with
+ * a progress file which is replaced atomically after each chunk of every
+ * sweep. If the analysis is interrupted, analyze() resumes it from the last
+ * progress saved, provided that the network is the same, which it checks by
+ * hashing the successors of all the states stored so far again: resuming
+ * costs up to one more step per state. A complete analysis, whose
+ * successors are gone, is checked on a sample of SAMPLE_SIZE states instead.
+ *
+ * States and transient lengths take 5 bytes each in the files, and a record
+ * of the sorts 15 bytes. Each phase keeps only the files it needs, which
+ * take at most 49 bytes per state, e.g. about 1.5 TiB at 35 nodes; once the
+ * analysis is complete, only the labels and the transient lengths are kept,
+ * that is 9 bytes per state. The attractor states must fit in memory.
+ */
+class ExternalFunctionalGraph : private boost::noncopyable {
+public:
+	typedef boost::uint64_t index_type;
+
+	/**
+	 * Number of states with each value of a quantity, for the values that
+	 * occur, as for FunctionalGraph.
+	 */
+	typedef util::Histogram::map_type Distribution;
+
+	/**
+	 * Largest network that can be analyzed.
+	 */
+	static const std::size_t MAX_NODES = 40;
+
+	/**
+	 * Default memory for the sorts: 1 GiB.
+	 */
+	static const std::size_t DEFAULT_MEMORY = std::size_t(1) << 30;
+
+	/**
+	 * States whose successors identify the network of a complete analysis.
+	 */
+	static const std::size_t SAMPLE_SIZE = std::size_t(1) << 16;
+
+	explicit ExternalFunctionalGraph(const std::string& directory,
+			const std::size_t memory = DEFAULT_MEMORY);
+
+	/**
+	 * Analyzes the state space of @a dyn, or resumes the analysis stored in
+	 * the directory.
+	 *
+	 * Type parameter @a D is the type of the dynamics, as for FunctionalGraph.
+	 * @param dyn dynamics on State of 1 to MAX_NODES nodes
+	 * @param threads the number of threads that compute the successors, the
+	 * 	calling one included
+	 * @return @e true if the analysis is complete, @e false if a file could
+	 * 	not be written or the attractor states do not fit in memory
+	 */
+	template<class D> bool analyze(D& dyn, const std::size_t threads =
+			boost::thread::hardware_concurrency()) {
+		assert(dyn.size() > 0 && dyn.size() <= MAX_NODES);
+		std::vector<boost::shared_ptr<D> > copies;
+		for (std::size_t i = 1; i < std::max<std::size_t>(1, threads); ++i)
+			copies.push_back(boost::shared_ptr<D>(detail::copy_dynamics(dyn)));
+		// the successors stored so far must be those of dyn
+		bool same = load() && n == dyn.size() && sample(dyn) == sampled;
+		if (same && phase != COMPLETE)
+			same = successors(dyn, copies, 0, phase == SUCCESSORS ? position
+					: numStates(), false) == fingerprint;
+		if (!same) {
+			reset(dyn.size());
+			sampled = sample(dyn);
+		}
+		if (!openArrays() || !save())
+			return false;
+		if (phase == SUCCESSORS) {
+			while (position < numStates()) {
+				fingerprint += successors(dyn, copies, position, position
+						+ window, true);
+				if (!checkpoint(position + window))
+					return false;
+			}
+			position = 0;
+			phase = IN_DEGREES;
+		}
+		return finish();
+	}
+
+	/**
+	 * Returns the number of nodes of the network.
+	 * @return the number of nodes
+	 */
+	std::size_t size() const {
+		return n;
+	}
+
+	/**
+	 * Returns the number of states of the network.
+	 * @return \f$2^n\f$
+	 */
+	boost::uint64_t numStates() const {
+		return boost::uint64_t(1) << n;
+	}
+
+	/**
+	 * Returns the number of attractors.
+	 * @return an attractor count
+	 */
+	std::size_t numAttractors() const {
+		return basins.size();
+	}
+
+	Attractor getAttractor(const std::size_t i) const;
+
+	/**
+	 * Returns the number of states that reach attractor @a i, its own
+	 * included.
+	 * @param i an attractor index
+	 * @return a basin size
+	 */
+	boost::uint64_t getBasinSize(const std::size_t i) const {
+		assert(i < numAttractors());
+		return basins[i];
+	}
+
+	/**
+	 * Returns the attractor reached from a state.
+	 * @param s a state
+	 * @return an attractor index
+	 */
+	std::size_t getAttractorOf(const State& s) const {
+		return labels[index(s)];
+	}
+
+	/**
+	 * Returns the number of steps from a state to its attractor.
+	 * @param s a state
+	 * @return 0 if @a s belongs to its attractor, the transient length
+	 * 	otherwise
+	 */
+	boost::uint64_t getTransient(const State& s) const {
+		return depths[index(s)];
+	}
+
+	/**
+	 * Returns the distribution of the transient lengths.
+	 * @return a map from every length @e d that occurs to the number of
+	 * 	states @e d steps away from their attractor
+	 */
+	const Distribution& getTransients() const {
+		return transients;
+	}
+
+	/**
+	 * Returns the distribution of the in-degrees.
+	 * @return a map from every in-degree @e d that occurs to the number of
+	 * 	states with @e d predecessors
+	 */
+	const Distribution& getInDegrees() const {
+		return inDegrees;
+	}
+
+	/**
+	 * Returns the number of states without a predecessor.
+	 * @return the number of Garden-of-Eden states
+	 */
+	boost::uint64_t getGardenOfEden() const {
+		const Distribution::const_iterator i = inDegrees.find(0);
+		return i == inDegrees.end() ? 0 : i->second;
+	}
+
+private:
+	/**
+	 * Stages of the analysis, in order.
+	 */
+	enum Phase {
+		SUCCESSORS, IN_DEGREES, JUMPS, LABELS, DEPTHS, TRANSIENTS, COMPLETE
+	};
+
+	/**
+	 * Unsigned integer of 40 bits stored in 5 bytes, enough for a state or
+	 * a transient length of up to MAX_NODES nodes.
+	 */
+	class Packed {
+	public:
+		Packed& operator=(const index_type v) {
+			assert(v >> 40 == 0);
+			const boost::uint32_t low = boost::uint32_t(v);
+			std::memcpy(bytes, &low, 4);
+			bytes[4] = static_cast<unsigned char> (v >> 32);
+			return *this;
+		}
+
+		operator index_type() const {
+			boost::uint32_t low;
+			std::memcpy(&low, bytes, 4);
+			return index_type(bytes[4]) << 32 | low;
+		}
+
+	private:
+		unsigned char bytes[5];
+	};
+
+	/**
+	 * Record of the external sorts, without padding: a state, the state
+	 * whose value it needs or gets, and a transient length.
+	 */
+	struct Entry {
+		Packed key, value, depth;
+	};
+
+	std::string directory;
+	std::size_t memory;
+	std::size_t n;
+	/**
+	 * States per chunk, and entries per run of a sort.
+	 */
+	index_type window;
+	/**
+	 * Runs merged at once.
+	 */
+	std::size_t fanIn;
+
+	// progress, saved by checkpoint()
+	Phase phase;
+	/**
+	 * Round of pointer jumping, and sweep within the phase or the round.
+	 */
+	std::size_t round, sweep;
+	/**
+	 * First state or entry of the next chunk.
+	 */
+	index_type position;
+	/**
+	 * Entries per sorted run of entries[current].
+	 */
+	index_type width;
+	/**
+	 * entries[current] holds the entries being worked on.
+	 */
+	std::size_t current;
+	/**
+	 * Size of the image of the current jump, so far and in the previous
+	 * round.
+	 */
+	index_type count, previous;
+	/**
+	 * Rounds of pointer jumping that reach the attractors: \f$f^{2^r}\f$
+	 * maps every state into its attractor, with @e r = rounds.
+	 */
+	std::size_t rounds;
+	/**
+	 * Sum of the hashes of the states whose successors are stored, each
+	 * with its successor, which identifies the network, and the same sum
+	 * over the states of sample().
+	 */
+	boost::uint64_t fingerprint, sampled;
+	Distribution inDegrees, transients;
+	std::vector<boost::uint64_t> basins;
+	/**
+	 * Attractor of every cycle, in order of the smallest cycle state, or
+	 * NONE if not labeled yet.
+	 */
+	std::vector<index_type> order;
+
+	// results and cycles
+	/**
+	 * States of attractor @e i at cycles[offsets[i]] ... cycles[offsets[i +
+	 * 1] - 1], in the order of the dynamics.
+	 */
+	std::vector<index_type> cycles;
+	std::vector<std::size_t> offsets;
+	/**
+	 * Attractor states, in increasing order, and the cycle of each of them.
+	 */
+	std::vector<index_type> cycleStates, cycleOf;
+
+	// arrays
+	/**
+	 * The successor of every state, and the jump of the current round of
+	 * pointer jumping, which is replaced by its square at the end of the
+	 * round.
+	 */
+	util::MappedArray<Packed> successorArray, jumps;
+	/**
+	 * Bit @e x is set if state @e x is in the image of the current jump.
+	 */
+	util::MappedArray<boost::uint64_t> image;
+	util::MappedArray<Packed> depths;
+	util::MappedArray<boost::uint32_t> labels;
+	util::MappedArray<Entry> entries[2];
+
+	/**
+	 * Computes the successors of states @a first ... @a last - 1 on the
+	 * calling thread and on one thread per copy of the dynamics.
+	 * @param store if @e false, the successors are only hashed
+	 * @return the sum of the hashes of the states, each with its successor
+	 */
+	template<class D> boost::uint64_t successors(D& dyn, std::vector<
+			boost::shared_ptr<D> >& copies, const index_type first,
+			const index_type last, const bool store) {
+		const std::size_t t = copies.size() + 1;
+		std::vector<boost::uint64_t> sums(t);
+		boost::thread_group workers;
+		for (std::size_t i = 1; i < t; ++i)
+			workers.create_thread(boost::bind(
+					&ExternalFunctionalGraph::stepRange<D>, this, boost::ref(
+							*copies[i - 1]), first + i * (last - first) / t,
+					first + (i + 1) * (last - first) / t, store, boost::ref(
+							sums[i])));
+		stepRange(dyn, first, first + (last - first) / t, store, sums[0]);
+		workers.join_all();
+		boost::uint64_t res = 0;
+		for (std::size_t i = 0; i < t; ++i)
+			res += sums[i];
+		return res;
+	}
+
+	/**
+	 * Computes the successors of states @a first ... @a last - 1, and
+	 * stores them if @a store is set.
+	 *
+	 * Calls on disjoint ranges write disjoint words, hence they may run
+	 * concurrently on distinct dynamics.
+	 * @param sum set to the sum of the hashes of the states, each with its
+	 * 	successor
+	 */
+	template<class D> void stepRange(D& dyn, const index_type first,
+			const index_type last, const bool store, boost::uint64_t& sum) {
+		State in(n), out(n);
+		State::block_type x;
+		sum = 0;
+		for (index_type i = first; i < last; ++i) {
+			x = i;
+			boost::from_block_range(&x, &x + 1, in);
+			detail::static_step(dyn, in, out);
+			boost::to_block_range(out, &x);
+			if (store)
+				successorArray[i] = x;
+			sum += hash(i, x);
+		}
+	}
+
+	/**
+	 * Computes the successors of SAMPLE_SIZE states spread over the state
+	 * space, or of all of them if there are fewer.
+	 * @return the sum of the hashes of the states, each with its successor
+	 */
+	template<class D> boost::uint64_t sample(D& dyn) const {
+		const index_type size = std::min<index_type>(SAMPLE_SIZE,
+				numStates());
+		State in(n), out(n);
+		State::block_type x;
+		boost::uint64_t sum = 0;
+		for (index_type i = 0; i < size; ++i) {
+			// odd multipliers permute the states
+			x = (i * 0x9e3779b97f4a7c15ULL) & (numStates() - 1);
+			boost::from_block_range(&x, &x + 1, in);
+			detail::static_step(dyn, in, out);
+			const index_type s = x;
+			boost::to_block_range(out, &x);
+			sum += hash(s, x);
+		}
+		return sum;
+	}
+
+	/**
+	 * Hashes a state with its successor.
+	 */
+	boost::uint64_t hash(const index_type s, const index_type next) const {
+		WyMixer mixer;
+		mixer(s);
+		mixer(next);
+		return mixer.result(n);
+	}
+
+	void reset(const std::size_t n);
+
+	bool openArrays();
+
+	bool load();
+
+	bool save() const;
+
+	bool checkpoint(const index_type next);
+
+	bool finish();
+
+	const Packed* power(const std::size_t r) const;
+
+	bool fill(const Packed* src, const Packed* d);
+
+	bool sort();
+
+	bool join(const Packed* src, const Packed* d, const bool mark);
+
+	bool scatter(Packed* dst, Packed* d);
+
+	bool countInDegrees();
+
+	bool jump();
+
+	bool findCycles(std::vector<index_type>& sequences,
+			std::vector<std::size_t>& starts);
+
+	bool label();
+
+	bool sumDepths();
+
+	bool countTransients();
+
+	std::string path(const char name[]) const;
+
+	index_type index(const State& s) const {
+		assert(s.size() == n);
+		return s.to_ulong();
+	}
+};
+
+} // namespace bn
+
+#endif /* EXTERNALFUNCTIONALGRAPH_HPP_ */
@@ -0,0 +1,230 @@
+/*
+ * FunctionalGraph.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef FUNCTIONALGRAPH_HPP_
+#define FUNCTIONALGRAPH_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../core/Attractor.hpp"
+#include "../core/BooleanDynamics.hpp"
+#include "../util/Histogram.hpp"
+
+namespace bn {
+
+/**
+ * Exhaustive analysis of the state space of a small network, seen as the
+ * graph of the map from every state to its successor.
+ *
+ * The constructor computes the successor of each of the \f$2^n\f$ states
+ * once, on a pool of threads, and stores it in an array indexed by the state
+ * itself (bit @e i of the index is node @e i). Every other result is then
+ * found by linear passes over the arrays, without simulating again:
+ * @li the attractors, in order of their smallest basin state, with the size
+ * 	of their basins;
+ * @li the attractor and the transient length of every state;
+ * @li the distribution of the transient lengths;
+ * @li the distribution of the in-degrees, whose count of 0 is the number of
+ * 	Garden-of-Eden states, which have no predecessor.
+ *
+ * Sampling every state with a cycle finder instead follows each trajectory
+ * from scratch, which costs \f$O(2^n)\f$ times the transient length; here
+ * each state is stepped and visited a constant number of times.
+ *
+ * The analysis holds two 32-bit words per state, that is 2 GiB at 28 nodes
+ * and 32 GiB at MAX_NODES, plus the states of the attractors.
+ */
+class FunctionalGraph : private boost::noncopyable {
+public:
+	typedef boost::uint32_t index_type;
+
+	/**
+	 * Number of states with each value of a quantity, for the values that
+	 * occur.
+	 */
+	typedef util::Histogram::map_type Distribution;
+
+	/**
+	 * Largest network that can be analyzed.
+	 */
+	static const std::size_t MAX_NODES = 32;
+
+	/**
+	 * Analyzes the state space of @a dyn.
+	 *
+	 * Type parameter @a D is the type of the dynamics, as for the cycle
+	 * finders; threads other than the calling one step copies of @a dyn (see
+	 * copy_dynamics()), hence CompiledNetwork is the best choice.
+	 * @param dyn dynamics on State of 1 to MAX_NODES nodes
+	 * @param threads the number of threads, the calling one included
+	 */
+	template<class D> explicit FunctionalGraph(D& dyn,
+			const std::size_t threads = boost::thread::hardware_concurrency()) :
+		n(dyn.size()) {
+		assert(n > 0 && n <= MAX_NODES);
+		const boost::uint64_t states = numStates();
+		depth.resize(states);
+		label.resize(states);
+		const std::size_t t = std::max<std::size_t>(1, threads);
+		std::vector<boost::shared_ptr<D> > copies;
+		for (std::size_t i = 1; i < t; ++i)
+			copies.push_back(boost::shared_ptr<D>(detail::copy_dynamics(dyn)));
+		boost::thread_group workers;
+		for (std::size_t i = 1; i < t; ++i)
+			workers.create_thread(boost::bind(&FunctionalGraph::successors<D>,
+					this, boost::ref(*copies[i - 1]), i * states / t, (i + 1)
+							* states / t));
+		successors(dyn, 0, states / t);
+		workers.join_all();
+		analyze();
+	}
+
+	/**
+	 * Returns the number of nodes of the network.
+	 * @return the number of nodes
+	 */
+	std::size_t size() const {
+		return n;
+	}
+
+	/**
+	 * Returns the number of states of the network.
+	 * @return \f$2^n\f$
+	 */
+	boost::uint64_t numStates() const {
+		return boost::uint64_t(1) << n;
+	}
+
+	/**
+	 * Returns the number of attractors.
+	 * @return an attractor count
+	 */
+	std::size_t numAttractors() const {
+		return basins.size();
+	}
+
+	Attractor getAttractor(const std::size_t i) const;
+
+	/**
+	 * Returns the number of states that reach attractor @a i, its own
+	 * included.
+	 * @param i an attractor index
+	 * @return a basin size
+	 */
+	boost::uint64_t getBasinSize(const std::size_t i) const {
+		assert(i < numAttractors());
+		return basins[i];
+	}
+
+	/**
+	 * Returns the attractor reached from a state.
+	 * @param s a state
+	 * @return an attractor index
+	 */
+	std::size_t getAttractorOf(const State& s) const {
+		return label[index(s)] - 1;
+	}
+
+	/**
+	 * Returns the number of steps from a state to its attractor.
+	 * @param s a state
+	 * @return 0 if @a s belongs to its attractor, the transient length
+	 * 	otherwise
+	 */
+	std::size_t getTransient(const State& s) const {
+		return depth[index(s)];
+	}
+
+	/**
+	 * Returns the distribution of the transient lengths.
+	 * @return a map from every length @e d that occurs to the number of
+	 * 	states @e d steps away from their attractor
+	 */
+	const Distribution& getTransients() const {
+		return transients;
+	}
+
+	/**
+	 * Returns the distribution of the in-degrees.
+	 * @return a map from every in-degree @e d that occurs to the number of
+	 * 	states with @e d predecessors
+	 */
+	const Distribution& getInDegrees() const {
+		return inDegrees;
+	}
+
+	/**
+	 * Returns the number of states without a predecessor.
+	 * @return the number of Garden-of-Eden states
+	 */
+	boost::uint64_t getGardenOfEden() const {
+		const Distribution::const_iterator i = inDegrees.find(0);
+		return i == inDegrees.end() ? 0 : i->second;
+	}
+
+private:
+	std::size_t n;
+	/**
+	 * Transient length of every state, which holds its successor until the
+	 * state is labeled by analyze().
+	 */
+	std::vector<index_type> depth;
+	/**
+	 * One plus the attractor of every state, which holds its in-degree
+	 * until analyze() has counted them; an in-degree of \f$2^{32}\f$ wraps
+	 * to 0.
+	 */
+	std::vector<index_type> label;
+	/**
+	 * States of attractor @e i at cycles[offsets[i]] ... cycles[offsets[i +
+	 * 1] - 1], in the order of the dynamics.
+	 */
+	std::vector<index_type> cycles;
+	std::vector<std::size_t> offsets;
+	std::vector<boost::uint64_t> basins;
+	Distribution transients;
+	Distribution inDegrees;
+
+	/**
+	 * Stores the successors of states @a first ... @a last - 1 in depth.
+	 *
+	 * Calls on disjoint ranges write disjoint words, hence they may run
+	 * concurrently on distinct dynamics.
+	 */
+	template<class D> void successors(D& dyn, const boost::uint64_t first,
+			const boost::uint64_t last) {
+		State in(n), out(n);
+		State::block_type x;
+		for (boost::uint64_t i = first; i < last; ++i) {
+			x = i;
+			boost::from_block_range(&x, &x + 1, in);
+			detail::static_step(dyn, in, out);
+			boost::to_block_range(out, &x);
+			depth[i] = index_type(x);
+		}
+	}
+
+	void analyze();
+
+	std::size_t index(const State& s) const {
+		assert(s.size() == n);
+		return s.to_ulong();
+	}
+};
+
+} // namespace bn
+
+#endif /* FUNCTIONALGRAPH_HPP_ */
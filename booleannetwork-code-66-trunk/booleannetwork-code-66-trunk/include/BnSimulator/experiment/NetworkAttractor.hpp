@@ -12,11 +12,10 @@
 #include <climits>
 
 #include "../core/network_state.hpp"
+#include "../core/Attractor_fwd.hpp"
 
 namespace bn {
 
-class Attractor;
-
 class BooleanDynamics;
 
 class NetworkAttractor {
@@ -9,6 +9,7 @@
 #define TRAJECTORYRANGE_HPP_
 
 #include <cstddef>
+#include <algorithm>
 
 #include <boost/iterator/iterator_categories.hpp>
 #include <boost/iterator/iterator_facade.hpp>
@@ -21,27 +22,38 @@ namespace bn {
 
 namespace detail {
 
-struct TrajectoryIterator : boost::iterator_facade<TrajectoryIterator,
-		const State, boost::single_pass_traversal_tag> {
+/**
+ * Iterator over the states of a trajectory of dynamics of type @a D, whose
+ * step() is called without virtual dispatch when is_leaf_dynamics<D> holds.
+ */
+template<class S, class D = BasicBooleanDynamics<S> >
+struct TrajectoryIterator : boost::iterator_facade<TrajectoryIterator<S, D> ,
+		const S, boost::single_pass_traversal_tag> {
 public:
 	// end
-	TrajectoryIterator(BooleanDynamics& dyn, const std::size_t n) :
+	TrajectoryIterator(D& dyn, const std::size_t n) :
 		dyn(dyn), n(n) {
 	}
 
 	// begin
-	TrajectoryIterator(BooleanDynamics& dyn, const State& s) :
-		dyn(dyn), s(s), n(0) {
+	TrajectoryIterator(D& dyn, const S& s) :
+		dyn(dyn), s(s), next(s), n(0) {
 	}
 
 private:
+	typedef boost::iterator_facade<TrajectoryIterator<S, D> , const S,
+			boost::single_pass_traversal_tag> base;
 	friend class boost::iterator_core_access;
 
-	BooleanDynamics& dyn;
-	State s;
+	D& dyn;
+	S s;
+	/**
+	 * Buffer for the successor of s, swapped with it on increment.
+	 */
+	S next;
 	std::size_t n;
 
-	reference dereference() const {
+	typename base::reference dereference() const {
 		return s;
 	}
 
@@ -50,29 +62,43 @@ private:
 	}
 
 	void increment() {
-		dyn.update(s);
+		using std::swap;
+		static_step(dyn, s, next);
+		swap(s, next);
 		++n;
 	}
 };
 
-TrajectoryIterator operator++(TrajectoryIterator& it, int) {
-	TrajectoryIterator tmp(it);
+template<class S, class D> TrajectoryIterator<S, D> operator++(
+		TrajectoryIterator<S, D>& it, int) {
+	TrajectoryIterator<S, D> tmp(it);
 	++it;
 	return tmp;
 }
 
 } // namespace detail
 
-struct TrajectoryRange : boost::iterator_range<detail::TrajectoryIterator> {
+/**
+ * The first @e n states of the trajectory of a network from a given state.
+ *
+ * Type parameter @a S is the state type; TrajectoryRange is the
+ * instantiation for State. Type parameter @a D is the type of the dynamics,
+ * by default the virtual interface.
+ */
+template<class S, class D = BasicBooleanDynamics<S> >
+struct BasicTrajectoryRange : boost::iterator_range<detail::TrajectoryIterator<
+		S, D> > {
 private:
-	typedef boost::iterator_range<detail::TrajectoryIterator> base;
+	typedef boost::iterator_range<detail::TrajectoryIterator<S, D> > base;
 
 public:
-	TrajectoryRange(BooleanDynamics& dyn, const State& s, const std::size_t n) :
-		base(iterator(dyn, s), iterator(dyn, n)) {
+	BasicTrajectoryRange(D& dyn, const S& s, const std::size_t n) :
+		base(typename base::iterator(dyn, s), typename base::iterator(dyn, n)) {
 	}
 };
 
+typedef BasicTrajectoryRange<State> TrajectoryRange;
+
 } // namespace bn
 
 #endif /* TRAJECTORYRANGE_HPP_ */
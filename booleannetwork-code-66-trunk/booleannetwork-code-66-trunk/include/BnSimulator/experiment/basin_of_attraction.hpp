@@ -8,13 +8,67 @@
 #ifndef BASIN_OF_ATTRACTION_HPP_
 #define BASIN_OF_ATTRACTION_HPP_
 
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
 #include "../util/Counter.hpp"
 #include "cycle_finder.hpp"
+#include "ExperimentArena.hpp"
 
 namespace bn {
 
-template<class StateRange, class Strategy> util::Counter<State> basin_of_attraction(const StateRange& r, const Strategy& s){
-	return util::Counter<State>(r | s);
+namespace detail {
+
+template<class AttractorRange> void insert_attractors(ExperimentArena& arena,
+		const AttractorRange& r) {
+	for (typename boost::range_iterator<const AttractorRange>::type it =
+			boost::begin(r); it != boost::end(r); ++it)
+		arena.insert(*it);
+}
+
+} // namespace detail
+
+template<class StateRange, class Strategy> util::Counter<Attractor> basin_of_attraction(const StateRange& r, const Strategy& s){
+	return util::Counter<Attractor>(r | s);
+}
+
+/**
+ * Counts the attractors reached from a range of states in an
+ * ExperimentArena, which owns them until it is released.
+ * @param r a range of initial states
+ * @param s a cycle finder
+ * @param arena the arena of the experiment
+ * @return @a arena
+ */
+template<class StateRange, class Strategy> ExperimentArena& basin_of_attraction(
+		const StateRange& r, const Strategy& s, ExperimentArena& arena) {
+	detail::insert_attractors(arena, r | s);
+	return arena;
+}
+
+/**
+ * Counts the attractors reached from a range of states in an
+ * ExperimentArena with Brent's cycle finder, whose trajectories are followed
+ * in the scratch states of the arena: no Attractor object is built.
+ */
+template<class StateRange, class Terminator, class D>
+ExperimentArena& basin_of_attraction(const StateRange& r,
+		const detail::CycleFinder<detail::BrentStrategy, Terminator, State,
+				D>& s, ExperimentArena& arena) {
+	for (typename boost::range_iterator<const StateRange>::type it =
+			boost::begin(r); it != boost::end(r); ++it)
+		arena.find(s.dyn, *it, s.t);
+	return arena;
+}
+
+template<class StateRange, class D> ExperimentArena& basin_of_attraction(
+		const StateRange& r, const detail::CycleFinder<detail::BrentStrategy,
+				boost::mpl::void_, State, D>& s, ExperimentArena& arena) {
+	for (typename boost::range_iterator<const StateRange>::type it =
+			boost::begin(r); it != boost::end(r); ++it)
+		arena.find(s.dyn, *it);
+	return arena;
 }
 
 } // namespace bn
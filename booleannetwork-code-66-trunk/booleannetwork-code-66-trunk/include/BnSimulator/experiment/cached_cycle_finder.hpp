@@ -0,0 +1,156 @@
+/*
+ * cached_cycle_finder.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef CACHED_CYCLE_FINDER_HPP_
+#define CACHED_CYCLE_FINDER_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+
+#include "../core/Attractor.hpp"
+#include "../core/BooleanDynamics.hpp"
+#include "AttractorCache.hpp"
+#include "TrajectoryRange.hpp"
+#include "cycle_finder.hpp"
+
+namespace bn {
+
+namespace detail {
+
+/**
+ * Cycle finder that runs Brent's algorithm until the trajectory reaches a
+ * state of an AttractorCache, then stores the attractor of the states it
+ * went through.
+ *
+ * It gives the same attractors as brent(). At most AttractorCache::capacity()
+ * states of a trajectory are stored, the first ones; those of an attractor
+ * found by Brent's algorithm are among them unless the trajectory is longer.
+ * Scratch states and keys belong to each copy, hence copies made by bind()
+ * may run concurrently on the same cache.
+ */
+template<class Terminator, class D> struct CachedCycleFinder {
+	typedef Attractor result_type;
+	typedef D dynamics_type;
+	typedef AttractorCache::block_type block_type;
+	D& dyn;
+	AttractorCache& cache;
+	Terminator t;
+	CachedCycleFinder(D& dyn, AttractorCache& cache, const Terminator& t) :
+		dyn(dyn), cache(cache), t(t) {
+	}
+	CachedCycleFinder(const CachedCycleFinder& other) :
+		dyn(other.dyn), cache(other.cache), t(other.t) {
+	}
+	/**
+	 * Returns a copy of this cycle finder that runs on @a other.
+	 */
+	CachedCycleFinder bind(D& other) const {
+		return CachedCycleFinder(other, cache, t);
+	}
+	result_type operator()(const State& s) const {
+		using std::swap;
+		std::size_t id;
+		path.clear();
+		hare = s;
+		if (visit(hare, id))
+			return cache.getAttractor(id);
+		std::size_t power = 1, lambda = 1;
+		tortoise = hare;
+		next = hare;
+		detail::static_step(dyn, tortoise, hare);
+		for (std::size_t iter = 0; tortoise != hare; ++iter) {
+			if (t(iter))
+				return result_type();
+			if (visit(hare, id)) {
+				store(id);
+				return cache.getAttractor(id);
+			}
+			if (power == lambda) {
+				tortoise = hare;
+				power *= 2;
+				lambda = 0;
+			}
+			detail::static_step(dyn, hare, next);
+			swap(hare, next);
+			++lambda;
+		}
+		// every state of the cycle was visited since the tortoise
+		const result_type a(BasicTrajectoryRange<State, D> (dyn, hare, lambda));
+		store(cache.intern(a));
+		return a;
+	}
+
+private:
+	mutable State tortoise, hare, next;
+	/**
+	 * Keys of the states visited so far, followed by the one being looked up.
+	 */
+	mutable std::vector<block_type> path;
+
+	/**
+	 * Looks up a state, which is appended to the path unless it is cached
+	 * or the path is full.
+	 */
+	bool visit(const State& s, std::size_t& id) const {
+		const std::size_t b = cache.blocks(), end = path.size();
+		path.resize(end + b);
+		boost::to_block_range(s, path.begin() + end);
+		const bool found = cache.find(&path[end], id);
+		if (found || end / b >= cache.capacity())
+			path.resize(end);
+		return found;
+	}
+
+	void store(const std::size_t id) const {
+		for (std::size_t i = 0; i < path.size(); i += cache.blocks())
+			cache.insert(&path[i], id);
+	}
+
+	CachedCycleFinder& operator=(const CachedCycleFinder&);
+};
+
+} // namespace detail
+
+/**
+ * Returns a cycle finder that stops as soon as a trajectory reaches a state
+ * whose attractor is in @a cache, which is the execution mode meant for
+ * sampling basins whose trajectories merge into the same transients.
+ *
+ * It may be passed to parallel() as well, whose threads then share the
+ * cache.
+ * @param dyn the dynamics, on states of cache.size() nodes
+ * @param cache the cache
+ */
+template<class D> detail::CachedCycleFinder<cycle_finder::NeverGiveUp, D>
+cached(D& dyn, AttractorCache& cache) {
+	return detail::CachedCycleFinder<cycle_finder::NeverGiveUp, D>(dyn,
+			cache, cycle_finder::NeverGiveUp());
+}
+
+/**
+ * Returns a cycle finder that stops as soon as a trajectory reaches a state
+ * whose attractor is in @a cache, or when the terminator gives up.
+ * @param dyn the dynamics, on states of cache.size() nodes
+ * @param cache the cache
+ * @param t a terminator with the meaning of cycle_finder::brent()
+ */
+template<class D, class Terminator> detail::CachedCycleFinder<Terminator, D> cached(
+		D& dyn, AttractorCache& cache, const Terminator& t) {
+	return detail::CachedCycleFinder<Terminator, D>(dyn, cache, t);
+}
+
+template<class SinglePassRange, class Terminator, class D> detail::AttractorRange<
+		SinglePassRange, detail::CachedCycleFinder<Terminator, D> > operator|(
+		const SinglePassRange& rng,
+		const detail::CachedCycleFinder<Terminator, D>& f) {
+	return find_attractors(rng, f);
+}
+
+} // namespace bn
+
+#endif /* CACHED_CYCLE_FINDER_HPP_ */
@@ -9,9 +9,12 @@
 #define CYCLE_FINDER_HPP_
 
 #include <cstddef>
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include <boost/iterator/iterator_facade.hpp>
+#include <boost/mem_fn.hpp>
 #include <boost/range/adaptor/argument_fwd.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/adaptor/filtered.hpp>
@@ -19,13 +22,15 @@
 
 #include "cycle_finder/naive.hpp"
 #include "cycle_finder/brent.hpp"
+#include "cycle_finder/nivasch.hpp"
+#include "cycle_finder/interleaved.hpp"
 
 namespace bn {
 
 namespace detail {
 
 template<class It, class Strategy> struct AttractorIterator : boost::iterator_facade<
-		AttractorIterator<It, Strategy> , const Attractor,
+		AttractorIterator<It, Strategy> , const typename Strategy::result_type,
 		boost::single_pass_traversal_tag> {
 public:
 	// begin
@@ -41,14 +46,15 @@ public:
 
 private:
 	typedef boost::iterator_facade<AttractorIterator<It, Strategy> ,
-			const Attractor, boost::forward_traversal_tag> base;
+			const typename Strategy::result_type,
+			boost::forward_traversal_tag> base;
 	friend class boost::iterator_core_access;
 	It it, end;
 	Strategy s;
-	Attractor current;
+	typename Strategy::result_type current;
 
 	void ensureInvariant() {
-		while (it != end && (current = s(*it)) == EMPTY_ATTRACTOR)
+		while (it != end && (current = s(*it)).empty())
 			++it;
 	}
 
@@ -74,11 +80,11 @@ template<class It, class Strategy> AttractorIterator<It, Strategy> operator++(
 }
 
 template<class StateRange, class Strategy> struct AttractorRange : boost::iterator_range<
-		AttractorIterator<typename boost::range_iterator<StateRange>::type,
+		AttractorIterator<typename boost::range_iterator<const StateRange>::type,
 				Strategy> > {
 private:
 	typedef boost::iterator_range<AttractorIterator<
-			typename boost::range_iterator<StateRange>::type, Strategy> > base;
+			typename boost::range_iterator<const StateRange>::type, Strategy> > base;
 
 public:
 	AttractorRange(const StateRange& r, const Strategy& s) :
@@ -87,51 +93,124 @@ public:
 	}
 };
 
-template<class Strategy, class Terminator> struct CycleFinder {
-	typedef Attractor result_type;
-	BooleanDynamics& dyn;
+/**
+ * Function object that maps an initial state to the attractor it reaches.
+ *
+ * Initial states of a different type than @a S (for instance the State
+ * objects produced by generators when the dynamics works on FixedState) are
+ * converted first. Type parameter @a D is the type of the dynamics, which
+ * the functions naive() and brent() take from their argument, so that the
+ * steps of a network class are not virtual calls (see is_leaf_dynamics).
+ */
+template<class Strategy, class Terminator, class S = State,
+		class D = BasicBooleanDynamics<S> > struct CycleFinder {
+	typedef BasicAttractor<S> result_type;
+	typedef D dynamics_type;
+	D& dyn;
 	Terminator t;
-	CycleFinder(BooleanDynamics& dyn, const Terminator& t) :
+	CycleFinder(D& dyn, const Terminator& t) :
 		dyn(dyn), t(t) {
 	}
-	result_type operator()(const State& s) const {
-		return Strategy::call(dyn, s, t);
+	/**
+	 * Returns a copy of this cycle finder that runs on @a other.
+	 */
+	CycleFinder bind(D& other) const {
+		return CycleFinder(other, t);
+	}
+	template<class T> result_type operator()(const T& s) const {
+		return Strategy::call(dyn, S(s), t);
 	}
 };
 
-template<class Strategy> struct CycleFinder<Strategy, boost::mpl::void_> {
-	typedef Attractor result_type;
-	BooleanDynamics& dyn;
-	CycleFinder(BooleanDynamics& dyn) :
+template<class Strategy, class S, class D> struct CycleFinder<Strategy,
+		boost::mpl::void_, S, D> {
+	typedef BasicAttractor<S> result_type;
+	typedef D dynamics_type;
+	D& dyn;
+	CycleFinder(D& dyn) :
 		dyn(dyn) {
 	}
-	result_type operator()(const State& s) const {
-		return Strategy::call(dyn, s);
+	CycleFinder bind(D& other) const {
+		return CycleFinder(other);
+	}
+	template<class T> result_type operator()(const T& s) const {
+		return Strategy::call(dyn, S(s));
 	}
 };
 
 struct NaiveStrategy {
-	template<class Terminator> static Attractor call(BooleanDynamics& dyn,
-			const State& s, const Terminator& t) {
+	template<class D, class Terminator> static BasicAttractor<
+			typename D::state_type> call(D& dyn,
+			const typename D::state_type& s, const Terminator& t) {
 		return cycle_finder::naive(dyn, s, t);
 	}
 
-	static Attractor call(BooleanDynamics& dyn, const State& s) {
+	template<class D> static BasicAttractor<typename D::state_type> call(
+			D& dyn, const typename D::state_type& s) {
 		return cycle_finder::naive(dyn, s);
 	}
 };
 
 struct BrentStrategy {
-	template<class Terminator> static Attractor call(BooleanDynamics& dyn,
-			const State& s, const Terminator& t) {
+	template<class D, class Terminator> static BasicAttractor<
+			typename D::state_type> call(D& dyn,
+			const typename D::state_type& s, const Terminator& t) {
 		return cycle_finder::brent(dyn, s, t);
 	}
 
-	static Attractor call(BooleanDynamics& dyn, const State& s) {
+	template<class D> static BasicAttractor<typename D::state_type> call(
+			D& dyn, const typename D::state_type& s) {
 		return cycle_finder::brent(dyn, s);
 	}
 };
 
+/**
+ * Strategy of Nivasch's stack algorithm with @a Stacks stacks (see
+ * cycle_finder::nivasch()).
+ */
+template<std::size_t Stacks> struct NivaschStrategy {
+	template<class D, class Terminator> static BasicAttractor<
+			typename D::state_type> call(D& dyn,
+			const typename D::state_type& s, const Terminator& t) {
+		return cycle_finder::nivasch<Stacks>(dyn, s, t);
+	}
+
+	template<class D> static BasicAttractor<typename D::state_type> call(
+			D& dyn, const typename D::state_type& s) {
+		return cycle_finder::nivasch<Stacks>(dyn, s);
+	}
+};
+
+/**
+ * Cycle finder that runs Brent's algorithm on groups of trajectories of an
+ * InterleavedNetwork (see cycle_finder::interleaved_brent()).
+ *
+ * Piping a range of initial states into it runs the whole range at once and
+ * gives a vector of the attractors found; calling it on a single state runs
+ * one trajectory.
+ */
+template<class Terminator> struct InterleavedCycleFinder {
+	typedef Attractor result_type;
+	InterleavedNetwork& net;
+	std::size_t lanes;
+	Terminator t;
+	InterleavedCycleFinder(InterleavedNetwork& net, const std::size_t lanes,
+			const Terminator& t) :
+		net(net), lanes(lanes), t(t) {
+	}
+	result_type operator()(const State& s) const {
+		return cycle_finder::interleaved_brent(net, &s, &s + 1, 1, t).front();
+	}
+	template<class SinglePassRange> std::vector<Attractor> findAttractors(
+			const SinglePassRange& r) const {
+		std::vector<Attractor> found = cycle_finder::interleaved_brent(net,
+				boost::begin(r), boost::end(r), lanes, t);
+		found.erase(std::remove_if(found.begin(), found.end(),
+				boost::mem_fn(&Attractor::empty)), found.end());
+		return found;
+	}
+};
+
 } // namespace detail
 
 template<class SR, class S> detail::AttractorRange<SR, S> find_attractors(
@@ -150,47 +229,119 @@ struct MaxIter {
 };
 
 struct NotNone {
-	bool operator()(const Attractor& a) const {
-		return a != EMPTY_ATTRACTOR;
+	template<class S> bool operator()(const BasicAttractor<S>& a) const {
+		return !a.empty();
 	}
 };
 
 typedef detail::CycleFinder<detail::NaiveStrategy, boost::mpl::void_>
 		NaiveCycleFinder;
 
-NaiveCycleFinder naive(BooleanDynamics& dyn) {
-	return NaiveCycleFinder(dyn);
+template<class D> detail::CycleFinder<detail::NaiveStrategy,
+		boost::mpl::void_, typename D::state_type, D> naive(D& dyn) {
+	return detail::CycleFinder<detail::NaiveStrategy, boost::mpl::void_,
+			typename D::state_type, D>(dyn);
+}
+
+template<class D, class Terminator> detail::CycleFinder<detail::NaiveStrategy,
+		Terminator, typename D::state_type, D> naive(D& dyn,
+		const Terminator& t) {
+	return detail::CycleFinder<detail::NaiveStrategy, Terminator,
+			typename D::state_type, D>(dyn, t);
+}
+
+template<class D> detail::CycleFinder<detail::BrentStrategy,
+		boost::mpl::void_, typename D::state_type, D> brent(D& dyn) {
+	return detail::CycleFinder<detail::BrentStrategy, boost::mpl::void_,
+			typename D::state_type, D>(dyn);
+}
+
+template<class D, class Terminator> detail::CycleFinder<detail::BrentStrategy,
+		Terminator, typename D::state_type, D> brent(D& dyn,
+		const Terminator& t) {
+	return detail::CycleFinder<detail::BrentStrategy, Terminator,
+			typename D::state_type, D>(dyn, t);
+}
+
+/**
+ * Returns a cycle finder that runs Nivasch's stack algorithm, which stops
+ * earlier than Brent's on long cycles (see cycle_finder::nivasch()).
+ * @param dyn the dynamics
+ */
+template<class D> detail::CycleFinder<detail::NivaschStrategy<1>,
+		boost::mpl::void_, typename D::state_type, D> nivasch(D& dyn) {
+	return detail::CycleFinder<detail::NivaschStrategy<1>, boost::mpl::void_,
+			typename D::state_type, D>(dyn);
+}
+
+/**
+ * Returns a cycle finder that runs Nivasch's stack algorithm with the states
+ * partitioned among @a Stacks stacks, e.g. nivasch<4>(net).
+ * @param dyn the dynamics
+ */
+template<std::size_t Stacks, class D> detail::CycleFinder<
+		detail::NivaschStrategy<Stacks>, boost::mpl::void_,
+		typename D::state_type, D> nivasch(D& dyn) {
+	return detail::CycleFinder<detail::NivaschStrategy<Stacks>,
+			boost::mpl::void_, typename D::state_type, D>(dyn);
+}
+
+template<class D, class Terminator> detail::CycleFinder<
+		detail::NivaschStrategy<1>, Terminator, typename D::state_type, D> nivasch(
+		D& dyn, const Terminator& t) {
+	return detail::CycleFinder<detail::NivaschStrategy<1>, Terminator,
+			typename D::state_type, D>(dyn, t);
 }
 
-template<class Terminator> detail::CycleFinder<detail::NaiveStrategy,
-		Terminator> naive(BooleanDynamics& dyn, const Terminator& t) {
-	return detail::CycleFinder<detail::NaiveStrategy, Terminator>(dyn, t);
+template<std::size_t Stacks, class D, class Terminator> detail::CycleFinder<
+		detail::NivaschStrategy<Stacks>, Terminator, typename D::state_type, D> nivasch(
+		D& dyn, const Terminator& t) {
+	return detail::CycleFinder<detail::NivaschStrategy<Stacks>, Terminator,
+			typename D::state_type, D>(dyn, t);
 }
 
-detail::CycleFinder<detail::BrentStrategy, boost::mpl::void_> brent(
-		BooleanDynamics& dyn) {
-	return detail::CycleFinder<detail::BrentStrategy, boost::mpl::void_>(dyn);
+/**
+ * Returns an interleaved cycle finder, which is the execution mode that
+ * hides memory latency on networks too large for cache.
+ * @param net the dynamics
+ * @param lanes the number of trajectories advanced together
+ * @param t a terminator with the meaning of cycle_finder::brent(), such as
+ * 	cycle_finder::NeverGiveUp
+ */
+template<class Terminator> detail::InterleavedCycleFinder<Terminator> interleaved(
+		InterleavedNetwork& net, const std::size_t lanes, const Terminator& t) {
+	return detail::InterleavedCycleFinder<Terminator>(net, lanes, t);
 }
 
-template<class Terminator> detail::CycleFinder<detail::BrentStrategy,
-		Terminator> brent(BooleanDynamics& dyn, const Terminator& t) {
-	return detail::CycleFinder<detail::BrentStrategy, Terminator>(dyn, t);
+inline detail::InterleavedCycleFinder<cycle_finder::NeverGiveUp> interleaved(
+		InterleavedNetwork& net, const std::size_t lanes) {
+	return interleaved(net, lanes, cycle_finder::NeverGiveUp());
 }
 
-template<class SinglePassRange, class Strategy, class Terminator>
-detail::AttractorRange<SinglePassRange, Strategy> operator|(
-		SinglePassRange& rng,
-		const detail::CycleFinder<Strategy, Terminator>& f) {
+template<class SinglePassRange, class Strategy, class Terminator, class S,
+		class D> detail::AttractorRange<SinglePassRange, detail::CycleFinder<
+		Strategy, Terminator, S, D> > operator|(SinglePassRange& rng,
+		const detail::CycleFinder<Strategy, Terminator, S, D>& f) {
 	return find_attractors(rng, f);
 }
 
-template<class SinglePassRange, class Strategy, class Terminator>
-detail::AttractorRange<SinglePassRange, Strategy> operator|(
-		const SinglePassRange& rng,
-		const detail::CycleFinder<Strategy, Terminator>& f) {
+template<class SinglePassRange, class Strategy, class Terminator, class S,
+		class D> detail::AttractorRange<SinglePassRange, detail::CycleFinder<
+		Strategy, Terminator, S, D> > operator|(const SinglePassRange& rng,
+		const detail::CycleFinder<Strategy, Terminator, S, D>& f) {
 	return find_attractors(rng, f);
 }
 
+/**
+ * Finds the attractors reached from a range of states with an interleaved
+ * cycle finder, skipping the trajectories that gave up.
+ */
+template<class SinglePassRange, class Terminator> std::vector<Attractor> operator|(
+		const SinglePassRange& rng,
+		const detail::InterleavedCycleFinder<Terminator>& f) {
+	return f.findAttractors(rng);
+}
+
 } // namespace bn
 
 #endif /* CYCLE_FINDER_HPP_ */
@@ -9,6 +9,7 @@
 #define BRENT_HPP_
 
 #include <cstddef>
+#include <algorithm>
 
 #include "../../core/BooleanDynamics.hpp"
 #include "../../core/Attractor.hpp"
@@ -18,26 +19,80 @@ namespace bn {
 
 namespace cycle_finder {
 
-Attractor brent(BooleanDynamics& dyn, State s);
+/**
+ * Terminator that never gives up, with the meaning of brent().
+ */
+struct NeverGiveUp {
+	bool operator()(const std::size_t) const {
+		return false;
+	}
+};
+
+/**
+ * Finds the attractor reached from a state with Brent's algorithm.
+ *
+ * Type parameter @a D is the type of the dynamics: passing a network class
+ * rather than a reference to BasicBooleanDynamics lets the steps be called
+ * without virtual dispatch (see is_leaf_dynamics), which matters on small
+ * networks, whose steps cost about as much as a call.
+ * @param dyn the dynamics
+ * @param s an initial state
+ * @return the attractor
+ */
+template<class D> BasicAttractor<typename D::state_type> brent(D& dyn,
+		typename D::state_type s) {
+	typedef typename D::state_type S;
+	using std::swap;
+	std::size_t power = 1, lambda = 1;
+	S tortoise = s;
+	S next(s);
+	bn::detail::static_step(dyn, tortoise, s);
+	while (tortoise != s) {
+		if (power == lambda) {
+			tortoise = s;
+			power *= 2;
+			lambda = 0;
+		}
+		bn::detail::static_step(dyn, s, next);
+		swap(s, next);
+		++lambda;
+	}
+	// now state s is inside a cycle
+	return BasicAttractor<S> (BasicTrajectoryRange<S, D> (dyn, s, lambda));
+}
 
-template<class Terminator> Attractor brent(BooleanDynamics& dyn, State s,
+/**
+ * Finds the attractor reached from a state with Brent's algorithm, unless
+ * the terminator gives up first.
+ * @param dyn the dynamics
+ * @param s an initial state
+ * @param term called with the number of steps so far; the search gives up
+ * 	when it returns @e true
+ * @return the attractor, or the empty attractor if the search gave up
+ */
+template<class D, class Terminator>
+BasicAttractor<typename D::state_type> brent(D& dyn, typename D::state_type s,
 		Terminator term) {
+	typedef typename D::state_type S;
+	using std::swap;
 	std::size_t power = 1, lambda = 1;
-	State tortoise = s;
-	dyn.update(s);
+	S tortoise = s;
+	S next(s);
+	bn::detail::static_step(dyn, tortoise, s);
 	for (size_t iter = 0; tortoise != s; ++iter) {
 		if (term(iter))
-			return EMPTY_ATTRACTOR;
+			return BasicAttractor<S> ();
 		if (power == lambda) {
 			tortoise = s;
 			power *= 2;
 			lambda = 0;
 		}
-		dyn.update(s);
+		bn::detail::static_step(dyn, s, next);
+		swap(s, next);
 		++lambda;
 	}
 	// now state s is inside a cycle
-	return Attractor(TrajectoryRange(dyn, s, lambda));
+	return BasicAttractor<S> (BasicTrajectoryRange<S, D> (dyn, s, lambda));
 }
 
 } // namespace cycle_finder
@@ -0,0 +1,115 @@
+/*
+ * interleaved.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef INTERLEAVED_HPP_
+#define INTERLEAVED_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+
+#include "../../core/Attractor.hpp"
+#include "../../core/InterleavedNetwork.hpp"
+#include "../TrajectoryRange.hpp"
+#include "brent.hpp"
+
+namespace bn {
+
+namespace cycle_finder {
+
+namespace detail {
+
+/**
+ * Progress of Brent's algorithm on one lane.
+ */
+struct BrentLane {
+	State tortoise;
+	std::size_t power, lambda, iter;
+	/**
+	 * Position of the initial state of the lane in the input sequence.
+	 */
+	std::size_t index;
+
+	BrentLane(const State& s, const std::size_t index) :
+		tortoise(s), power(1), lambda(0), iter(0), index(index) {
+	}
+};
+
+} // namespace detail
+
+/**
+ * Runs Brent's cycle finder from every state of a sequence, advancing up to
+ * @a lanes trajectories together with InterleavedNetwork::step(). As soon as
+ * a trajectory reaches its attractor, or gives up, its lane is given the next
+ * initial state, so that the group stays full until the sequence ends.
+ *
+ * The terminator has the same meaning as in brent(): a trajectory gives up
+ * when @a t returns @e true on the number of steps taken after the first one.
+ * @param net the dynamics
+ * @param first the first initial state
+ * @param last the end of the initial states
+ * @param lanes the number of trajectories advanced together
+ * @param t the terminator
+ * @return the attractor reached from each initial state, in order, or the
+ * 	empty attractor if the trajectory gave up
+ */
+template<class InputIterator, class Terminator> std::vector<Attractor> interleaved_brent(
+		InterleavedNetwork& net, InputIterator first, const InputIterator last,
+		const std::size_t lanes, Terminator t) {
+	using std::swap;
+	assert(lanes > 0);
+	std::vector<Attractor> result;
+	std::vector<State> current, next;
+	std::vector<detail::BrentLane> progress;
+	for (;;) {
+		for (; current.size() < lanes && first != last; ++first) {
+			current.push_back(State(*first));
+			progress.push_back(detail::BrentLane(current.back(), result.size()));
+			result.push_back(Attractor());
+		}
+		if (current.empty())
+			return result;
+		net.step(current, next);
+		current.swap(next);
+		for (std::size_t l = 0; l < current.size();) {
+			detail::BrentLane& p = progress[l];
+			++p.lambda;
+			bool done = true;
+			if (p.tortoise == current[l])
+				result[p.index] = Attractor(BasicTrajectoryRange<State> (net,
+						current[l], p.lambda));
+			else if (!t(p.iter++)) {
+				done = false;
+				if (p.power == p.lambda) {
+					p.tortoise = current[l];
+					p.power *= 2;
+					p.lambda = 0;
+				}
+			}
+			if (done) {
+				swap(current[l], current.back());
+				current.pop_back();
+				swap(progress[l], progress.back());
+				progress.pop_back();
+			} else
+				++l;
+		}
+	}
+}
+
+template<class InputIterator> std::vector<Attractor> interleaved_brent(
+		InterleavedNetwork& net, const InputIterator first,
+		const InputIterator last, const std::size_t lanes) {
+	return interleaved_brent(net, first, last, lanes, NeverGiveUp());
+}
+
+} // namespace cycle_finder
+
+} // namespace bn
+
+#endif /* INTERLEAVED_HPP_ */
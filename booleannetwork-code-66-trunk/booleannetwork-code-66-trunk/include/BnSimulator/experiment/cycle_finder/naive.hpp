@@ -22,23 +22,54 @@ namespace bn {
 
 namespace cycle_finder {
 
-typedef boost::multi_index::multi_index_container<State,
-		boost::multi_index::indexed_by<boost::multi_index::sequenced<>,
-				boost::multi_index::hashed_unique<boost::multi_index::identity<
-						State>, BitsetHasher> > > StateSet;
+/**
+ * Insertion-ordered set of states with constant-time lookup, hashed by
+ * @a Hasher.
+ */
+template<class S, class Hasher = BitsetHasher> struct BasicStateSet {
+	typedef boost::multi_index::multi_index_container<S,
+			boost::multi_index::indexed_by<boost::multi_index::sequenced<>,
+					boost::multi_index::hashed_unique<
+							boost::multi_index::identity<S>, Hasher> > > type;
+};
+
+typedef BasicStateSet<State>::type StateSet;
 
-Attractor naive(BooleanDynamics& net, State s);
+/**
+ * Finds the attractor reached from a state by storing every state of the
+ * trajectory. Like brent(), it is templated on the type of the dynamics.
+ */
+template<class D> BasicAttractor<typename D::state_type> naive(D& net,
+		typename D::state_type s) {
+	typedef typename D::state_type S;
+	using std::swap;
+	typedef typename BasicStateSet<S>::type Set;
+	Set stateSet;
+	S next(s);
+	for (; true; bn::detail::static_step(net, s, next), swap(s, next)) {
+		const std::pair<typename Set::const_iterator, bool> p =
+				stateSet.push_back(s);
+		if (!p.second)
+			return BasicAttractor<S> (std::make_pair(p.first, stateSet.end()));
+	}
+}
 
-template<class Terminator> Attractor naive(BooleanDynamics& net, State s,
+template<class D, class Terminator>
+BasicAttractor<typename D::state_type> naive(D& net, typename D::state_type s,
 		Terminator t) {
-	StateSet stateSet;
-	for (size_t iter = 0; t(iter); net.update(s), ++iter) {
-		const std::pair<StateSet::const_iterator, bool> p = stateSet.push_back(
-				s);
+	typedef typename D::state_type S;
+	using std::swap;
+	typedef typename BasicStateSet<S>::type Set;
+	Set stateSet;
+	S next(s);
+	for (size_t iter = 0; t(iter); bn::detail::static_step(net, s, next), swap(
+			s, next), ++iter) {
+		const std::pair<typename Set::const_iterator, bool> p =
+				stateSet.push_back(s);
 		if (!p.second)
-			return Attractor(std::make_pair(p.first, stateSet.end()));
+			return BasicAttractor<S> (std::make_pair(p.first, stateSet.end()));
 	}
-	return EMPTY_ATTRACTOR;
+	return BasicAttractor<S> ();
 }
 
 } // namespace cycle_finder
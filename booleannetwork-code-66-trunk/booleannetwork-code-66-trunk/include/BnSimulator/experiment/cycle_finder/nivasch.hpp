@@ -0,0 +1,154 @@
+/*
+ * nivasch.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef NIVASCH_HPP_
+#define NIVASCH_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+
+#include "../../core/BooleanDynamics.hpp"
+#include "../../core/Attractor.hpp"
+#include "../../core/network_state.hpp"
+#include "../TrajectoryRange.hpp"
+
+namespace bn {
+
+namespace cycle_finder {
+
+namespace detail {
+
+/**
+ * Stacks of Nivasch's algorithm, each of which holds states in increasing
+ * order with the step at which they were visited.
+ *
+ * With more than one stack, states are partitioned among them by hash, and
+ * a cycle is found as soon as the least state of any class on the cycle
+ * comes back. Popped elements are kept, so that their states are reused by
+ * later pushes without allocating memory.
+ */
+template<class S, std::size_t Stacks> class NivaschStacks {
+public:
+	NivaschStacks() {
+		std::fill(sizes, sizes + Stacks, 0);
+		for (std::size_t k = 0; k < Stacks; ++k) {
+			states[k].reserve(RESERVE);
+			times[k].reserve(RESERVE);
+		}
+	}
+
+	/**
+	 * Visits the state reached at step @a time.
+	 * @return the length of the cycle if @a s was visited before, 0
+	 * 	otherwise
+	 */
+	std::size_t push(const S& s, const std::size_t time) {
+		const std::size_t k = Stacks == 1 ? 0 : bitset_hash(s) % Stacks;
+		std::vector<S>& st = states[k];
+		std::vector<std::size_t>& t = times[k];
+		std::size_t& top = sizes[k];
+		while (top > 0 && s < st[top - 1])
+			--top;
+		if (top > 0 && s == st[top - 1])
+			return time - t[top - 1];
+		if (top == st.size()) {
+			st.push_back(s);
+			t.push_back(time);
+		} else {
+			st[top] = s;
+			t[top] = time;
+		}
+		++top;
+		return 0;
+	}
+
+private:
+	/**
+	 * Initial capacity of a stack, which is seldom exceeded.
+	 */
+	static const std::size_t RESERVE = 32;
+
+	std::vector<S> states[Stacks];
+	std::vector<std::size_t> times[Stacks];
+	std::size_t sizes[Stacks];
+};
+
+} // namespace detail
+
+/**
+ * Finds the attractor reached from a state with Nivasch's stack algorithm.
+ *
+ * The algorithm keeps a stack of states that increase from the bottom,
+ * popping the ones greater than each new state, and stops when the least
+ * state of the cycle comes back to the top: within one cycle length after
+ * the trajectory enters the cycle, where Brent's algorithm may take twice as
+ * many steps, and with a stack whose expected size is logarithmic in the
+ * number of steps. Type parameter @a Stacks is the number of stacks
+ * (see detail::NivaschStacks): with @e k stacks the cycle is found after
+ * about \f$1/(k+1)\f$ of its length, at the cost of hashing every state.
+ *
+ * Like brent(), it is templated on the type of the dynamics.
+ * @param dyn the dynamics
+ * @param s an initial state
+ * @return the attractor
+ */
+template<std::size_t Stacks, class D> BasicAttractor<typename D::state_type> nivasch(
+		D& dyn, typename D::state_type s) {
+	typedef typename D::state_type S;
+	using std::swap;
+	detail::NivaschStacks<S, Stacks> stacks;
+	S next(s);
+	std::size_t lambda;
+	for (std::size_t iter = 0; !(lambda = stacks.push(s, iter)); ++iter) {
+		bn::detail::static_step(dyn, s, next);
+		swap(s, next);
+	}
+	return BasicAttractor<S> (BasicTrajectoryRange<S, D> (dyn, s, lambda));
+}
+
+template<class D> BasicAttractor<typename D::state_type> nivasch(D& dyn,
+		typename D::state_type s) {
+	return nivasch<1> (dyn, s);
+}
+
+/**
+ * Finds the attractor reached from a state with Nivasch's stack algorithm,
+ * unless the terminator gives up first.
+ * @param dyn the dynamics
+ * @param s an initial state
+ * @param term called with the number of steps so far; the search gives up
+ * 	when it returns @e true, as for brent()
+ * @return the attractor, or the empty attractor if the search gave up
+ */
+template<std::size_t Stacks, class D, class Terminator> BasicAttractor<
+		typename D::state_type> nivasch(D& dyn, typename D::state_type s,
+		Terminator term) {
+	typedef typename D::state_type S;
+	using std::swap;
+	detail::NivaschStacks<S, Stacks> stacks;
+	S next(s);
+	std::size_t lambda;
+	for (std::size_t iter = 0; !(lambda = stacks.push(s, iter)); ++iter) {
+		if (term(iter))
+			return BasicAttractor<S> ();
+		bn::detail::static_step(dyn, s, next);
+		swap(s, next);
+	}
+	return BasicAttractor<S> (BasicTrajectoryRange<S, D> (dyn, s, lambda));
+}
+
+template<class D, class Terminator> BasicAttractor<typename D::state_type> nivasch(
+		D& dyn, typename D::state_type s, Terminator term) {
+	return nivasch<1> (dyn, s, term);
+}
+
+} // namespace cycle_finder
+
+} // namespace bn
+
+#endif /* NIVASCH_HPP_ */
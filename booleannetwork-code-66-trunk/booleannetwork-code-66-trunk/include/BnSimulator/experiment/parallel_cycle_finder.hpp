@@ -0,0 +1,236 @@
+/*
+ * parallel_cycle_finder.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef PARALLEL_CYCLE_FINDER_HPP_
+#define PARALLEL_CYCLE_FINDER_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "../util/Counter.hpp"
+#include "cycle_finder.hpp"
+
+namespace bn {
+
+namespace detail {
+
+/**
+ * Initial states queued for one worker of a ParallelSearch, which takes them
+ * from the front while idle workers steal from the back.
+ */
+template<class T> struct StealingDeque {
+	boost::mutex mutex;
+	std::deque<T> items;
+};
+
+/**
+ * Runs a cycle finder from every state of a sequence on a pool of threads.
+ *
+ * Workers take chunks of initial states from the sequence, which is read by
+ * one thread at a time, hence generators like gen::RandomStateGen need not be
+ * thread safe. Once the sequence ends, a worker whose queue is empty steals
+ * half of the queue of another one, so that a few long transients do not
+ * leave the other threads idle. Every worker finds attractors on its own copy
+ * of the dynamics (see copy_dynamics()), with its own buffers, and counts
+ * them in its own Counter; the counters are merged at the end.
+ */
+template<class InputIterator, class Finder> class ParallelSearch {
+public:
+	typedef typename Finder::result_type result_type;
+	typedef typename std::iterator_traits<InputIterator>::value_type value_type;
+
+	/**
+	 * @param first the first initial state
+	 * @param last the end of the initial states
+	 * @param threads the number of workers, the calling thread included
+	 * @param chunk the number of states a worker takes from the sequence at
+	 * 	once
+	 */
+	ParallelSearch(const InputIterator first, const InputIterator last,
+			const std::size_t threads, const std::size_t chunk) :
+		first(first), last(last), threads(std::max<std::size_t>(1, threads)),
+				chunk(std::max<std::size_t>(1, chunk)),
+				deques(new StealingDeque<value_type> [this->threads]),
+				counters(this->threads) {
+	}
+
+	/**
+	 * Finds the attractors reached from every initial state, skipping the
+	 * trajectories that gave up.
+	 *
+	 * The calling thread works on the dynamics of @a f, the other threads on
+	 * copies of it made before they start.
+	 * @param f a cycle finder returned by naive() or brent()
+	 * @return the attractors found, each with the number of initial states
+	 * 	that reach it
+	 */
+	util::Counter<result_type> run(const Finder& f) {
+		typedef typename Finder::dynamics_type D;
+		std::vector<boost::shared_ptr<D> > copies;
+		for (std::size_t t = 1; t < threads; ++t)
+			copies.push_back(boost::shared_ptr<D>(copy_dynamics(f.dyn)));
+		boost::thread_group workers;
+		for (std::size_t t = 1; t < threads; ++t)
+			workers.create_thread(boost::bind(&ParallelSearch::work, this, t,
+					f.bind(*copies[t - 1])));
+		work(0, f);
+		workers.join_all();
+		util::Counter<result_type> res;
+		for (std::size_t t = 0; t < threads; ++t)
+			res.merge(counters[t]);
+		return res;
+	}
+
+private:
+	InputIterator first, last;
+	const std::size_t threads, chunk;
+	/**
+	 * Protects first.
+	 */
+	boost::mutex source;
+	boost::scoped_array<StealingDeque<value_type> > deques;
+	std::vector<util::Counter<result_type> > counters;
+
+	/**
+	 * Body of worker @a t.
+	 */
+	void work(const std::size_t t, const Finder f) {
+		value_type s;
+		while (next(t, s)) {
+			const result_type a = f(s);
+			if (!a.empty())
+				counters[t].insert(a);
+		}
+	}
+
+	/**
+	 * Gives worker @a t its next initial state, from its own queue, from the
+	 * sequence or from the queue of another worker, in this order.
+	 * @return @e false if no state is left
+	 */
+	bool next(const std::size_t t, value_type& s) {
+		StealingDeque<value_type>& own = deques[t];
+		{
+			boost::mutex::scoped_lock lock(own.mutex);
+			if (!own.items.empty()) {
+				s = own.items.front();
+				own.items.pop_front();
+				return true;
+			}
+		}
+		{
+			boost::mutex::scoped_lock lock(source);
+			if (first != last) {
+				s = *first;
+				++first;
+				boost::mutex::scoped_lock ownLock(own.mutex);
+				for (std::size_t i = 1; i < chunk && first != last; ++i, ++first)
+					own.items.push_back(*first);
+				return true;
+			}
+		}
+		// the sequence is over, hence no state is ever queued again: a worker
+		// may quit while another one moves stolen states, which that one runs
+		for (std::size_t v = 1; v < threads; ++v) {
+			StealingDeque<value_type>& victim = deques[(t + v) % threads];
+			std::deque<value_type> stolen;
+			{
+				boost::mutex::scoped_lock lock(victim.mutex);
+				const std::size_t n = (victim.items.size() + 1) / 2;
+				stolen.assign(victim.items.end() - n, victim.items.end());
+				victim.items.erase(victim.items.end() - n, victim.items.end());
+			}
+			if (stolen.empty())
+				continue;
+			s = stolen.front();
+			stolen.pop_front();
+			// locked apart from the victim, lest two thieves deadlock
+			boost::mutex::scoped_lock lock(own.mutex);
+			own.items.insert(own.items.end(), stolen.begin(), stolen.end());
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * This class disallows copies.
+	 */
+	ParallelSearch(const ParallelSearch&);
+
+	ParallelSearch& operator=(const ParallelSearch&);
+};
+
+/**
+ * Cycle finder that runs another one on a pool of threads (see
+ * ParallelSearch).
+ */
+template<class Finder> struct ParallelCycleFinder {
+	typedef util::Counter<typename Finder::result_type> result_type;
+	Finder f;
+	std::size_t threads, chunk;
+	ParallelCycleFinder(const Finder& f, const std::size_t threads,
+			const std::size_t chunk) :
+		f(f), threads(threads), chunk(chunk) {
+	}
+	template<class SinglePassRange> result_type findAttractors(
+			const SinglePassRange& r) const {
+		typedef typename boost::range_iterator<const SinglePassRange>::type It;
+		ParallelSearch<It, Finder> search(boost::begin(r), boost::end(r),
+				threads, chunk);
+		return search.run(f);
+	}
+};
+
+} // namespace detail
+
+/**
+ * Returns a cycle finder that runs @a f on a pool of threads, which is the
+ * execution mode meant for sampling many initial states on a multi-core
+ * machine.
+ *
+ * Piping a range of initial states into it gives a Counter of the attractors
+ * found and of the number of initial states that reach each of them. The
+ * dynamics of @a f must be a network class, which is copied, or a
+ * BooleanDynamics, which is cloned; see CompiledNetwork for dynamics whose
+ * copies are cheap.
+ * @param f a cycle finder returned by naive() or brent()
+ * @param threads the number of threads, the calling one included
+ * @param chunk the number of initial states a thread takes at once
+ */
+template<class Finder> detail::ParallelCycleFinder<Finder> parallel(
+		const Finder& f, const std::size_t threads =
+				boost::thread::hardware_concurrency(), const std::size_t chunk =
+				64) {
+	return detail::ParallelCycleFinder<Finder>(f, threads, chunk);
+}
+
+/**
+ * Finds the attractors reached from a range of states with a parallel cycle
+ * finder, skipping the trajectories that gave up.
+ */
+template<class SinglePassRange, class Finder> util::Counter<
+		typename Finder::result_type> operator|(const SinglePassRange& rng,
+		const detail::ParallelCycleFinder<Finder>& f) {
+	return f.findAttractors(rng);
+}
+
+} // namespace bn
+
+#endif /* PARALLEL_CYCLE_FINDER_HPP_ */
@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <utility>
 #include <map>
+#include <vector>
 
 #include <boost/iterator/transform_iterator.hpp>
 
@@ -56,6 +57,24 @@ template<class CycleFinder> std::map<Attractor, double> perturb_attractor(
 			boost::make_transform_iterator(c.end(), func));
 }
 
+/**
+ * Overload for the interleaved cycle finder, which runs the trajectories
+ * from all of the perturbed states together.
+ */
+template<class Terminator> std::map<Attractor, double> perturb_attractor(
+		const Attractor& a, const detail::InterleavedCycleFinder<Terminator>& f) {
+	std::vector<State> perturbed;
+	for (Attractor::const_iterator it = a.begin(), end = a.end(); it != end; ++it)
+		for (std::size_t i = 0; i < it->size(); ++i)
+			perturbed.push_back(State(*it).flip(i));
+	const std::vector<Attractor> found = perturbed | f;
+	util::Counter<Attractor> c(found);
+	const detail::Normalize func(c.insertions());
+	return std::map<Attractor, double>(
+			boost::make_transform_iterator(c.begin(), func),
+			boost::make_transform_iterator(c.end(), func));
+}
+
 } // namespace bn
 
 #endif /* PERTURB_ATTRACTOR_HPP_ */
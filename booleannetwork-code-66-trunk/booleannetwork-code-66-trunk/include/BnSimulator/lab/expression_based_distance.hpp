@@ -8,9 +8,9 @@
 #ifndef EXPRESSION_BASED_DISTANCE_HPP_
 #define EXPRESSION_BASED_DISTANCE_HPP_
 
-namespace bn {
+#include "../core/Attractor_fwd.hpp"
 
-class Attractor;
+namespace bn {
 
 double expression_based_distance(const Attractor& a, const Attractor& b);
 
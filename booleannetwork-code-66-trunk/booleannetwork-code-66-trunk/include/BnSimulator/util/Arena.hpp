@@ -0,0 +1,141 @@
+/*
+ * Arena.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef ARENA_HPP_
+#define ARENA_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+namespace bn {
+
+namespace util {
+
+/**
+ * Bump allocator that carves objects out of large blocks and frees them all
+ * at once.
+ *
+ * Objects are never freed one by one: the memory of every allocation is
+ * released by release() or by the destructor. This suits data whose lifetime
+ * is that of an experiment (see ExperimentArena): allocating is a pointer
+ * increment, objects allocated one after the other are contiguous, and the
+ * heap is neither fragmented nor walked at the end of the experiment.
+ *
+ * Only objects with a trivial destructor should be allocated here, since no
+ * destructor is ever called.
+ */
+class Arena : private boost::noncopyable {
+public:
+	/**
+	 * Default size of a block: 1 MiB.
+	 */
+	static const std::size_t DEFAULT_BLOCK_SIZE = std::size_t(1) << 20;
+
+	explicit Arena(const std::size_t blockSize = DEFAULT_BLOCK_SIZE) :
+		blockSize(blockSize), next(NULL), last(NULL), reserved(0) {
+	}
+
+	~Arena() {
+		release();
+	}
+
+	/**
+	 * Allocates uninitialized memory.
+	 * @param bytes the number of bytes
+	 * @param alignment the alignment of the memory, a power of 2
+	 * @return a pointer to @a bytes bytes, valid until release()
+	 */
+	void* allocate(const std::size_t bytes, const std::size_t alignment =
+			sizeof(void*)) {
+		assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+		char* p = align(next, alignment);
+		if (!next || p + bytes > last) {
+			grow(bytes + alignment);
+			p = align(next, alignment);
+		}
+		next = p + bytes;
+		return p;
+	}
+
+	/**
+	 * Allocates an uninitialized array.
+	 * @param n the number of elements
+	 * @return a pointer to @a n objects of type @a T, valid until release()
+	 */
+	template<class T> T* allocate(const std::size_t n) {
+		return static_cast<T*> (allocate(n * sizeof(T), boost::alignment_of<
+				T>::value));
+	}
+
+	/**
+	 * Frees all of the memory allocated so far.
+	 */
+	void release() {
+		for (std::vector<char*>::const_iterator it = blocks.begin(); it
+				!= blocks.end(); ++it)
+			::operator delete(*it);
+		blocks.clear();
+		next = last = NULL;
+		reserved = 0;
+	}
+
+	/**
+	 * Returns the number of bytes reserved from the heap.
+	 * @return the total size of the blocks
+	 */
+	std::size_t memory() const {
+		return reserved;
+	}
+
+	/**
+	 * Returns the number of blocks reserved from the heap, that is the number
+	 * of heap allocations made by this arena.
+	 * @return a block count
+	 */
+	std::size_t numBlocks() const {
+		return blocks.size();
+	}
+
+private:
+	std::size_t blockSize;
+	std::vector<char*> blocks;
+	/**
+	 * Free space of the current block.
+	 */
+	char* next;
+	char* last;
+	std::size_t reserved;
+
+	static char* align(char* p, const std::size_t alignment) {
+		const std::size_t mis = reinterpret_cast<std::size_t> (p) & (alignment
+				- 1);
+		return mis ? p + (alignment - mis) : p;
+	}
+
+	/**
+	 * Starts a new block of at least @a bytes bytes.
+	 */
+	void grow(const std::size_t bytes) {
+		const std::size_t size = std::max(blockSize, bytes);
+		blocks.push_back(static_cast<char*> (::operator new(size)));
+		next = blocks.back();
+		last = next + size;
+		reserved += size;
+	}
+};
+
+} // namespace util
+
+} // namespace bn
+
+#endif /* ARENA_HPP_ */
@@ -151,7 +151,7 @@ public:
 	template<class SinglePassRange> explicit Counter(const SinglePassRange& r,
 			const comparator_type& comp = comparator_type()) :
 		map(comp), count(0) {
-		for (typename boost::range_iterator<SinglePassRange>::type first =
+		for (typename boost::range_iterator<const SinglePassRange>::type first =
 				boost::begin(r), last = boost::end(r); first != last; ++first)
 			insert(*first);
 	}
@@ -241,6 +241,18 @@ public:
 		return p;
 	}
 
+	/**
+	 * Adds the counts of another Counter to this one, as if its insertions
+	 * had been performed on this container.
+	 * @param other a Counter object
+	 */
+	void merge(const Counter& other) {
+		for (const_iterator it = other.begin(), end = other.end(); it != end;
+				++it)
+			map[it->first] += it->second;
+		count += other.count;
+	}
+
 	/**
 	 * Implementation of swap function.
 	 * @param other a Counter object
@@ -0,0 +1,79 @@
+/*
+ * Histogram.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef HISTOGRAM_HPP_
+#define HISTOGRAM_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+namespace bn {
+
+namespace util {
+
+/**
+ * Counts of unsigned integer values, such as in-degrees or transient
+ * lengths, meant to be added to once per state of a state space.
+ *
+ * Values below DENSE are counted in an array, which costs constant time;
+ * the other ones in a map, hence the memory is proportional to the number of
+ * distinct values rather than to the largest one.
+ */
+class Histogram {
+public:
+	/**
+	 * Sparse distribution: the count of every value that occurred.
+	 */
+	typedef std::map<boost::uint64_t, boost::uint64_t> map_type;
+
+	/**
+	 * Number of values counted in the array.
+	 */
+	static const std::size_t DENSE = 1024;
+
+	Histogram() :
+		dense(DENSE) {
+	}
+
+	void add(const boost::uint64_t value, const boost::uint64_t times = 1) {
+		if (value < DENSE)
+			dense[value] += times;
+		else
+			sparse[value] += times;
+	}
+
+	/**
+	 * Adds the counts to a distribution.
+	 * @param distribution its values with a zero count are not stored
+	 */
+	void addTo(map_type& distribution) const {
+		for (std::size_t i = 0; i < DENSE; ++i)
+			if (dense[i])
+				distribution[i] += dense[i];
+		for (map_type::const_iterator i = sparse.begin(); i != sparse.end(); ++i)
+			distribution[i->first] += i->second;
+	}
+
+	void clear() {
+		std::fill(dense.begin(), dense.end(), 0);
+		sparse.clear();
+	}
+
+private:
+	std::vector<boost::uint64_t> dense;
+	map_type sparse;
+};
+
+} // namespace util
+
+} // namespace bn
+
+#endif /* HISTOGRAM_HPP_ */
@@ -0,0 +1,130 @@
+/*
+ * MappedArray.hpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#ifndef MAPPEDARRAY_HPP_
+#define MAPPEDARRAY_HPP_
+
+#include <cassert>
+#include <cstddef>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace bn {
+
+namespace util {
+
+/**
+ * A file mapped in memory for reading and writing.
+ *
+ * Writes reach the file when the operating system sees fit, or at the latest
+ * when sync() returns; the file outlives this object.
+ */
+class MappedFile : private boost::noncopyable {
+public:
+	MappedFile() :
+		data(NULL), bytes(0) {
+	}
+
+	~MappedFile() {
+		close();
+	}
+
+	bool open(const std::string& path, const boost::uint64_t bytes);
+
+	void close();
+
+	bool sync();
+
+	bool isOpen() const {
+		return data != NULL;
+	}
+
+	void* get() const {
+		return data;
+	}
+
+	boost::uint64_t size() const {
+		return bytes;
+	}
+
+private:
+	void* data;
+	boost::uint64_t bytes;
+};
+
+/**
+ * Array of trivially copyable objects stored in a MappedFile, for data larger
+ * than memory.
+ *
+ * Elements are stored in the byte order of the machine. Pages are read from
+ * the file the first time they are accessed, hence sequential sweeps are by
+ * far the fastest way to go through an array.
+ */
+template<class T> class MappedArray : private boost::noncopyable {
+public:
+	typedef T value_type;
+
+	/**
+	 * Maps a file, which is created or resized as needed: elements that
+	 * were already in the file keep their values, new ones are zero.
+	 * @param path the file name
+	 * @param size the number of elements
+	 * @return @e false if the file could not be mapped
+	 */
+	bool open(const std::string& path, const boost::uint64_t size) {
+		return file.open(path, size * sizeof(T));
+	}
+
+	void close() {
+		file.close();
+	}
+
+	/**
+	 * Writes the modified elements to the file.
+	 * @return @e false on failure
+	 */
+	bool sync() {
+		return file.sync();
+	}
+
+	bool isOpen() const {
+		return file.isOpen();
+	}
+
+	boost::uint64_t size() const {
+		return file.size() / sizeof(T);
+	}
+
+	T* data() {
+		return static_cast<T*> (file.get());
+	}
+
+	const T* data() const {
+		return static_cast<const T*> (file.get());
+	}
+
+	T& operator[](const boost::uint64_t i) {
+		assert(i < size());
+		return data()[i];
+	}
+
+	const T& operator[](const boost::uint64_t i) const {
+		assert(i < size());
+		return data()[i];
+	}
+
+private:
+	MappedFile file;
+};
+
+} // namespace util
+
+} // namespace bn
+
+#endif /* MAPPEDARRAY_HPP_ */
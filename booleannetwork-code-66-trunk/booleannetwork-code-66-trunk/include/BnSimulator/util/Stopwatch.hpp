@@ -0,0 +1,56 @@
+/*
+ * Stopwatch.hpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#ifndef STOPWATCH_HPP_
+#define STOPWATCH_HPP_
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+namespace bn {
+
+namespace util {
+
+/**
+ * Wall-clock timer used by the benchmark programs.
+ *
+ * The timer starts upon construction and can be restarted at any time.
+ */
+class Stopwatch {
+public:
+	Stopwatch() :
+		start(now()) {
+	}
+
+	/**
+	 * Restarts the timer.
+	 */
+	void restart() {
+		start = now();
+	}
+
+	/**
+	 * Returns the number of seconds elapsed since construction or since the
+	 * last call to restart().
+	 * @return elapsed seconds
+	 */
+	double elapsed() const {
+		return (now() - start).total_microseconds() / 1e6;
+	}
+
+private:
+	boost::posix_time::ptime start;
+
+	static boost::posix_time::ptime now() {
+		return boost::posix_time::microsec_clock::universal_time();
+	}
+};
+
+} // namespace util
+
+} // namespace bn
+
+#endif /* STOPWATCH_HPP_ */
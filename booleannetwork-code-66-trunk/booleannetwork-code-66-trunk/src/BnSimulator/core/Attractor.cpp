@@ -5,18 +5,12 @@
  *      Author: stewie
  */
 
-#include <BnSimulator/util/printing.hpp>
 #include <BnSimulator/core/Attractor.hpp>
 
 namespace bn {
 
-std::ostream& operator<<(std::ostream& out, const ImplicitAttractor& a) {
-	return out << a.representant;
-}
+template class BasicImplicitAttractor<State>;
 
-std::ostream& operator<<(std::ostream& out, const Attractor& a) {
-	util::print(out, a.states, "\n");
-	return out;
-}
+template class BasicAttractor<State>;
 
 } // namespace bn
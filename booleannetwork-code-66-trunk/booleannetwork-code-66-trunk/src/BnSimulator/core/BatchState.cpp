@@ -0,0 +1,140 @@
+/*
+ * BatchState.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <climits>
+
+#include <BnSimulator/core/BatchState.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+const size_t bits_per_block = sizeof(State::block_type) * CHAR_BIT;
+
+} // namespace
+
+/**
+ * Stores a state in a lane of this batch.
+ *
+ * For bulk conversions load() is much faster.
+ * @param lane a lane index
+ * @param s a state of size() nodes
+ */
+void BatchState::setLane(const size_t lane, const State& s) {
+	assert(s.size() == n);
+	for (size_t i = 0; i < n; ++i)
+		set(i, lane, s[i]);
+}
+
+/**
+ * Extracts the state stored in a lane of this batch.
+ *
+ * For bulk conversions store() is much faster.
+ * @param lane a lane index
+ * @return the state in lane @a lane
+ */
+State BatchState::getLane(const size_t lane) const {
+	State s(n);
+	for (size_t i = 0; i < n; ++i)
+		s[i] = get(i, lane);
+	return s;
+}
+
+/**
+ * Appends the numChunks() 64-bit words of a state to @a rows.
+ */
+void BatchState::appendWords(const State& s, vector<word_type>& rows) const {
+	const size_t first = rows.size();
+	rows.resize(first + numChunks());
+	vector<State::block_type> tmp(s.num_blocks());
+	boost::to_block_range(s, tmp.begin());
+	for (size_t i = 0; i < tmp.size(); ++i) {
+		const size_t bit = i * bits_per_block;
+		rows[first + bit / bits_per_word] |= word_type(tmp[i]) << (bit
+				% bits_per_word);
+	}
+}
+
+/**
+ * Builds a state out of numChunks() 64-bit words.
+ */
+State BatchState::makeState(const word_type* row) const {
+	State s(n);
+	vector<State::block_type> tmp(s.num_blocks());
+	for (size_t i = 0; i < tmp.size(); ++i) {
+		const size_t bit = i * bits_per_block;
+		tmp[i] = static_cast<State::block_type> (row[bit / bits_per_word]
+				>> (bit % bits_per_word));
+	}
+	boost::from_block_range(tmp.begin(), tmp.end(), s);
+	return s;
+}
+
+/**
+ * Transposes lane-major words (lanes() rows of numChunks() words each) into
+ * the node-major layout of this batch.
+ */
+void BatchState::loadWords(vector<word_type>& rows) {
+	const size_t chunks = numChunks();
+	word_type m[bits_per_word];
+	for (size_t b = 0; b < blocks; ++b) {
+		for (size_t c = 0; c < chunks; ++c) {
+			for (size_t l = 0; l < bits_per_word; ++l)
+				m[l] = rows[(b * bits_per_word + l) * chunks + c];
+			util::transpose64(m);
+			for (size_t r = 0, i = c * bits_per_word; r < bits_per_word && i
+					< n; ++r, ++i)
+				words[i * blocks + b] = m[r];
+		}
+	}
+}
+
+/**
+ * Inverse of loadWords().
+ */
+void BatchState::storeWords(vector<word_type>& rows) const {
+	const size_t chunks = numChunks();
+	rows.assign(lanes() * chunks, 0);
+	word_type m[bits_per_word];
+	for (size_t b = 0; b < blocks; ++b) {
+		for (size_t c = 0; c < chunks; ++c) {
+			for (size_t r = 0, i = c * bits_per_word; r < bits_per_word; ++r, ++i)
+				m[r] = i < n ? words[i * blocks + b] : 0;
+			util::transpose64(m);
+			for (size_t l = 0; l < bits_per_word; ++l)
+				rows[(b * bits_per_word + l) * chunks + c] = m[l];
+		}
+	}
+}
+
+namespace util {
+
+/**
+ * Transposes in place a 64x64 bit matrix whose rows are the words of @a m,
+ * so that afterwards bit @e j of <code>m[i]</code> holds what was bit @e i of
+ * <code>m[j]</code>.
+ *
+ * It is the recursive block-swap algorithm: 6 passes of 32 masked swaps each.
+ * @param m the matrix rows
+ */
+void transpose64(BatchState::word_type m[64]) {
+	typedef BatchState::word_type word_type;
+	word_type mask = 0x00000000FFFFFFFFULL;
+	for (size_t j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+		for (size_t k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+			const word_type t = ((m[k] >> j) ^ m[k | j]) & mask;
+			m[k | j] ^= t;
+			m[k] ^= t << j;
+		}
+	}
+}
+
+} // namespace util
+
+} // namespace bn
@@ -0,0 +1,109 @@
+/*
+ * BitslicedNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <cassert>
+#include <algorithm>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/BitslicedNetwork.hpp>
+
+using namespace std;
+
+namespace bn {
+
+BitslicedNetwork::BitslicedNetwork(const ImmutableBooleanNetwork& net) :
+	kernel(&best_lane_kernel()) {
+	init(net);
+}
+
+BitslicedNetwork::BitslicedNetwork(const MutableBooleanNetwork& net) :
+	kernel(&best_lane_kernel()) {
+	init(net);
+}
+
+template<class Network> void BitslicedNetwork::init(const Network& net) {
+	size_t maxArity = 0;
+	offsets.push_back(0);
+	tableOffsets.push_back(0);
+	for (size_t i = 0; i < net.size(); ++i) {
+		const vector<size_t> in = net.getInputs(i);
+		inputs.insert(inputs.end(), in.begin(), in.end());
+		offsets.push_back(inputs.size());
+		const BooleanFunction f = net.getFunction(i);
+		const vector<int> tt = f.truthTable();
+		// an empty table marks a node that holds its value
+		assert(in.empty() || tt.size() == (size_t(1) << in.size()));
+		tables.insert(tables.end(), tt.begin(), tt.end());
+		tableOffsets.push_back(tables.size());
+		maxArity = max(maxArity, in.size());
+	}
+	scratch.resize((maxArity > 0 ? size_t(1) << (maxArity - 1) : 1)
+			* MAX_LANE_KERNEL_WIDTH);
+	inputWords.resize(maxArity);
+}
+
+/**
+ * Performs one synchronous step on every lane of a batch.
+ * @param in the current batch
+ * @param out the next batch; it must have the same shape as @a in and must not
+ * 	alias it
+ */
+void BitslicedNetwork::step(const BatchState& in, BatchState& out) {
+	assert(in.size() == size() && out.size() == size());
+	assert(in.numBlocks() == out.numBlocks() && &in != &out);
+	for (size_t i = 0; i < size(); ++i)
+		evalNode(i, in, out);
+}
+
+/**
+ * Performs one synchronous step on every lane of a batch, in place.
+ * @param s a batch of states
+ */
+void BitslicedNetwork::update(BatchState& s) {
+	if (next.size() != s.size() || next.numBlocks() != s.numBlocks())
+		next = BatchState(s.size(), s.lanes());
+	step(s, next);
+	swap(s, next);
+}
+
+/**
+ * Performs @a n synchronous steps on every lane of a batch, in place.
+ * @param s a batch of states
+ * @param n number of steps
+ */
+void BitslicedNetwork::update(BatchState& s, const size_t n) {
+	for (size_t i = 0; i < n; ++i)
+		update(s);
+}
+
+/**
+ * Evaluates the function of node @a i on all lanes.
+ *
+ * Constant nodes and nodes holding their value are handled here, the others
+ * by the kernel.
+ */
+void BitslicedNetwork::evalNode(const size_t i, const BatchState& in,
+		BatchState& out) {
+	const size_t blocks = in.numBlocks();
+	const size_t k = offsets[i + 1] - offsets[i];
+	const size_t t = tableOffsets[i];
+	word_type* const dst = out.node(i);
+	if (tableOffsets[i + 1] == t) { // no function: the node holds its value
+		copy(in.node(i), in.node(i) + blocks, dst);
+		return;
+	}
+	if (k == 0) {
+		fill(dst, dst + blocks, -word_type(tables[t]));
+		return;
+	}
+	for (size_t j = 0; j < k; ++j)
+		inputWords[j] = in.node(inputs[offsets[i] + j]);
+	kernel->eval(&inputWords[0], k, &tables[t], blocks, &scratch[0], dst);
+}
+
+} // namespace bn
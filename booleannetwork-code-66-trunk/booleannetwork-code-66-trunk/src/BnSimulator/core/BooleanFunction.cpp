@@ -1,5 +1,17 @@
 #include <cassert>
+#include <cstdlib>
 #include <algorithm>
+#include <istream>
+#include <sstream>
+#include <string>
+
+#include <boost/algorithm/string/trim.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/static_assert.hpp>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 #include <BnSimulator/core/BooleanFunction.hpp>
 
@@ -7,84 +19,366 @@ using namespace std;
 
 namespace bn {
 
+namespace {
+
+const size_t BLOCK_BITS = State::bits_per_block;
+
+const size_t LOG_BLOCK_BITS = 6;
+
+BOOST_STATIC_ASSERT(BLOCK_BITS == size_t(1) << LOG_BLOCK_BITS);
+
+/**
+ * ZERO_MASKS[i] selects the entries of a block whose index has bit @e i
+ * equal to 0.
+ */
+const State::block_type ZERO_MASKS[LOG_BLOCK_BITS] = {
+		0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+		0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL };
+
+/**
+ * Parses the tokens of a threshold function row (see read_functions()).
+ */
+ThresholdFunction read_threshold(istream& tokens) {
+	string t, tie;
+	ThresholdFunction::sum_type threshold;
+	tokens >> t >> threshold >> tie;
+	assert(t == "t" && !tie.empty() && tokens);
+	vector<ThresholdFunction::weight_type> weights;
+	for (ThresholdFunction::weight_type w; tokens >> w;)
+		weights.push_back(w);
+	if (tie[0] == '=')
+		return ThresholdFunction(weights, threshold,
+				ThresholdFunction::TIE_KEEP, atoi(tie.c_str() + 1));
+	return ThresholdFunction(weights, threshold, tie == "1"
+			? ThresholdFunction::TIE_TRUE : ThresholdFunction::TIE_FALSE);
+}
+
+} // namespace
+
 BooleanFunction::BooleanFunction(const State& s) :
-	def(s), arity(arityFromSize(def.size())) {
-	for (size_t i = 0; i < def.size(); ++i)
-		def[i] = s[i];
+	arity(arityFromSize(s.size())) {
+	store(s);
+}
+
+/**
+ * Builds a function from a decision diagram, storing it as a table if it has
+ * at most MAX_TABLE_ARITY inputs or if the table is smaller.
+ * @param d a decision diagram
+ */
+BooleanFunction::BooleanFunction(const DecisionDiagram& d) :
+	arity(d.getArity()) {
+	const size_t tableBytes = arity < sizeof(size_t) * 8 - 3 ? (size_t(1)
+			<< arity) / 8 : size_t(-1);
+	if (arity <= MAX_TABLE_ARITY || tableBytes <= d.memory())
+		store(d.table());
+	else {
+		bits = NULL;
+		diagram.reset(new DecisionDiagram(d));
+	}
+}
+
+/**
+ * Builds a function from a threshold function, which is kept as is whatever
+ * the arity.
+ * @param t a threshold function
+ */
+BooleanFunction::BooleanFunction(const ThresholdFunction& t) :
+	arity(t.getArity()), bits(NULL), threshold(new ThresholdFunction(t)) {
+}
+
+/**
+ * Stores a truth table, as a diagram if this function has more than
+ * MAX_TABLE_ARITY inputs and the diagram is smaller than the table.
+ * @param t a truth table
+ */
+void BooleanFunction::store(const State& t) {
+	bits = NULL;
+	if (arity > MAX_TABLE_ARITY) {
+		const DecisionDiagram d = DecisionDiagram::fromTable(t);
+		if (d.memory() < t.num_blocks() * sizeof(State::block_type)) {
+			diagram.reset(new DecisionDiagram(d));
+			return;
+		}
+	}
+	boost::shared_ptr<Table> blocks(new Table(t.num_blocks()));
+	boost::to_block_range(t, blocks->begin());
+	bits = blocks->empty() ? NULL : &(*blocks)[0];
+	table = blocks;
+}
+
+/**
+ * Returns the truth table of a function stored as a table.
+ */
+State BooleanFunction::tableState() const {
+	assert(table);
+	State t(size());
+	boost::from_block_range(table->begin(), table->end(), t);
+	return t;
+}
+
+/**
+ * Returns this function as a decision diagram.
+ * @return a diagram of the same arity
+ */
+DecisionDiagram BooleanFunction::toDiagram() const {
+	assert(!empty());
+	if (diagram)
+		return *diagram;
+	return DecisionDiagram::fromTable(threshold ? threshold->table()
+			: tableState());
 }
 
 vector<int> BooleanFunction::truthTable() const {
-	vector<int> tt(def.size());
-	for (size_t i = 0; i < def.size(); ++i)
-		tt[i] = def[i];
+	if (diagram || threshold) {
+		const State t = diagram ? diagram->table() : threshold->table();
+		vector<int> tt(t.size());
+		for (size_t i = 0; i < t.size(); ++i)
+			tt[i] = t[i];
+		return tt;
+	}
+	vector<int> tt(size());
+	for (size_t i = 0; i < tt.size(); ++i)
+		tt[i] = (*this)[i];
 	return tt;
 }
 
 bool BooleanFunction::isInfluent(const size_t i) const {
-	const pair<State, State> m = demultiplex(i);
-	return (m.first ^ m.second).any();
+	if (diagram)
+		return diagram->dependsOn(i);
+	if (threshold)
+		return threshold->dependsOn(i);
+	assert(i < arity);
+	const Table& t = *table;
+	if (i < LOG_BLOCK_BITS) { // compare the two halves of every window
+		const size_t shift = size_t(1) << i;
+		for (size_t w = 0; w < t.size(); ++w)
+			if (((t[w] >> shift) ^ t[w]) & ZERO_MASKS[i])
+				return true;
+		return false;
+	}
+	const size_t stride = size_t(1) << (i - LOG_BLOCK_BITS);
+	for (size_t w = 0; w < t.size(); w += 2 * stride)
+		if (!equal(t.begin() + w, t.begin() + w + stride, t.begin() + w
+				+ stride))
+			return true;
+	return false;
 }
 
 BooleanFunction BooleanFunction::clamped(const std::size_t i, const bool v) const {
-	const pair<State, State> m = demultiplex(i);
-	return BooleanFunction(v ? m.second : m.first);
+	if (diagram)
+		return BooleanFunction(diagram->clamped(i, v));
+	if (threshold)
+		return BooleanFunction(threshold->clamped(i, v));
+	Table t = cofactor(i, v);
+	return BooleanFunction(arity - 1, t);
 }
 
 void BooleanFunction::clamp(const std::size_t i, const bool v) {
-	const pair<State, State> m = demultiplex(i);
-	def = v ? m.second : m.first;
-	--arity;
+	BooleanFunction f = clamped(i, v);
+	swap(*this, f);
 }
 
-pair<State, State> BooleanFunction::demultiplex(const std::size_t i) const {
+/**
+ * Returns the truth table of the function obtained by fixing input @a i to
+ * @a v.
+ *
+ * Tables are processed one block at a time: when a window of entries with
+ * the same value of input @a i is shorter than a block, the selected windows
+ * are packed with a parallel extract (BMI2 @c pext, or a sequence of
+ * shifts and masks), otherwise whole blocks are copied.
+ */
+BooleanFunction::Table BooleanFunction::cofactor(const size_t i, const bool v) const {
 	assert(arity > 0 && i < arity);
-	const size_t windowLength = 1 << i;
-	const size_t numWindows = 1 << (arity - i);
-	size_t index = 0;
-	bool flag = false;
-	State zero, one;
-	for (size_t w = 0; w < numWindows; ++w) {
-		for (size_t j = 0; j < windowLength; ++j, ++index) {
-			if (flag)
-				one.push_back(def[index]);
-			else
-				zero.push_back(def[index]);
+	const Table& t = *table;
+	Table res((t.size() + 1) / 2);
+	if (i < LOG_BLOCK_BITS) {
+		const size_t shift = size_t(1) << i;
+		const size_t half = BLOCK_BITS / 2;
+		for (size_t w = 0; w < t.size(); ++w) {
+			const State::block_type x = v ? t[w] >> shift : t[w];
+#if defined(__BMI2__)
+			const State::block_type packed = _pext_u64(x, ZERO_MASKS[i]);
+#else
+			State::block_type packed = x & ZERO_MASKS[i];
+			for (size_t j = i; j + 1 < LOG_BLOCK_BITS; ++j)
+				packed = (packed | packed >> (size_t(1) << j)) & ZERO_MASKS[j
+						+ 1];
+#endif
+			res[w / 2] |= packed << (w % 2 * half);
 		}
-		flag = !flag;
+		return res;
+	}
+	const size_t stride = size_t(1) << (i - LOG_BLOCK_BITS);
+	Table::iterator out = res.begin();
+	for (size_t w = v ? stride : 0; w < t.size(); w += 2 * stride)
+		out = copy(t.begin() + w, t.begin() + w + stride, out);
+	return res;
+}
+
+/**
+ * Builds a function of @a arity inputs from the blocks of its table.
+ * @param arity the number of inputs
+ * @param blocks the blocks of the table; they are swapped with an empty array
+ */
+BooleanFunction::BooleanFunction(const size_t arity, Table& blocks) :
+	arity(arity), bits(NULL) {
+	if (arity > MAX_TABLE_ARITY) { // let store() decide about diagrams
+		State t(size_t(1) << arity);
+		boost::from_block_range(blocks.begin(), blocks.end(), t);
+		store(t);
+		return;
+	}
+	const boost::shared_ptr<Table> shared(new Table());
+	shared->swap(blocks);
+	bits = &(*shared)[0];
+	table = shared;
+}
+
+pair<bool, bool> BooleanFunction::isConstant() const {
+	if (diagram) {
+		const bool constant = diagram->isConstant();
+		return make_pair(constant, constant && (*diagram)(boost::uint64_t(0)));
+	}
+	if (threshold)
+		return threshold->isConstant();
+	const Table& t = *table;
+	const State::block_type last = size() % BLOCK_BITS ? (State::block_type(1)
+			<< size() % BLOCK_BITS) - 1 : ~State::block_type(0);
+	bool allZeros = true, allOnes = true;
+	for (size_t w = 0; w < t.size(); ++w) {
+		const State::block_type ones = w + 1 < t.size() ? ~State::block_type(0)
+				: last;
+		allZeros = allZeros && t[w] == 0;
+		allOnes = allOnes && t[w] == ones;
 	}
-	assert(zero.size() == one.size());
-	return make_pair(zero, one);
+	return make_pair(allZeros || allOnes, allOnes);
 }
 
 bool BooleanFunction::operator()(const State& x) const {
 	assert(arity == x.size());
-	size_t index = 0; // index computation is the most expensive operation
-	for (size_t j = 0; j < arity; ++j)
-		index += (1 << j) * x[j];
-	assert(index < def.size());
-	return def[index];
+	if (diagram)
+		return (*diagram)(x);
+	if (threshold)
+		return (*threshold)(x);
+	if (arity == 0)
+		return (*this)[0];
+	// inputs are bits of a single block: that block is the index
+	assert(arity <= BLOCK_BITS);
+	State::block_type index;
+	boost::to_block_range(x, &index);
+	return (*this)[index];
+}
+
+bool BooleanFunction::operator==(const BooleanFunction& other) const {
+	// the representation is a function of the function itself
+	if (threshold || other.threshold)
+		return threshold && other.threshold && (threshold == other.threshold
+				|| *threshold == *other.threshold);
+	if (diagram && other.diagram)
+		return diagram == other.diagram || *diagram == *other.diagram;
+	return !diagram && !other.diagram && (table == other.table || (arity
+			== other.arity && *table == *other.table));
 }
 
 bool BooleanFunction::operator<(const BooleanFunction& other) const {
-	State otherDef(other.def);
-	otherDef.resize(def.size());
-	return def < otherDef;
+	if (threshold || other.threshold) { // threshold functions last
+		if (!threshold || !other.threshold)
+			return !threshold;
+		return *threshold < *other.threshold;
+	}
+	if (diagram || other.diagram) { // tables first, then diagrams
+		if (!diagram || !other.diagram)
+			return !diagram;
+		return *diagram < *other.diagram;
+	}
+	State otherTable = other.tableState();
+	otherTable.resize(size());
+	return tableState() < otherTable;
 }
 
+/**
+ * Prints a function: a table is printed as a string of bits, a diagram as a
+ * list of cubes (see DecisionDiagram::fromCubes()), a threshold function as
+ * a row of a function file (see read_functions()).
+ */
 ostream& operator<<(ostream& out, const BooleanFunction& f) {
-	for (size_t i = 0; i < f.def.size(); ++i)
-		out << f.def[i];
+	if (f.diagram)
+		return out << *f.diagram;
+	if (f.threshold)
+		return out << *f.threshold;
+	for (size_t i = 0; i < f.size(); ++i)
+		out << f[i];
 	return out;
 }
 
 size_t hash_value(const BooleanFunction& f) {
-	return bitset_hash(f.def);
+	if (f.diagram)
+		return hash_value(*f.diagram);
+	if (f.threshold)
+		return hash_value(*f.threshold);
+	return bitset_hash(f.table->begin(), f.table->end(), f.size());
 }
 
 void swap(BooleanFunction& a, BooleanFunction& b) {
 	using std::swap;
-	swap(a.def, b.def);
 	swap(a.arity, b.arity);
+	swap(a.table, b.table);
+	swap(a.bits, b.bits);
+	swap(a.diagram, b.diagram);
+	swap(a.threshold, b.threshold);
+}
+
+/**
+ * Reads node functions, one per row, in the format of the function files of
+ * the network factories.
+ *
+ * A row is either a truth table, that is a whitespace separated list of
+ * \f$2^k\f$ '0' or '1' characters, or a whitespace separated list of cubes
+ * (see DecisionDiagram::fromCubes()) whose disjunction is the function, or a
+ * threshold function. A row is a list of cubes if it contains a token longer
+ * than one character or a '-'. Cubes describe high-arity functions without
+ * writing \f$2^k\f$ entries. A threshold function (see ThresholdFunction)
+ * is a row of the form\n
+ * t \<threshold\> \<tie rule\> \<weight of input 0\> ... \<weight of input
+ * <em>k</em> - 1\>\n
+ * where the tie rule is '0', '1', or '=' followed by the position of the
+ * input whose value is kept, usually the node itself: "t 0 =2 1 -1 1" is a
+ * majority of inputs 0 and 2 against input 1 that keeps the value of input 2
+ * on ties. Empty rows define empty functions, rows starting with '#' are
+ * comments.
+ * @param in an input stream
+ * @return the functions, in order
+ */
+vector<BooleanFunction> read_functions(istream& in) {
+	vector<BooleanFunction> res;
+	string line;
+	while (getline(in, line).good()) {
+		boost::trim(line);
+		if (boost::starts_with(line, "#"))
+			continue;
+		istringstream tokens(line);
+		if (boost::starts_with(line, "t ")) {
+			res.push_back(BooleanFunction(read_threshold(tokens)));
+			continue;
+		}
+		vector<string> row;
+		bool cubes = false;
+		for (string t; tokens >> t;) {
+			cubes = cubes || t.size() > 1 || t == "-";
+			row.push_back(t);
+		}
+		if (cubes) {
+			res.push_back(BooleanFunction(DecisionDiagram::fromCubes(
+					row.front().size(), row)));
+		} else {
+			vector<int> table;
+			for (vector<string>::const_iterator it = row.begin(); it
+					!= row.end(); ++it)
+				table.push_back(*it == "1");
+			res.push_back(BooleanFunction(table));
+		}
+	}
+	return res;
 }
 
 } // namespace bn
@@ -0,0 +1,335 @@
+/*
+ * CompiledNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+
+#include <boost/static_assert.hpp>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/CompiledNetwork.hpp>
+
+using namespace std;
+using boost::uint32_t;
+
+namespace bn {
+
+namespace {
+
+const size_t WORD_BITS = 64;
+
+/**
+ * Template argument of the kernel that reads the arity at run time.
+ */
+const size_t GENERIC_ARITY = size_t(-1);
+
+// states are unpacked with to_block_range()
+BOOST_STATIC_ASSERT(sizeof(State::block_type) == sizeof(CompiledNetwork::word_type));
+
+} // namespace
+
+const size_t CompiledNetwork::MAX_SPECIALIZED_ARITY;
+
+CompiledNetwork::CompiledNetwork(const ImmutableBooleanNetwork& net) {
+	init(net);
+}
+
+CompiledNetwork::CompiledNetwork(const MutableBooleanNetwork& net) {
+	init(net);
+}
+
+template<class Network> void CompiledNetwork::init(const Network& net) {
+	const size_t n = net.size();
+	boost::shared_ptr<Program> p(new Program);
+	vector<uint32_t>& offsets = p->offsets;
+	vector<Bucket>& buckets = p->buckets;
+	ThresholdNodes& thresholds = p->thresholds;
+	state = net.getState();
+	p->held.resize(n);
+	specialized = true;
+	offsets.push_back(0);
+	thresholds.offsets.push_back(0);
+	for (size_t i = 0; i < n; ++i) {
+		vector<size_t> in = net.getInputs(i);
+		const BooleanFunction f = net.getFunction(i);
+		if (f.usesDiagram()) {
+			// evaluated by evalDiagrams(): in no bucket
+			DiagramNode d = { i, vector<uint32_t> (in.begin(), in.end()), f };
+			p->diagrams.push_back(d);
+			offsets.push_back(offsets.back());
+			p->slots.push_back(0);
+			continue;
+		}
+		if (f.usesThreshold() && tableWords(in.size()) > 1) {
+			// evaluated by evalThresholds(): in no bucket
+			thresholds.nodes.push_back(i);
+			thresholds.inputs.insert(thresholds.inputs.end(), in.begin(),
+					in.end());
+			thresholds.offsets.push_back(thresholds.inputs.size());
+			thresholds.functions.push_back(f.toThreshold());
+			offsets.push_back(offsets.back());
+			p->slots.push_back(0);
+			continue;
+		}
+		vector<int> tt = f.truthTable();
+		if (tt.empty()) { // no function: the node is the identity of itself
+			p->held.set(i);
+			in.assign(1, i);
+			tt.push_back(0);
+			tt.push_back(1);
+		}
+		const size_t k = in.size();
+		assert(tt.size() == (size_t(1) << k));
+		offsets.push_back(offsets.back() + k);
+		if (buckets.size() <= k)
+			buckets.resize(k + 1);
+		Bucket& b = buckets[k];
+		p->slots.push_back(b.nodes.size());
+		b.nodes.push_back(i);
+		b.inputs.insert(b.inputs.end(), in.begin(), in.end());
+		const size_t first = b.tables.size();
+		b.tables.resize(first + tableWords(k));
+		for (size_t j = 0; j < tt.size(); ++j)
+			b.tables[first + j / WORD_BITS] |= word_type(tt[j] != 0) << (j
+					% WORD_BITS);
+	}
+	program = p;
+	scratch.in.resize((n + WORD_BITS - 1) / WORD_BITS);
+	scratch.out.resize(scratch.in.size());
+}
+
+/**
+ * Triggers a simulation step.
+ */
+void CompiledNetwork::update() {
+	update(state);
+}
+
+State CompiledNetwork::operator()(const State& s) {
+	State next(size());
+	step(s, next);
+	return next;
+}
+
+/**
+ * Advances a state by one step, without allocating memory once the internal
+ * buffer has grown.
+ * @param s a state
+ */
+void CompiledNetwork::update(State& s) {
+	using std::swap;
+	step(s, next);
+	swap(s, next);
+}
+
+/**
+ * Computes the successor of a state.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ */
+void CompiledNetwork::step(const State& in, State& out) {
+	step(in, out, scratch);
+}
+
+/**
+ * Computes the successor of a state in buffers owned by the caller.
+ *
+ * This method does not modify this network, hence threads may call it
+ * concurrently as long as each of them passes its own @a scratch. No memory
+ * is allocated once @a scratch and @a out have grown.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ * @param scratch the buffers of the step
+ */
+void CompiledNetwork::step(const State& in, State& out,
+		Scratch& scratch) const {
+	assert(in.size() == size() && &in != &out);
+	const size_t words = (size() + WORD_BITS - 1) / WORD_BITS;
+	scratch.in.resize(words);
+	scratch.out.resize(words);
+	out.resize(size());
+	boost::to_block_range(in, scratch.in.begin());
+	eval(scratch, 0, words);
+	boost::from_block_range(scratch.out.begin(), scratch.out.end(), out);
+}
+
+/**
+ * Computes s.out[first] ... s.out[last - 1] from s.in.
+ *
+ * Calls on disjoint ranges write disjoint words, hence they may run
+ * concurrently on the same buffers.
+ */
+void CompiledNetwork::eval(Scratch& s, const size_t first,
+		const size_t last) const {
+	evalBuckets(s, first, last);
+	evalDiagrams(s, first, last);
+	evalThresholds(s, first, last);
+}
+
+/**
+ * Evaluates the nodes of every bucket in s.out[first] ... s.out[last - 1],
+ * and sets the other nodes of these words to false.
+ */
+void CompiledNetwork::evalBuckets(Scratch& s, const size_t first,
+		const size_t last) const {
+	fill(s.out.begin() + first, s.out.begin() + last, 0);
+	const vector<Bucket>& buckets = program->buckets;
+	for (size_t k = 0; k < buckets.size(); ++k) {
+		if (buckets[k].nodes.empty())
+			continue;
+		switch (specialized ? k : GENERIC_ARITY) {
+		case 0:
+			evalBucket<0> (k, s, first, last);
+			break;
+		case 1:
+			evalBucket<1> (k, s, first, last);
+			break;
+		case 2:
+			evalBucket<2> (k, s, first, last);
+			break;
+		case 3:
+			evalBucket<3> (k, s, first, last);
+			break;
+		case 4:
+			evalBucket<4> (k, s, first, last);
+			break;
+		case 5:
+			evalBucket<5> (k, s, first, last);
+			break;
+		case 6:
+			evalBucket<6> (k, s, first, last);
+			break;
+		case 7:
+			evalBucket<7> (k, s, first, last);
+			break;
+		case 8:
+			evalBucket<8> (k, s, first, last);
+			break;
+		default:
+			evalBucket<GENERIC_ARITY> (k, s, first, last);
+		}
+	}
+}
+
+/**
+ * Evaluates the nodes of bucket @a k that belong to s.out[first] ...
+ * s.out[last - 1], which must be zero on entry.
+ *
+ * Template parameter @a K is the arity of the bucket, or GENERIC_ARITY to
+ * read it from @a k: with a constant arity the loop over the inputs of a
+ * node is unrolled. Nodes are processed in increasing order, so that the
+ * bits of an output word are accumulated in a register and stored once.
+ */
+template<size_t K> void CompiledNetwork::evalBucket(const size_t k,
+		Scratch& s, const size_t first, const size_t last) const {
+	BOOST_STATIC_ASSERT(K == GENERIC_ARITY || K <= MAX_SPECIALIZED_ARITY);
+	const size_t arity = K == GENERIC_ARITY ? k : K;
+	const size_t words = tableWords(arity);
+	const Bucket& b = program->buckets[k];
+	const size_t lo = lower_bound(b.nodes.begin(), b.nodes.end(), first
+			* WORD_BITS) - b.nodes.begin();
+	const size_t hi = lower_bound(b.nodes.begin() + lo, b.nodes.end(), last
+			* WORD_BITS) - b.nodes.begin();
+	if (lo == hi)
+		return;
+	const word_type* const src = &s.in[0];
+	const uint32_t* in = b.inputs.empty() ? 0 : &b.inputs[lo * arity];
+	const word_type* tt = &b.tables[lo * words];
+	size_t w = b.nodes[lo] / WORD_BITS;
+	word_type acc = 0;
+	for (size_t p = lo; p < hi; ++p, in += arity, tt += words) {
+		const size_t v = b.nodes[p];
+		if (v / WORD_BITS != w) {
+			s.out[w] |= acc;
+			acc = 0;
+			w = v / WORD_BITS;
+		}
+		word_type index = 0;
+		for (size_t j = 0; j < arity; ++j)
+			index |= ((src[in[j] / WORD_BITS] >> (in[j] % WORD_BITS)) & 1) << j;
+		const word_type bit = arity <= 6 ? tt[0] >> index : tt[index
+				/ WORD_BITS] >> (index % WORD_BITS);
+		acc |= (bit & 1) << (v % WORD_BITS);
+	}
+	s.out[w] |= acc;
+}
+
+/**
+ * Evaluates the nodes whose function is a decision diagram, which
+ * evalBuckets() sets to false, in s.out[first] ... s.out[last - 1].
+ */
+void CompiledNetwork::evalDiagrams(Scratch& s, const size_t first,
+		const size_t last) const {
+	const vector<DiagramNode>& diagrams = program->diagrams;
+	for (vector<DiagramNode>::const_iterator it = diagrams.begin(); it
+			!= diagrams.end(); ++it) {
+		if (it->node / WORD_BITS < first || it->node / WORD_BITS >= last)
+			continue;
+		word_type index = 0;
+		for (size_t k = 0; k < it->inputs.size(); ++k)
+			index |= ((s.in[it->inputs[k] / WORD_BITS] >> (it->inputs[k]
+					% WORD_BITS)) & 1) << k;
+		s.out[it->node / WORD_BITS] |= word_type(it->function[index])
+				<< (it->node % WORD_BITS);
+	}
+}
+
+/**
+ * Evaluates the nodes whose function is a threshold function, which
+ * evalBuckets() sets to false, in s.out[first] ... s.out[last - 1].
+ */
+void CompiledNetwork::evalThresholds(Scratch& s, const size_t first,
+		const size_t last) const {
+	const ThresholdNodes& t = program->thresholds;
+	const size_t lo = lower_bound(t.nodes.begin(), t.nodes.end(), first
+			* WORD_BITS) - t.nodes.begin();
+	const size_t hi = lower_bound(t.nodes.begin() + lo, t.nodes.end(), last
+			* WORD_BITS) - t.nodes.begin();
+	for (size_t p = lo; p < hi; ++p) {
+		word_type index = 0;
+		for (size_t k = t.offsets[p], j = 0; k < t.offsets[p + 1]; ++k, ++j)
+			index |= ((s.in[t.inputs[k] / WORD_BITS] >> (t.inputs[k]
+					% WORD_BITS)) & 1) << j;
+		s.out[t.nodes[p] / WORD_BITS] |= word_type(t.functions[p](index))
+				<< (t.nodes[p] % WORD_BITS);
+	}
+}
+
+BooleanFunction CompiledNetwork::getFunction(const size_t i) const {
+	assert(i < size());
+	const vector<DiagramNode>& diagrams = program->diagrams;
+	const ThresholdNodes& thresholds = program->thresholds;
+	for (vector<DiagramNode>::const_iterator it = diagrams.begin(); it
+			!= diagrams.end(); ++it)
+		if (it->node == i)
+			return it->function;
+	const vector<uint32_t>::const_iterator it = lower_bound(
+			thresholds.nodes.begin(), thresholds.nodes.end(), i);
+	if (it != thresholds.nodes.end() && *it == i)
+		return BooleanFunction(thresholds.functions[it
+				- thresholds.nodes.begin()]);
+	vector<int> tt;
+	if (!program->held[i]) {
+		const size_t k = program->offsets[i + 1] - program->offsets[i];
+		const word_type* const t = &program->buckets[k].tables[program->slots[i]
+				* tableWords(k)];
+		for (size_t j = 0; j < (size_t(1) << k); ++j)
+			tt.push_back((t[j / WORD_BITS] >> (j % WORD_BITS)) & 1);
+	}
+	return BooleanFunction(tt);
+}
+
+vector<size_t> CompiledNetwork::bucketSizes() const {
+	vector<size_t> sizes;
+	for (size_t k = 0; k < program->buckets.size(); ++k)
+		sizes.push_back(program->buckets[k].nodes.size());
+	return sizes;
+}
+
+} // namespace bn
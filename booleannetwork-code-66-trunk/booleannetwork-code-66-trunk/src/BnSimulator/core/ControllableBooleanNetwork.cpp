@@ -32,8 +32,7 @@ ControllableBooleanNetwork::ControllableBooleanNetwork(
 	assert(getInput().none() && getOutput().none());
 	for (size_t i = 0; i < inputs; ++i) {
 		remove_in_edge_if(i, AlwaysTrue(), net);
-		TruthTable empty;
-		swap(net[i], empty);
+		net[i] = TruthTable(vector<int> ()); // no function: hold value
 	}
 }
 
@@ -50,53 +49,42 @@ void ControllableBooleanNetwork::setState(const State& s) {
 }
 
 void ControllableBooleanNetwork::update() {
-	using std::swap;
-	State next(state);
+	update(state);
+}
+
+/**
+ * Computes the successor of a state; input nodes keep their value.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ */
+void ControllableBooleanNetwork::step(const State& in, State& out) {
+	assert(in.size() == size() && &in != &out);
+	out.resize(size());
+	for (size_t i = 0; i < inputs; ++i)
+		out[i] = in[i];
 	Network::vertex_iterator vi, vend;
 	tie(vi, vend) = vertices(net);
 	for (vi += inputs; vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
+		boost::uint64_t index = 0; // index computation is the most expensive operation
 		size_t j = 0;
 		Network::inv_adjacency_iterator it, end;
 		for (tie(it, end) = inv_adjacent_vertices(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * state[*it];
+			index |= boost::uint64_t(in[*it]) << j;
 		}
-		next[*vi] = net[*vi][index]; // vertex descriptors are integers
+		out[*vi] = net[*vi][index]; // vertex descriptors are integers
 	}
-	swap(state, next);
 }
 
 void ControllableBooleanNetwork::update(State& s) {
 	using std::swap;
-	State next(s);
-	Network::vertex_iterator vi, vend;
-	tie(vi, vend) = vertices(net);
-	for (vi += inputs; vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
-		size_t j = 0;
-		Network::inv_adjacency_iterator it, end;
-		for (tie(it, end) = inv_adjacent_vertices(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * s[*it];
-		}
-		next[*vi] = net[*vi][index]; // vertex descriptors are integers
-	}
+	step(s, next);
 	swap(s, next);
 }
 
 State ControllableBooleanNetwork::operator()(const State& s) {
-	using std::swap;
-	State next(s);
-	Network::vertex_iterator vi, vend;
-	tie(vi, vend) = vertices(net);
-	for (vi += inputs; vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
-		size_t j = 0;
-		Network::inv_adjacency_iterator it, end;
-		for (tie(it, end) = inv_adjacent_vertices(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * s[*it];
-		}
-		next[*vi] = net[*vi][index]; // vertex descriptors are integers
-	}
+	State next(size());
+	step(s, next);
 	return next;
 }
 
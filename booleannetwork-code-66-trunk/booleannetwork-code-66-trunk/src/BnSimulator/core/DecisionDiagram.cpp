@@ -0,0 +1,319 @@
+/*
+ * DecisionDiagram.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <BnSimulator/core/DecisionDiagram.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+const DecisionDiagram::node_id NO_NODE = DecisionDiagram::node_id(-1);
+
+struct NodeHash {
+	size_t operator()(const DecisionDiagram::Node& n) const {
+		size_t h = 0;
+		boost::hash_combine(h, n.var);
+		boost::hash_combine(h, n.lo);
+		boost::hash_combine(h, n.hi);
+		return h;
+	}
+};
+
+bool less_node(const DecisionDiagram::Node& a, const DecisionDiagram::Node& b) {
+	if (a.var != b.var)
+		return a.var < b.var;
+	if (a.lo != b.lo)
+		return a.lo < b.lo;
+	return a.hi < b.hi;
+}
+
+} // namespace
+
+/**
+ * Pool of unique nodes used while a diagram is built.
+ */
+class DecisionDiagram::Builder {
+public:
+	vector<Node> nodes;
+
+	Builder() {
+		const Node f = { NO_NODE, FALSE_NODE, FALSE_NODE };
+		const Node t = { NO_NODE, TRUE_NODE, TRUE_NODE };
+		nodes.push_back(f);
+		nodes.push_back(t);
+	}
+
+	/**
+	 * Returns the unique node testing @a var, creating it if needed.
+	 */
+	node_id mk(const node_id var, const node_id lo, const node_id hi) {
+		if (lo == hi)
+			return lo;
+		const Node n = { var, lo, hi };
+		const pair<Unique::iterator, bool> p = unique.insert(make_pair(n,
+				node_id(nodes.size())));
+		if (p.second)
+			nodes.push_back(n);
+		return p.first->second;
+	}
+
+	/**
+	 * Disjunction of two nodes of this pool.
+	 */
+	node_id disjoin(const node_id a, const node_id b) {
+		if (a == TRUE_NODE || b == TRUE_NODE)
+			return TRUE_NODE;
+		if (a == FALSE_NODE || a == b)
+			return b;
+		if (b == FALSE_NODE)
+			return a;
+		const pair<node_id, node_id> key(min(a, b), max(a, b));
+		const Memo::const_iterator it = memo.find(key);
+		if (it != memo.end())
+			return it->second;
+		const Node na = nodes[a], nb = nodes[b];
+		// terminals were handled above, so both vars are valid
+		const node_id var = max(na.var, nb.var);
+		const node_id lo = disjoin(na.var == var ? na.lo : a,
+				nb.var == var ? nb.lo : b);
+		const node_id hi = disjoin(na.var == var ? na.hi : a,
+				nb.var == var ? nb.hi : b);
+		const node_id res = mk(var, lo, hi);
+		memo[key] = res;
+		return res;
+	}
+
+	/**
+	 * Builds the node of a slice of a truth table.
+	 */
+	node_id fromTable(const State& table, const size_t offset,
+			const size_t level) {
+		if (level == 0)
+			return table[offset] ? TRUE_NODE : FALSE_NODE;
+		const node_id lo = fromTable(table, offset, level - 1);
+		const node_id hi = fromTable(table, offset + (size_t(1) << (level - 1)),
+				level - 1);
+		return mk(level - 1, lo, hi);
+	}
+
+private:
+	typedef boost::unordered_map<Node, node_id, NodeHash> Unique;
+	typedef boost::unordered_map<pair<node_id, node_id>, node_id> Memo;
+
+	Unique unique;
+	Memo memo;
+};
+
+/**
+ * Constructs a constant function.
+ * @param value the value of the function
+ * @param arity the number of (ignored) inputs
+ */
+DecisionDiagram::DecisionDiagram(const bool value, const size_t arity) :
+	arity(arity), nodes(Builder().nodes), root(value ? TRUE_NODE : FALSE_NODE) {
+}
+
+/**
+ * Copies the nodes reachable from @a root in canonical order.
+ */
+DecisionDiagram::DecisionDiagram(const size_t arity, const Builder& b,
+		const node_id root) :
+	arity(arity) {
+	vector<node_id> remap(b.nodes.size(), NO_NODE);
+	remap[FALSE_NODE] = FALSE_NODE;
+	remap[TRUE_NODE] = TRUE_NODE;
+	nodes.assign(b.nodes.begin(), b.nodes.begin() + 2);
+	// iterative post-order visit, low branch first
+	vector<pair<node_id, bool> > stack(1, make_pair(root, false));
+	while (!stack.empty()) {
+		const pair<node_id, bool> top = stack.back();
+		stack.pop_back();
+		if (remap[top.first] != NO_NODE)
+			continue;
+		const Node& n = b.nodes[top.first];
+		if (top.second) {
+			const Node copy = { n.var, remap[n.lo], remap[n.hi] };
+			remap[top.first] = nodes.size();
+			nodes.push_back(copy);
+		} else {
+			stack.push_back(make_pair(top.first, true));
+			stack.push_back(make_pair(n.hi, false));
+			stack.push_back(make_pair(n.lo, false));
+		}
+	}
+	this->root = remap[root];
+}
+
+/**
+ * Builds the diagram of a truth table.
+ * @param table a truth table of \f$2^k\f$ entries, entry @e i being the value
+ * 	of the function when its inputs are the bits of @e i
+ * @return a diagram of arity @e k
+ */
+DecisionDiagram DecisionDiagram::fromTable(const State& table) {
+	size_t arity = 0;
+	while ((size_t(1) << arity) < table.size())
+		++arity;
+	assert(table.size() == (size_t(1) << arity));
+	Builder b;
+	const node_id root = b.fromTable(table, 0, arity);
+	return DecisionDiagram(arity, b, root);
+}
+
+DecisionDiagram DecisionDiagram::fromTable(const vector<int>& table) {
+	State s(table.size());
+	for (size_t i = 0; i < table.size(); ++i)
+		s[i] = table[i] != 0;
+	return fromTable(s);
+}
+
+/**
+ * Builds the diagram of a disjunction of cubes.
+ *
+ * A cube is a string of @a arity characters: the <em>j</em>-th character is
+ * '1' if input @e j must be true, '0' if it must be false, and '-' if it is
+ * not constrained. For instance, with @a arity equal to 3, cubes "1-0" and
+ * "-11" describe \f$(x_0 \wedge \neg x_2) \vee (x_1 \wedge x_2)\f$.
+ * @param arity the number of inputs
+ * @param cubes the cubes of the disjunction
+ * @return a diagram of arity @a arity
+ */
+DecisionDiagram DecisionDiagram::fromCubes(const size_t arity, const vector<
+		string>& cubes) {
+	Builder b;
+	node_id acc = FALSE_NODE;
+	for (vector<string>::const_iterator it = cubes.begin(); it != cubes.end(); ++it) {
+		assert(it->size() == arity);
+		node_id cube = TRUE_NODE; // built bottom-up, lowest variable first
+		for (size_t j = 0; j < arity; ++j) {
+			assert((*it)[j] == '0' || (*it)[j] == '1' || (*it)[j] == '-');
+			if ((*it)[j] == '1')
+				cube = b.mk(j, FALSE_NODE, cube);
+			else if ((*it)[j] == '0')
+				cube = b.mk(j, cube, FALSE_NODE);
+		}
+		acc = b.disjoin(acc, cube);
+	}
+	return DecisionDiagram(arity, b, acc);
+}
+
+bool DecisionDiagram::operator()(const State& x) const {
+	assert(x.size() == arity);
+	node_id n = root;
+	while (n > TRUE_NODE) {
+		const Node& node = nodes[n];
+		n = x[node.var] ? node.hi : node.lo;
+	}
+	return n == TRUE_NODE;
+}
+
+/**
+ * Tells whether input @a i affects the value of this function.
+ *
+ * Since the diagram is reduced, this is the case if and only if some node
+ * tests it.
+ */
+bool DecisionDiagram::dependsOn(const size_t i) const {
+	assert(i < arity);
+	for (size_t n = TRUE_NODE + 1; n < nodes.size(); ++n)
+		if (nodes[n].var == i)
+			return true;
+	return false;
+}
+
+/**
+ * Returns the function of @a arity - 1 inputs obtained by fixing input
+ * @a i to @a v; inputs after @a i are shifted down by one.
+ */
+DecisionDiagram DecisionDiagram::clamped(const size_t i, const bool v) const {
+	assert(arity > 0 && i < arity);
+	Builder b;
+	// children precede their parents, so a single forward pass suffices
+	vector<node_id> remap(nodes.size());
+	remap[FALSE_NODE] = FALSE_NODE;
+	remap[TRUE_NODE] = TRUE_NODE;
+	for (size_t n = TRUE_NODE + 1; n < nodes.size(); ++n) {
+		const Node& node = nodes[n];
+		if (node.var == i)
+			remap[n] = remap[v ? node.hi : node.lo];
+		else
+			remap[n] = b.mk(node.var > i ? node.var - 1 : node.var,
+					remap[node.lo], remap[node.hi]);
+	}
+	return DecisionDiagram(arity - 1, b, remap[root]);
+}
+
+/**
+ * Expands this diagram into a truth table.
+ * @return a truth table of \f$2^k\f$ entries
+ */
+State DecisionDiagram::table() const {
+	assert(arity < sizeof(size_t) * 8 - 1);
+	State t(size_t(1) << arity);
+	for (size_t i = 0; i < t.size(); ++i)
+		t[i] = (*this)(boost::uint64_t(i));
+	return t;
+}
+
+bool DecisionDiagram::operator<(const DecisionDiagram& other) const {
+	if (arity != other.arity)
+		return arity < other.arity;
+	if (root != other.root)
+		return root < other.root;
+	return lexicographical_compare(nodes.begin(), nodes.end(),
+			other.nodes.begin(), other.nodes.end(), less_node);
+}
+
+void DecisionDiagram::printCubes(ostream& out, const node_id n, string& cube,
+		bool& first) const {
+	if (n == FALSE_NODE)
+		return;
+	if (n == TRUE_NODE) {
+		out << (first ? "" : " ") << cube;
+		first = false;
+		return;
+	}
+	const Node& node = nodes[n];
+	cube[node.var] = '0';
+	printCubes(out, node.lo, cube, first);
+	cube[node.var] = '1';
+	printCubes(out, node.hi, cube, first);
+	cube[node.var] = '-';
+}
+
+/**
+ * Prints a diagram as a list of disjoint cubes (see fromCubes()), or as "0"
+ * if it is constantly false.
+ */
+ostream& operator<<(ostream& out, const DecisionDiagram& d) {
+	if (d.root == DecisionDiagram::FALSE_NODE)
+		return out << '0';
+	string cube(d.arity, '-');
+	bool first = true;
+	d.printCubes(out, d.root, cube, first);
+	return out;
+}
+
+size_t hash_value(const DecisionDiagram& d) {
+	size_t h = d.arity;
+	boost::hash_combine(h, d.root);
+	for (vector<DecisionDiagram::Node>::const_iterator it = d.nodes.begin(); it
+			!= d.nodes.end(); ++it)
+		boost::hash_combine(h, NodeHash()(*it));
+	return h;
+}
+
+} // namespace bn
@@ -0,0 +1,120 @@
+/*
+ * FunctionPool.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <BnSimulator/core/FunctionPool.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+/**
+ * Purges are not worth it below this size.
+ */
+const size_t MIN_PURGE = 1024;
+
+} // namespace
+
+FunctionPool::FunctionPool() :
+	lookups(0), hits(0), purged(0) {
+}
+
+/**
+ * Returns a function equal to @a f which shares its storage with all the
+ * other functions interned by this pool that are equal to @a f.
+ * @param f a function
+ * @return @a f, or the equal function already in this pool
+ */
+BooleanFunction FunctionPool::intern(const BooleanFunction& f) {
+	boost::mutex::scoped_lock lock(mutex);
+	++lookups;
+	const pair<boost::unordered_set<BooleanFunction>::iterator, bool> p =
+			pool.insert(f);
+	if (!p.second) {
+		++hits;
+		return *p.first;
+	}
+	if (pool.size() >= 2 * max(purged, MIN_PURGE)) {
+		lock.unlock();
+		purge();
+	}
+	return f;
+}
+
+/**
+ * Releases the functions that are referenced only by this pool.
+ */
+void FunctionPool::purge() {
+	boost::mutex::scoped_lock lock(mutex);
+	for (boost::unordered_set<BooleanFunction>::iterator it = pool.begin(); it
+			!= pool.end();) {
+		if ((it->table ? it->table.use_count() : it->diagram
+				? it->diagram.use_count() : it->threshold.use_count()) == 1)
+			it = pool.erase(it);
+		else
+			++it;
+	}
+	purged = pool.size();
+}
+
+size_t FunctionPool::size() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return pool.size();
+}
+
+/**
+ * Returns the number of bytes used by the truth tables, diagrams and weights
+ * of the functions in this pool.
+ * @return a memory footprint
+ */
+size_t FunctionPool::memory() const {
+	boost::mutex::scoped_lock lock(mutex);
+	size_t res = 0;
+	for (boost::unordered_set<BooleanFunction>::const_iterator it =
+			pool.begin(); it != pool.end(); ++it)
+		res += it->table ? it->table->size() * sizeof(State::block_type)
+				: it->diagram ? it->diagram->memory() : it->threshold->memory();
+	return res;
+}
+
+/**
+ * Returns the distinct functions in this pool, so that per-function analyses
+ * can run once for each of them.
+ * @return the functions in this pool, in no particular order
+ */
+vector<BooleanFunction> FunctionPool::functions() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return vector<BooleanFunction> (pool.begin(), pool.end());
+}
+
+/**
+ * Returns the pool used by the network factories.
+ * @return a process-wide pool
+ */
+FunctionPool& FunctionPool::global() {
+	static FunctionPool pool;
+	return pool;
+}
+
+/**
+ * Interns a list of functions.
+ * @param functions some functions
+ * @param pool the pool to use
+ * @return the interned functions, in the same order
+ */
+vector<BooleanFunction> intern_functions(const vector<BooleanFunction>& functions,
+		FunctionPool& pool) {
+	vector<BooleanFunction> res;
+	res.reserve(functions.size());
+	for (vector<BooleanFunction>::const_iterator it = functions.begin(); it
+			!= functions.end(); ++it)
+		res.push_back(pool.intern(*it));
+	return res;
+}
+
+} // namespace bn
@@ -0,0 +1,360 @@
+/*
+ * GeneratedNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/GeneratedNetwork.hpp>
+
+#ifndef BN_CODEGEN_CXX
+#define BN_CODEGEN_CXX "c++"
+#endif
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+const size_t WORD_BITS = 64;
+
+const char STEP_SYMBOL[] = "bn_generated_step";
+
+const char SIZE_SYMBOL[] = "bn_generated_size";
+
+const char KEY_SYMBOL[] = "bn_generated_key";
+
+/**
+ * 64-bit FNV-1a hash of a string.
+ */
+boost::uint64_t fnv1a(const string& s) {
+	boost::uint64_t h = 14695981039346656037ULL;
+	for (string::const_iterator it = s.begin(); it != s.end(); ++it) {
+		h ^= static_cast<unsigned char> (*it);
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+string getenvOr(const char name[], const string& otherwise) {
+	const char* const value = getenv(name);
+	return value != NULL && *value != '\0' ? string(value) : otherwise;
+}
+
+/**
+ * Returns the directory of cached objects, which is private to the user.
+ */
+string cacheDirectory() {
+	ostringstream shared;
+	shared << "/tmp/bn-codegen-" << geteuid();
+	const char* const xdg = getenv("XDG_CACHE_HOME");
+	return getenvOr("BN_CODEGEN_CACHE", xdg != NULL && *xdg == '/' ? string(
+			xdg) + "/bn-codegen" : shared.str());
+}
+
+/**
+ * Tells whether @a path may be trusted: it must be of type @a type (not a
+ * symbolic link), owned by the effective user, and neither group- nor
+ * world-writable, so that no other user can have planted or replaced it.
+ * @param path a path
+ * @param type @c S_IFDIR or @c S_IFREG
+ * @return @e true if the file is trusted; @c errno is @c ENOENT if it does
+ * 	not exist
+ */
+bool trusted(const string& path, const mode_t type) {
+	struct stat st;
+	if (lstat(path.c_str(), &st) != 0)
+		return false;
+	errno = 0;
+	return (st.st_mode & S_IFMT) == type && st.st_uid == geteuid()
+			&& (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+/**
+ * Writes @a s as a C string literal, one line of @a s per line.
+ */
+void emitString(ostream& out, const string& s) {
+	out << '"';
+	for (string::const_iterator it = s.begin(); it != s.end(); ++it) {
+		switch (*it) {
+		case '\\':
+			out << "\\\\";
+			break;
+		case '"':
+			out << "\\\"";
+			break;
+		case '\t':
+			out << "\\t";
+			break;
+		case '\n':
+			out << "\\n\"\n\t\"";
+			break;
+		default:
+			out << *it;
+		}
+	}
+	out << '"';
+}
+
+/**
+ * Compiles @a cpp into the shared object @a so with the compiler @a cxx,
+ * whose output goes to @a log.
+ *
+ * The compiler is run without a shell, hence paths are passed as they are.
+ * @return @e true if the compiler succeeded
+ */
+bool compile(const string& cxx, const string& so, const string& cpp,
+		const string& log) {
+	const char* const argv[] = { cxx.c_str(), "-O2", "-shared", "-fPIC",
+			"-o", so.c_str(), cpp.c_str(), NULL };
+	const int out = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	if (out < 0)
+		return false;
+	const pid_t child = fork();
+	if (child == 0) {
+		dup2(out, STDOUT_FILENO);
+		dup2(out, STDERR_FILENO);
+		close(out);
+		execvp(argv[0], const_cast<char* const *> (argv));
+		_exit(127);
+	}
+	close(out);
+	int status;
+	return child > 0 && waitpid(child, &status, 0) == child
+			&& WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+void closeLibrary(void* handle) {
+	if (handle != NULL)
+		dlclose(handle);
+}
+
+/**
+ * Writes the expression of bit @a i of the state array @a s.
+ */
+void emitBit(ostream& out, const size_t i) {
+	out << "((s[" << i / WORD_BITS << "] >> " << i % WORD_BITS << ") & 1)";
+}
+
+} // namespace
+
+GeneratedNetwork::GeneratedNetwork(const ImmutableBooleanNetwork& net) :
+	interpreted(net), function(NULL) {
+	init(net);
+}
+
+GeneratedNetwork::GeneratedNetwork(const MutableBooleanNetwork& net) :
+	interpreted(net), function(NULL) {
+	init(net);
+}
+
+/**
+ * Loads the shared object of a network, compiling it if it is not cached.
+ *
+ * Any failure leaves function set to NULL.
+ */
+template<class Network> void GeneratedNetwork::init(const Network& net) {
+	state = net.getState();
+	inWords.resize((size() + WORD_BITS - 1) / WORD_BITS);
+	outWords.resize(inWords.size());
+	for (size_t i = 0; i < size(); ++i)
+		if (net.getFunction(i).usesDiagram()
+				|| net.getFunction(i).usesThreshold())
+			return; // not supported by the generator
+	ostringstream source;
+	generateSource(net, source);
+	const string dir = cacheDirectory();
+	const string cxx = getenvOr("BN_CXX", BN_CODEGEN_CXX);
+	// the flags of compile(); the key is embedded in the object, which is
+	// named after a hash of its source, and compared after loading
+	const string flags = "-O2 -shared -fPIC";
+	const string key = cxx + ' ' + flags + '\n' + source.str();
+	ostringstream text;
+	text << source.str() << "\nextern \"C\" const char " << KEY_SYMBOL
+			<< "[] =\n\t";
+	emitString(text, key);
+	text << ";\n";
+	ostringstream name;
+	name << dir << '/' << hex << setw(16) << setfill('0') << fnv1a(text.str());
+	const string so = name.str() + ".so";
+	mkdir(dir.c_str(), 0700);
+	if (!trusted(dir, S_IFDIR))
+		return; // never load code from a directory others can write to
+	if (!trusted(so, S_IFREG)) {
+		if (errno != ENOENT)
+			return; // someone else's object
+		const string cpp = name.str() + ".cpp";
+		ofstream file(cpp.c_str());
+		file << text.str();
+		file.close();
+		if (!file)
+			return;
+		// build under a unique name and rename, so that concurrent processes
+		// never load a partially written object
+		ostringstream tmp;
+		tmp << so << '.' << getpid();
+		if (!compile(cxx, tmp.str(), cpp, name.str() + ".log") || rename(
+				tmp.str().c_str(), so.c_str()) != 0) {
+			remove(tmp.str().c_str());
+			return;
+		}
+		if (!trusted(so, S_IFREG))
+			return;
+	}
+	void* const h = dlopen(so.c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (h == NULL)
+		return;
+	handle.reset(h, closeLibrary);
+	const unsigned long* n = static_cast<const unsigned long*> (dlsym(h,
+			SIZE_SYMBOL));
+	const char* k = static_cast<const char*> (dlsym(h, KEY_SYMBOL));
+	void* f = dlsym(h, STEP_SYMBOL);
+	// the name is only a 64-bit hash: check that the object is really ours
+	if (n == NULL || *n != size() || k == NULL || key != k || f == NULL) {
+		handle.reset();
+		return;
+	}
+	// POSIX guarantees that object and function pointers convert
+	*reinterpret_cast<void**> (&function) = f;
+	library = so;
+}
+
+/**
+ * Triggers a simulation step.
+ */
+void GeneratedNetwork::update() {
+	update(state);
+}
+
+State GeneratedNetwork::operator()(const State& s) {
+	State next(size());
+	step(s, next);
+	return next;
+}
+
+void GeneratedNetwork::update(State& s) {
+	using std::swap;
+	step(s, next);
+	swap(s, next);
+}
+
+/**
+ * Computes the successor of a state.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ */
+void GeneratedNetwork::step(const State& in, State& out) {
+	if (function == NULL) {
+		interpreted.step(in, out);
+		return;
+	}
+	assert(in.size() == size() && &in != &out);
+	out.resize(size());
+	boost::to_block_range(in, inWords.begin());
+	function(&inWords[0], &outWords[0]);
+	boost::from_block_range(outWords.begin(), outWords.end(), out);
+}
+
+/**
+ * Writes the source code of the step function of a network.
+ *
+ * The code defines two symbols with C linkage: the number of nodes and a
+ * function that reads the current state as an array of 64-bit words (node
+ * @e i is bit <em>i</em> % 64 of word <em>i</em> / 64) and writes the next
+ * state in the same format. Each node is a single expression: its truth
+ * table, as an integer constant when it has at most 64 entries or as a
+ * static array otherwise, is shifted by the index built from its inputs.
+ * @param net a network
+ * @param out the stream to write to
+ */
+void GeneratedNetwork::generate(const ImmutableBooleanNetwork& net,
+		ostream& out) {
+	generateSource(net, out);
+}
+
+void GeneratedNetwork::generate(const MutableBooleanNetwork& net, ostream& out) {
+	generateSource(net, out);
+}
+
+template<class Network> void GeneratedNetwork::generateSource(
+		const Network& net, ostream& out) {
+	typedef boost::uint64_t word;
+	const size_t n = net.size();
+	ostringstream tables, body;
+	for (size_t i = 0; i < n; ++i) {
+		if (i % WORD_BITS == 0)
+			body << "\tw = 0;\n";
+		const vector<size_t> in = net.getInputs(i);
+		const vector<int> tt = net.getFunction(i).truthTable();
+		body << "\tw |= ";
+		if (tt.empty()) { // no function: hold value
+			emitBit(body, i);
+		} else if (in.empty()) {
+			body << (tt[0] != 0 ? "UINT64_C(1)" : "UINT64_C(0)");
+		} else {
+			// index of the truth table entry
+			ostringstream index;
+			for (size_t j = 0; j < in.size(); ++j) {
+				if (j > 0)
+					index << " | ";
+				emitBit(index, in[j]);
+				if (j > 0)
+					index << " << " << j;
+			}
+			if (tt.size() <= WORD_BITS) {
+				word mask = 0;
+				for (size_t j = 0; j < tt.size(); ++j)
+					mask |= word(tt[j] != 0) << j;
+				body << "((UINT64_C(0x" << hex << mask << dec << ") >> ("
+						<< index.str() << ")) & 1)";
+			} else {
+				tables << "static const uint64_t t" << i << "[] = {";
+				for (size_t w = 0; w < tt.size() / WORD_BITS; ++w) {
+					word mask = 0;
+					for (size_t j = 0; j < WORD_BITS; ++j)
+						mask |= word(tt[w * WORD_BITS + j] != 0) << j;
+					tables << (w % 4 == 0 ? "\n\t" : " ") << "UINT64_C(0x" << hex
+							<< mask << dec << "),";
+				}
+				tables << "\n};\n\n";
+				body << "table(t" << i << ", " << index.str() << ")";
+			}
+		}
+		body << " << " << i % WORD_BITS << ";\n";
+		if (i % WORD_BITS == WORD_BITS - 1 || i == n - 1)
+			body << "\to[" << i / WORD_BITS << "] = w;\n";
+	}
+	out << "// generated by bn::GeneratedNetwork\n";
+	out << "#include <stdint.h>\n\n";
+	out << "static inline uint64_t table(const uint64_t* t, const uint64_t x) {\n";
+	out << "\treturn (t[x >> 6] >> (x & 63)) & 1;\n";
+	out << "}\n\n";
+	out << tables.str();
+	out << "extern \"C\" const unsigned long " << SIZE_SYMBOL << " = " << n
+			<< "UL;\n\n";
+	out << "extern \"C\" void " << STEP_SYMBOL
+			<< "(const uint64_t* s, uint64_t* o) {\n";
+	out << "\tuint64_t w;\n";
+	out << body.str();
+	out << "}\n";
+}
+
+} // namespace bn
@@ -13,6 +13,7 @@
 
 #include <BnSimulator/util/printing.hpp>
 #include <BnSimulator/util/JaggedArray.hpp>
+#include <BnSimulator/core/FunctionPool.hpp>
 #include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
 
 using namespace std;
@@ -22,62 +23,114 @@ namespace bn {
 
 /**
  * Triggers a simulation step.
+ */
+void ImmutableBooleanNetwork::update() {
+	using std::swap;
+	if (!isReordered())
+		eval(state, next);
+	else
+		step(state, next, scratch);
+	swap(state, next);
+}
+
+/**
+ * Computes the successor of a state without modifying this network.
  *
  * @note
  * From an implementation point of view, this is @e the most expensive piece
  * of code in the whole library.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
  */
-void ImmutableBooleanNetwork::update() {
-	using std::swap;
-	State next(size());
+void ImmutableBooleanNetwork::step(const State& in, State& out) {
+	step(in, out, scratch);
+}
+
+/**
+ * Computes the successor of a state in buffers owned by the caller.
+ *
+ * This method does not modify this network, hence threads may call it
+ * concurrently as long as each of them passes its own @a scratch, which is
+ * only used by reordered networks.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ * @param scratch the buffers of the step
+ */
+void ImmutableBooleanNetwork::step(const State& in, State& out,
+		Scratch& scratch) const {
+	assert(in.size() == size() && &in != &out);
+	if (!isReordered()) {
+		eval(in, out);
+		return;
+	}
+	permuteIn(in, scratch.in);
+	eval(scratch.in, scratch.out);
+	permuteOut(scratch.out, out);
+}
+
+/**
+ * Computes the successor of a state in the internal numbering.
+ */
+void ImmutableBooleanNetwork::eval(const State& in, State& out) const {
+	const Network& net = graph->net;
+	out.resize(size());
 	Network::vertex_iterator vi, vend;
 	for (tie(vi, vend) = vertices(net); vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
+		boost::uint64_t index = 0; // index computation is the most expensive operation
 		size_t j = 0;
 		Network::out_edge_iterator it, end;
 		for (tie(it, end) = out_edges(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * state[target(*it, net)];
+			index |= boost::uint64_t(in[target(*it, net)]) << j;
 		}
-		next[*vi] = net[*vi][index];
+		out[*vi] = net[*vi][index];
 	}
-	swap(state, next);
 }
 
 State ImmutableBooleanNetwork::operator()(const State& s) {
-	using std::swap;
 	State next(size());
-	Network::vertex_iterator vi, vend;
-	for (tie(vi, vend) = vertices(net); vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
-		size_t j = 0;
-		Network::out_edge_iterator it, end;
-		for (tie(it, end) = out_edges(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * s[target(*it, net)];
-		}
-		next[*vi] = net[*vi][index];
-	}
+	step(s, next);
 	return next;
 }
 
+/**
+ * Advances a state by one step.
+ *
+ * The next state is computed into an internal buffer which is then swapped
+ * with @a s, so that no memory is allocated once the buffer has grown.
+ * @param s a state
+ */
 void ImmutableBooleanNetwork::update(State& s) {
 	using std::swap;
-	State next(size());
-	Network::vertex_iterator vi, vend;
-	for (tie(vi, vend) = vertices(net); vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
-		size_t j = 0;
-		Network::out_edge_iterator it, end;
-		for (tie(it, end) = out_edges(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * s[target(*it, net)];
-		}
-		next[*vi] = net[*vi][index];
-	}
+	step(s, next);
 	swap(s, next);
 }
 
+/**
+ * Converts a state to the internal numbering.
+ */
+void ImmutableBooleanNetwork::permuteIn(const State& s, State& internal) const {
+	const vector<size_t>& order = graph->order;
+	internal.resize(size());
+	for (size_t i = 0; i < order.size(); ++i)
+		internal[i] = s[order[i]];
+}
+
+/**
+ * Converts a state from the internal numbering.
+ */
+void ImmutableBooleanNetwork::permuteOut(const State& internal, State& s) const {
+	const vector<size_t>& order = graph->order;
+	s.resize(size());
+	for (size_t i = 0; i < order.size(); ++i)
+		s[order[i]] = internal[i];
+}
+
 BooleanFunction ImmutableBooleanNetwork::getFunction(const size_t i) const {
 	assert(i < size());
-	return BooleanFunction(net[vertex(i, net)]);
+	const Network& net = graph->net;
+	return net[vertex(isReordered() ? graph->rank[i] : i, net)];
 }
 
 vector<BooleanFunction> ImmutableBooleanNetwork::getFunctions() const {
@@ -88,6 +141,24 @@ vector<BooleanFunction> ImmutableBooleanNetwork::getFunctions() const {
 	return res;
 }
 
+/**
+ * Returns the inputs of a node in the order they index its truth table, that
+ * is the first element is the <em>least significant bit</em>.
+ * @param i a node index
+ * @return the indices of the inputs of node @a i
+ */
+vector<size_t> ImmutableBooleanNetwork::getInputs(const size_t i) const {
+	assert(i < size());
+	const Network& net = graph->net;
+	const vector<size_t>& order = graph->order;
+	vector<size_t> res;
+	Network::out_edge_iterator it, end;
+	for (tie(it, end) = out_edges(vertex(order.empty() ? i : graph->rank[i],
+			net), net); it != end; ++it)
+		res.push_back(order.empty() ? target(*it, net) : order[target(*it, net)]);
+	return res;
+}
+
 /**
  * Convenient function to initialize a boolean network from two files containing
  * a textual description of its topology and node functions.
@@ -104,6 +175,8 @@ vector<BooleanFunction> ImmutableBooleanNetwork::getFunctions() const {
  * \f$\underbrace{f(\overbrace{00 \ldots 00}^k) \quad (\overbrace{00 \ldots 01}^k)
  * \quad \ldots \quad f(\overbrace{11 \ldots 11}^k)}_{2^k}\f$\n
  * which totals to \f$2^k\f$ elements if <em>i</em>-th node has @e k inputs.
+ * Alternatively, a row may list the cubes of a disjunction, which is how
+ * high-arity functions are best described (see read_functions()).
  *
  * Input order is specified by topology file with the @e leftmost integer
  * indicating the <em>least significant bit</em>.
@@ -112,6 +185,7 @@ vector<BooleanFunction> ImmutableBooleanNetwork::getFunctions() const {
  * @param n number of nodes in the network
  * @param topologyFilename file name of topology description
  * @param functionFilename file name of function definitions
+ * @param ordering numbering of the nodes in memory
  * @return a new boolean network
  *
  * @todo
@@ -119,30 +193,66 @@ vector<BooleanFunction> ImmutableBooleanNetwork::getFunctions() const {
  * It might be kept as a double check.
  */
 ImmutableBooleanNetwork ImmutableBooleanNetwork::makeNetwork(
-		const char topologyFilename[], const char functionFilename[]) {
+		const char topologyFilename[], const char functionFilename[],
+		const NodeOrdering ordering) {
 	ifstream topoFile(topologyFilename);
 	util::JaggedArray<size_t> topo;
 	topoFile >> topo;
 	topoFile.close();
 	ifstream funcFile(functionFilename);
-	util::JaggedArray<bool> func;
-	funcFile >> func;
+	const vector<BooleanFunction> func = read_functions(funcFile);
 	funcFile.close();
+	vector<vector<size_t> > topology(topo.numRows());
+	for (size_t i = 0; i < topo.numRows(); ++i)
+		topology[i].assign(topo.begin(i), topo.end(i));
+	return makeNetwork(topology, func, ordering);
+}
+
+/**
+ * Builds a network from the inputs and the function of each node.
+ *
+ * With an @a ordering other than NATURAL_ORDER the nodes are renumbered
+ * internally by node_order(), so that a step reads state bits that are close
+ * to each other; the new numbering is not visible from the public interface.
+ * Functions are interned in FunctionPool::global().
+ * @param topology for each node, the list of its inputs, least significant
+ * 	bit first
+ * @param functions for each node, its function
+ * @param ordering numbering of the nodes in memory
+ * @return a new boolean network
+ */
+ImmutableBooleanNetwork ImmutableBooleanNetwork::makeNetwork(const vector<
+		vector<size_t> >& topology, const vector<BooleanFunction>& functions,
+		const NodeOrdering ordering) {
+	const size_t n = topology.size();
+	boost::shared_ptr<Graph> graph(new Graph);
+	vector<size_t>& order = graph->order;
+	vector<size_t>& rank = graph->rank;
+	if (ordering != NATURAL_ORDER) {
+		order = node_order(topology, ordering);
+		rank.resize(n);
+		for (size_t i = 0; i < n; ++i)
+			rank[order[i]] = i;
+	}
 	typedef pair<size_t, size_t> E;
 	vector<E> edges;
-	for (size_t i = 0; i < topo.numRows(); ++i) { // add edges
-		for (util::JaggedArray<size_t>::const_iterator j = topo.begin(i), end =
-				topo.end(i); j != end; ++j) {
-			edges.push_back(E(i, *j));
+	for (size_t i = 0; i < n; ++i) { // add edges
+		const size_t v = order.empty() ? i : order[i];
+		for (vector<size_t>::const_iterator j = topology[v].begin(), end =
+				topology[v].end(); j != end; ++j) {
+			edges.push_back(E(i, order.empty() ? *j : rank[*j]));
 		}
 	}
 	ImmutableBooleanNetwork::Network g(boost::edges_are_unsorted,
-			edges.begin(), edges.end(), topo.numRows());
-	for (size_t i = 0; i < func.numRows(); ++i) {
-		g[i] = TruthTable(func.begin(i), func.end(i));
+			edges.begin(), edges.end(), n);
+	for (size_t i = 0; i < functions.size(); ++i) {
+		g[order.empty() ? i : rank[i]] = FunctionPool::global().intern(
+				functions[i]);
 	}
+	swap(graph->net, g);
 	ImmutableBooleanNetwork res;
-	swap(res.net, g);
+	res.graph = graph;
+	res.state = State(n);
 	return res;
 }
 
@@ -155,11 +265,10 @@ ImmutableBooleanNetwork ImmutableBooleanNetwork::makeNetwork(
  * @return the stream passed as first argument
  */
 ostream& operator<<(ostream& out, const ImmutableBooleanNetwork& bn) {
-	ImmutableBooleanNetwork::Network::vertex_iterator vi, vend;
-	for (tie(vi, vend) = vertices(bn.net); vi != vend; ++vi) {
-		out << *vi << ") ";
-		util::print(out, adjacent_vertices(*vi, bn.net));
-		out << " : " << util::dump(bn.net[*vi]) << '\n';
+	for (size_t i = 0; i < bn.size(); ++i) { // in the numbering of the files
+		out << i << ") ";
+		util::print(out, bn.getInputs(i));
+		out << " : " << bn.getFunction(i) << '\n';
 	}
 	return out;
 }
@@ -0,0 +1,160 @@
+/*
+ * IncrementalNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/IncrementalNetwork.hpp>
+
+using namespace std;
+using boost::uint32_t;
+using boost::uint64_t;
+
+namespace bn {
+
+IncrementalNetwork::IncrementalNetwork(const ImmutableBooleanNetwork& net) {
+	init(net);
+}
+
+IncrementalNetwork::IncrementalNetwork(const MutableBooleanNetwork& net) {
+	init(net);
+}
+
+template<class Network> void IncrementalNetwork::init(const Network& net) {
+	const size_t n = net.size();
+	state = net.getState();
+	threshold = 0.25;
+	fullSteps = incrementalSteps = 0;
+	inOffsets.push_back(0);
+	vector<uint32_t> outDegrees(n + 1);
+	for (size_t i = 0; i < n; ++i) {
+		functions.push_back(net.getFunction(i));
+		const vector<size_t> in = net.getInputs(i);
+		if (!functions.back().empty()) // nodes without a function are never evaluated
+			for (size_t j = 0; j < in.size(); ++j) {
+				inputs.push_back(in[j]);
+				++outDegrees[in[j] + 1];
+			}
+		inOffsets.push_back(inputs.size());
+	}
+	// reverse adjacency in CSR form
+	outOffsets.assign(n + 1, 0);
+	for (size_t i = 0; i < n; ++i)
+		outOffsets[i + 1] = outOffsets[i] + outDegrees[i + 1];
+	outputs.resize(inputs.size());
+	vector<uint32_t> fill(outOffsets.begin(), outOffsets.end() - 1);
+	for (size_t i = 0; i < n; ++i)
+		for (uint32_t j = inOffsets[i]; j < inOffsets[i + 1]; ++j)
+			outputs[fill[inputs[j]]++] = make_pair(uint32_t(i), j - inOffsets[i]);
+	indices.resize(n);
+	flipped.reserve(n);
+	scheduled.reserve(n);
+	isScheduled.resize(n);
+}
+
+/**
+ * Triggers a simulation step.
+ */
+void IncrementalNetwork::update() {
+	update(state);
+}
+
+State IncrementalNetwork::operator()(const State& s) {
+	State next(size());
+	step(s, next);
+	return next;
+}
+
+/**
+ * Advances a state by one step, without allocating memory once the internal
+ * buffers have grown.
+ * @param s a state
+ */
+void IncrementalNetwork::update(State& s) {
+	using std::swap;
+	step(s, next);
+	swap(s, next);
+}
+
+/**
+ * Computes the successor of a state.
+ *
+ * If @a in is the result of the previous call, only the out-neighbours of
+ * the nodes that flipped in that call are evaluated, unless they are more
+ * than getThreshold() times size().
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ */
+void IncrementalNetwork::step(const State& in, State& out) {
+	assert(in.size() == size() && &in != &out);
+	if (in != tracked)
+		fullStep(in);
+	else if (flipped.size() > threshold * size())
+		fullStep(tracked);
+	else
+		incrementalStep();
+	out = tracked;
+}
+
+/**
+ * Evaluates every node on @a in and makes the result the tracked state.
+ * @param in a state, possibly tracked itself
+ */
+void IncrementalNetwork::fullStep(const State& in) {
+	const size_t n = size();
+	for (size_t i = 0; i < n; ++i) {
+		uint64_t index = 0;
+		for (uint32_t j = inOffsets[i], k = 0; j < inOffsets[i + 1]; ++j, ++k)
+			index |= uint64_t(in[inputs[j]]) << k;
+		indices[i] = index;
+	}
+	// in may be tracked, so it is read only above this line
+	tracked = in;
+	flipped.clear();
+	for (size_t i = 0; i < n; ++i) {
+		if (functions[i].empty())
+			continue;
+		const bool value = functions[i][indices[i]];
+		if (value != tracked[i]) {
+			tracked[i] = value;
+			flipped.push_back(i);
+		}
+	}
+	++fullSteps;
+}
+
+/**
+ * Advances the tracked state by evaluating the out-neighbours of the nodes
+ * that flipped in the previous step.
+ */
+void IncrementalNetwork::incrementalStep() {
+	for (vector<uint32_t>::const_iterator u = flipped.begin(); u
+			!= flipped.end(); ++u)
+		for (uint32_t e = outOffsets[*u]; e < outOffsets[*u + 1]; ++e) {
+			const uint32_t v = outputs[e].first;
+			indices[v] ^= uint64_t(1) << outputs[e].second;
+			if (!isScheduled[v]) {
+				isScheduled[v] = true;
+				scheduled.push_back(v);
+			}
+		}
+	// values depend on indices only, so tracked can be written in place
+	flipped.clear();
+	for (vector<uint32_t>::const_iterator v = scheduled.begin(); v
+			!= scheduled.end(); ++v) {
+		isScheduled[*v] = false;
+		const bool value = functions[*v][indices[*v]];
+		if (value != tracked[*v]) {
+			tracked[*v] = value;
+			flipped.push_back(*v);
+		}
+	}
+	scheduled.clear();
+	++incrementalSteps;
+}
+
+} // namespace bn
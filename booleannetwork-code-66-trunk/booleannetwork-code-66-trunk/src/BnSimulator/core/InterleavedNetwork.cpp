@@ -0,0 +1,257 @@
+/*
+ * InterleavedNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/InterleavedNetwork.hpp>
+
+using namespace std;
+using boost::uint32_t;
+
+namespace bn {
+
+namespace {
+
+const size_t WORD_BITS = 64;
+
+/**
+ * Template argument of the kernel that reads the arity at run time.
+ */
+const size_t GENERIC_ARITY = size_t(-1);
+
+/**
+ * Template argument of the kernels that read the number of lanes at run
+ * time.
+ */
+const size_t ANY_LANES = 0;
+
+} // namespace
+
+InterleavedNetwork::InterleavedNetwork(const ImmutableBooleanNetwork& net) :
+	compiled(net), distance(16), lanes(1) {
+}
+
+InterleavedNetwork::InterleavedNetwork(const MutableBooleanNetwork& net) :
+	compiled(net), distance(16), lanes(1) {
+}
+
+State InterleavedNetwork::operator()(const State& s) {
+	State next(size());
+	step(s, next);
+	return next;
+}
+
+void InterleavedNetwork::update(State& s) {
+	using std::swap;
+	step(s, next);
+	swap(s, next);
+}
+
+/**
+ * Computes the successor of a single state.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ */
+void InterleavedNetwork::step(const State& in, State& out) {
+	assert(in.size() == size() && &in != &out);
+	lanes = 1;
+	inWords.resize(compiled.scratch.in.size());
+	outWords.resize(inWords.size());
+	boost::to_block_range(in, inWords.begin());
+	eval();
+	out.resize(size());
+	boost::from_block_range(outWords.begin(), outWords.end(), out);
+}
+
+void InterleavedNetwork::update(vector<State>& states) {
+	step(states, nextGroup);
+	states.swap(nextGroup);
+}
+
+/**
+ * Computes the successors of a group of states, interleaving their
+ * evaluation.
+ * @param in the current states, all of size()
+ * @param out the next states; it is resized to the size of @a in if needed
+ * 	and must not alias it
+ */
+void InterleavedNetwork::step(const vector<State>& in, vector<State>& out) {
+	assert(&in != &out);
+	const size_t words = compiled.scratch.in.size();
+	lanes = in.size();
+	inWords.resize(lanes * words);
+	outWords.resize(inWords.size());
+	for (size_t t = 0; t < lanes; ++t) {
+		assert(in[t].size() == size());
+		boost::to_block_range(in[t], compiled.scratch.in.begin());
+		for (size_t w = 0; w < words; ++w)
+			inWords[w * lanes + t] = compiled.scratch.in[w];
+	}
+	eval();
+	out.resize(lanes);
+	for (size_t t = 0; t < lanes; ++t) {
+		for (size_t w = 0; w < words; ++w)
+			compiled.scratch.out[w] = outWords[w * lanes + t];
+		out[t].resize(size());
+		boost::from_block_range(compiled.scratch.out.begin(),
+				compiled.scratch.out.end(), out[t]);
+	}
+}
+
+/**
+ * Computes outWords from inWords for the current number of lanes.
+ */
+void InterleavedNetwork::eval() {
+	fill(outWords.begin(), outWords.end(), 0);
+	accs.assign(lanes, 0);
+	switch (lanes) {
+	case 1:
+		evalBuckets<1> ();
+		break;
+	case 2:
+		evalBuckets<2> ();
+		break;
+	case 4:
+		evalBuckets<4> ();
+		break;
+	case 8:
+		evalBuckets<8> ();
+		break;
+	default:
+		evalBuckets<ANY_LANES> ();
+	}
+	// nodes whose function is a decision diagram
+	const vector<CompiledNetwork::DiagramNode>& diagrams =
+			compiled.program->diagrams;
+	for (vector<CompiledNetwork::DiagramNode>::const_iterator it =
+			diagrams.begin(); it != diagrams.end(); ++it)
+		for (size_t t = 0; t < lanes; ++t) {
+			word_type index = 0;
+			for (size_t j = 0; j < it->inputs.size(); ++j)
+				index |= ((inWords[it->inputs[j] / WORD_BITS * lanes + t]
+						>> (it->inputs[j] % WORD_BITS)) & 1) << j;
+			outWords[it->node / WORD_BITS * lanes + t] |= word_type(
+					it->function[index]) << (it->node % WORD_BITS);
+		}
+	// nodes whose function is a threshold function
+	const CompiledNetwork::ThresholdNodes& th = compiled.program->thresholds;
+	for (size_t p = 0; p < th.nodes.size(); ++p)
+		for (size_t t = 0; t < lanes; ++t) {
+			word_type index = 0;
+			for (size_t k = th.offsets[p], j = 0; k < th.offsets[p + 1]; ++k, ++j)
+				index |= ((inWords[th.inputs[k] / WORD_BITS * lanes + t]
+						>> (th.inputs[k] % WORD_BITS)) & 1) << j;
+			outWords[th.nodes[p] / WORD_BITS * lanes + t] |= word_type(
+					th.functions[p](index)) << (th.nodes[p] % WORD_BITS);
+		}
+}
+
+/**
+ * Evaluates every bucket with the kernel specialized on its arity.
+ *
+ * Template parameter @a L is the number of lanes, or ANY_LANES to read it
+ * at run time.
+ */
+template<size_t L> void InterleavedNetwork::evalBuckets() {
+	for (size_t k = 0; k < compiled.program->buckets.size(); ++k) {
+		if (compiled.program->buckets[k].nodes.empty())
+			continue;
+		switch (k) {
+		case 0:
+			evalBucket<0, L> (k);
+			break;
+		case 1:
+			evalBucket<1, L> (k);
+			break;
+		case 2:
+			evalBucket<2, L> (k);
+			break;
+		case 3:
+			evalBucket<3, L> (k);
+			break;
+		case 4:
+			evalBucket<4, L> (k);
+			break;
+		case 5:
+			evalBucket<5, L> (k);
+			break;
+		case 6:
+			evalBucket<6, L> (k);
+			break;
+		case 7:
+			evalBucket<7, L> (k);
+			break;
+		case 8:
+			evalBucket<8, L> (k);
+			break;
+		default:
+			evalBucket<GENERIC_ARITY, L> (k);
+		}
+	}
+}
+
+/**
+ * Evaluates the nodes of bucket @a k in every lane.
+ *
+ * Template parameter @a K is the arity of the bucket, or GENERIC_ARITY to
+ * read it from @a k; @a L is the number of lanes, or ANY_LANES. Each node is
+ * evaluated in all of the lanes before the next one, and the input words of
+ * the node getPrefetchDistance() positions ahead are prefetched. Since word
+ * @e w of every lane is stored at w * lanes ... w * lanes + lanes - 1, the
+ * lanes of an input share its cache lines. The output bits of every lane are
+ * accumulated in accs and stored once per word.
+ */
+template<size_t K, size_t L> void InterleavedNetwork::evalBucket(
+		const size_t k) {
+	const size_t arity = K == GENERIC_ARITY ? k : K;
+	const size_t width = L == ANY_LANES ? lanes : L;
+	const CompiledNetwork::Bucket& b = compiled.program->buckets[k];
+	const size_t nodes = b.nodes.size();
+	const size_t tw = CompiledNetwork::tableWords(arity);
+	const word_type* const s = &inWords[0];
+	word_type* const acc = &accs[0];
+	size_t w = b.nodes[0] / WORD_BITS;
+	for (size_t p = 0; p < nodes; ++p) {
+		const uint32_t* const in = arity ? &b.inputs[p * arity] : 0;
+		const word_type* const tt = &b.tables[p * tw];
+		if (arity && distance && p + distance < nodes) {
+			const uint32_t* const ahead = &b.inputs[(p + distance) * arity];
+			for (size_t j = 0; j < arity; ++j)
+				__builtin_prefetch(s + ahead[j] / WORD_BITS * width);
+		}
+		const size_t v = b.nodes[p];
+		if (v / WORD_BITS != w) {
+			flush(w);
+			w = v / WORD_BITS;
+		}
+		for (size_t t = 0; t < width; ++t) {
+			word_type index = 0;
+			for (size_t j = 0; j < arity; ++j)
+				index |= ((s[in[j] / WORD_BITS * width + t] >> (in[j]
+						% WORD_BITS)) & 1) << j;
+			const word_type bit = arity <= 6 ? tt[0] >> index : tt[index
+					/ WORD_BITS] >> (index % WORD_BITS);
+			acc[t] |= (bit & 1) << (v % WORD_BITS);
+		}
+	}
+	flush(w);
+}
+
+/**
+ * Ors the accumulated bits of every lane into word @a w and clears them.
+ */
+void InterleavedNetwork::flush(const size_t w) {
+	for (size_t t = 0; t < lanes; ++t) {
+		outWords[w * lanes + t] |= accs[t];
+		accs[t] = 0;
+	}
+}
+
+} // namespace bn
@@ -14,6 +14,7 @@
 
 #include <BnSimulator/util/printing.hpp>
 #include <BnSimulator/util/JaggedArray.hpp>
+#include <BnSimulator/core/FunctionPool.hpp>
 #include <BnSimulator/core/MutableBooleanNetwork.hpp>
 
 using namespace std;
@@ -22,79 +23,71 @@ using namespace boost;
 namespace bn {
 
 void MutableBooleanNetwork::Updater::update() {
-	using std::swap;
-	State next(size());
-	MutableBooleanNetwork::Network::vertex_iterator vi, vend;
-	for (tie(vi, vend) = vertices(bn->net); vi != vend; ++vi) {
-		size_t index = 0;
-		size_t j = 0;
-		MutableBooleanNetwork::Network::inv_adjacency_iterator it, end;
-		for (tie(it, end) = inv_adjacent_vertices(*vi, bn->net); it != end; ++it, ++j) {
-			index += (1 << j) * state[*it];
-		}
-		next[*vi] = bn->net[*vi][index];
-	}
-	swap(state, next);
+	update(state);
 }
 
 void MutableBooleanNetwork::Updater::update(State& s) {
 	using std::swap;
-	State next(size());
-	MutableBooleanNetwork::Network::vertex_iterator vi, vend;
-	for (tie(vi, vend) = vertices(bn->net); vi != vend; ++vi) {
-		size_t index = 0;
-		size_t j = 0;
-		MutableBooleanNetwork::Network::inv_adjacency_iterator it, end;
-		for (tie(it, end) = inv_adjacent_vertices(*vi, bn->net); it != end; ++it, ++j) {
-			index += (1 << j) * s[*it];
-		}
-		next[*vi] = bn->net[*vi][index];
-	}
+	bn->eval(s, next);
 	swap(s, next);
 }
 
 /**
  * Triggers a simulation step.
+ */
+void MutableBooleanNetwork::update() {
+	update(state);
+}
+
+/**
+ * Computes the successor of a state without modifying this network.
  *
  * @note
  * From an implementation point of view, this is @e the most expensive piece
  * of code in the whole library.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
  */
-void MutableBooleanNetwork::update() {
-	using std::swap;
-	State next(size());
+void MutableBooleanNetwork::step(const State& in, State& out) {
+	eval(in, out);
+}
+
+/**
+ * Computes the successor of a state; it reads this network only, so that the
+ * dynamics returned by simulate() can share it.
+ */
+void MutableBooleanNetwork::eval(const State& in, State& out) const {
+	assert(in.size() == size() && &in != &out);
+	out.resize(size());
 	Network::vertex_iterator vi, vend;
 	for (tie(vi, vend) = vertices(net); vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
+		boost::uint64_t index = 0; // index computation is the most expensive operation
 		size_t j = 0;
 		Network::inv_adjacency_iterator it, end;
 		for (tie(it, end) = inv_adjacent_vertices(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * state[*it];
+			index |= boost::uint64_t(in[*it]) << j;
 		}
-		next[*vi] = net[*vi][index]; // vertex descriptors are integers
+		out[*vi] = net[*vi][index]; // vertex descriptors are integers
 	}
-	swap(state, next);
 }
 
+/**
+ * Advances a state by one step.
+ *
+ * The next state is computed into an internal buffer which is then swapped
+ * with @a s, so that no memory is allocated once the buffer has grown.
+ * @param s a state
+ */
 void MutableBooleanNetwork::update(State& s) {
 	using std::swap;
-	State next(size());
-	Network::vertex_iterator vi, vend;
-	for (tie(vi, vend) = vertices(net); vi != vend; ++vi) {
-		size_t index = 0; // index computation is the most expensive operation
-		size_t j = 0;
-		Network::inv_adjacency_iterator it, end;
-		for (tie(it, end) = inv_adjacent_vertices(*vi, net); it != end; ++it, ++j) {
-			index += (1 << j) * s[*it];
-		}
-		next[*vi] = net[*vi][index]; // vertex descriptors are integers
-	}
+	step(s, next);
 	swap(s, next);
 }
 
 BooleanFunction MutableBooleanNetwork::getFunction(const size_t i) const {
 	assert(i < size());
-	return BooleanFunction(net[vertex(i, net)]);
+	return net[vertex(i, net)];
 }
 
 vector<BooleanFunction> MutableBooleanNetwork::getFunctions() const {
@@ -105,6 +98,21 @@ vector<BooleanFunction> MutableBooleanNetwork::getFunctions() const {
 	return res;
 }
 
+/**
+ * Returns the inputs of a node in the order they index its truth table, that
+ * is the first element is the <em>least significant bit</em>.
+ * @param i a node index
+ * @return the indices of the inputs of node @a i
+ */
+vector<size_t> MutableBooleanNetwork::getInputs(const size_t i) const {
+	assert(i < size());
+	vector<size_t> res;
+	Network::inv_adjacency_iterator it, end;
+	for (tie(it, end) = inv_adjacent_vertices(vertex(i, net), net); it != end; ++it)
+		res.push_back(*it);
+	return res;
+}
+
 /**
  * Convenient function to initialize a boolean network from two files containing
  * a textual description of its topology and node functions.
@@ -121,6 +129,9 @@ vector<BooleanFunction> MutableBooleanNetwork::getFunctions() const {
  * \f$\underbrace{f(\overbrace{00 \ldots 00}^k) \quad (\overbrace{00 \ldots 01}^k)
  * \quad \ldots \quad f(\overbrace{11 \ldots 11}^k)}_{2^k}\f$\n
  * which totals to \f$2^k\f$ elements if <em>i</em>-th node has @e k inputs.
+ * Alternatively, a row may list the cubes of a disjunction, which is how
+ * high-arity functions are best described (see read_functions()).
+ * Functions are interned in FunctionPool::global().
  *
  * Input order is specified by topology file with the @e leftmost integer
  * indicating the <em>least significant bit</em>.
@@ -143,11 +154,10 @@ MutableBooleanNetwork MutableBooleanNetwork::makeNetwork(
 	topoFile >> topo;
 	topoFile.close();
 	ifstream funcFile(functionFilename);
-	util::JaggedArray<bool> func;
-	funcFile >> func;
+	const vector<BooleanFunction> func = read_functions(funcFile);
 	funcFile.close();
-	for (size_t i = 0; i < func.numRows(); ++i) // add vertices and functions
-		add_vertex(TruthTable(func.begin(i), func.end(i)), res.net);
+	for (size_t i = 0; i < func.size(); ++i) // add vertices and functions
+		add_vertex(FunctionPool::global().intern(func[i]), res.net);
 	for (size_t i = 0; i < topo.numRows(); ++i) { // add edges
 		Network::vertex_descriptor v = vertex(i, res.net);
 		for (util::JaggedArray<size_t>::const_iterator j = topo.begin(i), end =
@@ -172,7 +182,7 @@ ostream& operator<<(ostream& out, const MutableBooleanNetwork& bn) {
 	for (tie(vi, vend) = vertices(bn.net); vi != vend; ++vi) {
 		out << *vi << ") ";
 		util::print(out, inv_adjacent_vertices(*vi, bn.net));
-		out << " : " << util::dump(bn.net[*vi]) << '\n';
+		out << " : " << bn.net[*vi] << '\n';
 	}
 	return out;
 }
@@ -0,0 +1,149 @@
+/*
+ * ParallelNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+
+#include <boost/bind.hpp>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/ParallelNetwork.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+const size_t WORD_BITS = 64;
+
+/**
+ * Words per cache line: ranges start on multiples of this.
+ */
+const size_t LINE_WORDS = 8;
+
+} // namespace
+
+ParallelNetwork::ParallelNetwork(const ImmutableBooleanNetwork& net,
+		const size_t threads) :
+	compiled(net), stopping(false), state(net.getState()) {
+	start(threads);
+}
+
+ParallelNetwork::ParallelNetwork(const MutableBooleanNetwork& net,
+		const size_t threads) :
+	compiled(net), stopping(false), state(net.getState()) {
+	start(threads);
+}
+
+ParallelNetwork::ParallelNetwork(const ParallelNetwork& other) :
+	BooleanDynamics(other), compiled(other.compiled), stopping(false),
+			state(other.state) {
+	start(other.numThreads());
+}
+
+ParallelNetwork::~ParallelNetwork() {
+	if (barrier) {
+		stopping = true;
+		barrier->wait();
+		workers.join_all();
+	}
+}
+
+/**
+ * Partitions the words of a state and starts the worker threads.
+ * @param threads the number of threads requested, 0 meaning one
+ */
+void ParallelNetwork::start(const size_t threads) {
+	const size_t n = size();
+	const size_t words = (n + WORD_BITS - 1) / WORD_BITS;
+	const size_t lines = (words + LINE_WORDS - 1) / LINE_WORDS;
+	const size_t t = max<size_t> (1, min(threads, lines));
+	// the cost of node i is its number of inputs plus one
+	const vector<boost::uint32_t>& offsets = compiled.program->offsets;
+	const size_t total = offsets[n] + n;
+	ranges.assign(1, 0);
+	for (size_t line = 1, i = 1; i < t; ++i) {
+		while (line < lines && offsets[line * LINE_WORDS * WORD_BITS]
+				+ line * LINE_WORDS * WORD_BITS < i * total / t)
+			++line;
+		ranges.push_back(min(words, line * LINE_WORDS));
+	}
+	ranges.push_back(words);
+	if (t > 1) {
+		barrier.reset(new boost::barrier(t));
+		for (size_t i = 1; i < t; ++i)
+			workers.create_thread(boost::bind(&ParallelNetwork::work, this, i));
+	}
+}
+
+/**
+ * Body of worker thread @a t.
+ */
+void ParallelNetwork::work(const size_t t) {
+	for (;;) {
+		barrier->wait(); // wait for a step, or for the destructor
+		if (stopping)
+			return;
+		eval(t);
+		barrier->wait();
+	}
+}
+
+/**
+ * Evaluates the range of thread @a t.
+ */
+void ParallelNetwork::eval(const size_t t) {
+	compiled.eval(compiled.scratch, ranges[t], ranges[t + 1]);
+}
+
+/**
+ * Triggers a simulation step.
+ */
+void ParallelNetwork::update() {
+	update(state);
+}
+
+State ParallelNetwork::operator()(const State& s) {
+	State next(size());
+	step(s, next);
+	return next;
+}
+
+/**
+ * Advances a state by one step, without allocating memory once the internal
+ * buffer has grown.
+ * @param s a state
+ */
+void ParallelNetwork::update(State& s) {
+	using std::swap;
+	step(s, next);
+	swap(s, next);
+}
+
+/**
+ * Computes the successor of a state.
+ *
+ * Steps must not be called concurrently on the same object.
+ * @param in the current state
+ * @param out the next state; it is resized to size() if needed and must not
+ * 	alias @a in
+ */
+void ParallelNetwork::step(const State& in, State& out) {
+	assert(in.size() == size() && &in != &out);
+	out.resize(size());
+	boost::to_block_range(in, compiled.scratch.in.begin());
+	if (barrier)
+		barrier->wait(); // workers read scratch.in from here...
+	eval(0);
+	if (barrier)
+		barrier->wait(); // ...and their scratch.out words are complete here
+	boost::from_block_range(compiled.scratch.out.begin(),
+			compiled.scratch.out.end(), out);
+}
+
+} // namespace bn
@@ -0,0 +1,123 @@
+/*
+ * SparseNetwork.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+
+#include <BnSimulator/core/ImmutableBooleanNetwork.hpp>
+#include <BnSimulator/core/MutableBooleanNetwork.hpp>
+#include <BnSimulator/core/SparseNetwork.hpp>
+
+using namespace std;
+using boost::uint32_t;
+using boost::uint64_t;
+
+namespace bn {
+
+SparseNetwork::SparseNetwork(const ImmutableBooleanNetwork& net) :
+	compiled(net) {
+	init(net);
+}
+
+SparseNetwork::SparseNetwork(const MutableBooleanNetwork& net) :
+	compiled(net) {
+	init(net);
+}
+
+template<class Network> void SparseNetwork::init(const Network& net) {
+	const size_t n = net.size();
+	inOffsets.push_back(0);
+	vector<uint32_t> outDegrees(n + 1);
+	for (size_t i = 0; i < n; ++i) {
+		functions.push_back(net.getFunction(i));
+		const vector<size_t> in = net.getInputs(i);
+		if (!functions.back().empty()) { // nodes without a function are never evaluated
+			for (size_t j = 0; j < in.size(); ++j) {
+				inputs.push_back(in[j]);
+				++outDegrees[in[j] + 1];
+			}
+			if (functions.back()[0])
+				baseline.push_back(i);
+		}
+		inOffsets.push_back(inputs.size());
+	}
+	// reverse adjacency in CSR form
+	outOffsets.assign(n + 1, 0);
+	for (size_t i = 0; i < n; ++i)
+		outOffsets[i + 1] = outOffsets[i] + outDegrees[i + 1];
+	outputs.resize(inputs.size());
+	vector<uint32_t> fill(outOffsets.begin(), outOffsets.end() - 1);
+	for (size_t i = 0; i < n; ++i)
+		for (uint32_t j = inOffsets[i]; j < inOffsets[i + 1]; ++j)
+			outputs[fill[inputs[j]]++] = make_pair(uint32_t(i), j - inOffsets[i]);
+	indices.resize(n);
+}
+
+SparseState SparseNetwork::operator()(const SparseState& s) {
+	SparseState next;
+	step(s, next);
+	return next;
+}
+
+/**
+ * Advances a state by one step, without allocating memory once the internal
+ * buffers have grown, as long as the state stays sparse.
+ * @param s a state
+ */
+void SparseNetwork::update(SparseState& s) {
+	step(s, next);
+	s.swap(next);
+}
+
+/**
+ * Computes the successor of a state.
+ * @param in the current state
+ * @param out the next state; it must not alias @a in
+ */
+void SparseNetwork::step(const SparseState& in, SparseState& out) {
+	assert(in.size() == size() && &in != &out);
+	if (in.isSparse()) {
+		sparseStep(in);
+		out.assign(size(), result);
+	} else {
+		compiled.step(in.bits(), denseNext);
+		out.assign(denseNext);
+	}
+}
+
+/**
+ * Collects in result the active nodes of the successor of a sparse state.
+ */
+void SparseNetwork::sparseStep(const SparseState& in) {
+	const vector<SparseState::index_type>& active = in.indices();
+	result.clear();
+	for (vector<SparseState::index_type>::const_iterator u = active.begin(); u
+			!= active.end(); ++u) {
+		if (functions[*u].empty()) // hold value
+			result.push_back(*u);
+		for (uint32_t e = outOffsets[*u]; e < outOffsets[*u + 1]; ++e) {
+			const uint32_t v = outputs[e].first;
+			if (!indices[v])
+				touched.push_back(v);
+			indices[v] |= uint64_t(1) << outputs[e].second;
+		}
+	}
+	// nodes without active inputs take their value on the all-zero input
+	for (vector<SparseState::index_type>::const_iterator v = baseline.begin(); v
+			!= baseline.end(); ++v)
+		if (!indices[*v])
+			result.push_back(*v);
+	for (vector<uint32_t>::const_iterator v = touched.begin(); v
+			!= touched.end(); ++v) {
+		if (functions[*v][indices[*v]])
+			result.push_back(*v);
+		indices[*v] = 0;
+	}
+	touched.clear();
+	sort(result.begin(), result.end());
+}
+
+} // namespace bn
@@ -0,0 +1,153 @@
+/*
+ * SparseState.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <BnSimulator/core/SparseState.hpp>
+
+using namespace std;
+using boost::uint64_t;
+
+namespace bn {
+
+const SparseState::size_type SparseState::density_ratio;
+
+SparseState::SparseState(const State& s) :
+	n(s.size()), ones(s.count()) {
+	if (ones * density_ratio <= n) {
+		active.reserve(ones);
+		for (size_t i = s.find_first(); i != State::npos; i = s.find_next(i))
+			active.push_back(i);
+	} else
+		dense = s;
+}
+
+void SparseState::assign(const size_type n, vector<index_type>& indices) {
+	assert(indices.empty() || indices.back() < n);
+	this->n = n;
+	ones = indices.size();
+	if (ones * density_ratio <= n) {
+		active.swap(indices);
+		State().swap(dense);
+	} else {
+		if (dense.size() == n)
+			dense.reset();
+		else
+			State(n).swap(dense);
+		for (vector<index_type>::const_iterator i = indices.begin(); i
+				!= indices.end(); ++i)
+			dense.set(*i);
+		active.clear();
+	}
+}
+
+void SparseState::assign(State& s) {
+	n = s.size();
+	ones = s.count();
+	active.clear();
+	dense.swap(s);
+	normalize();
+}
+
+State SparseState::toState() const {
+	if (!isSparse())
+		return dense;
+	State s(n);
+	for (vector<index_type>::const_iterator i = active.begin(); i
+			!= active.end(); ++i)
+		s.set(*i);
+	return s;
+}
+
+SparseState& SparseState::set(const size_type i, const bool v) {
+	assert(i < n);
+	if (test(i) == v)
+		return *this;
+	if (isSparse()) {
+		vector<index_type>::iterator pos = lower_bound(active.begin(),
+				active.end(), index_type(i));
+		if (v)
+			active.insert(pos, i);
+		else
+			active.erase(pos);
+	} else
+		dense.set(i, v);
+	ones = v ? ones + 1 : ones - 1;
+	normalize();
+	return *this;
+}
+
+SparseState& SparseState::reset() {
+	active.clear();
+	State().swap(dense);
+	ones = 0;
+	return *this;
+}
+
+bool SparseState::operator<(const SparseState& other) const {
+	if (other.n == 0)
+		return false;
+	if (n == 0)
+		return true;
+	assert(n == other.n);
+	if (isSparse() && other.isSparse()) {
+		// the greater state has the greatest active node the other lacks
+		vector<index_type>::const_reverse_iterator a = active.rbegin(), b =
+				other.active.rbegin();
+		for (; a != active.rend() && b != other.active.rend(); ++a, ++b)
+			if (*a != *b)
+				return *a < *b;
+		return b != other.active.rend();
+	}
+	if (!isSparse() && !other.isSparse())
+		return dense < other.dense;
+	return toState() < other.toState();
+}
+
+void SparseState::normalize() {
+	if (isSparse() && ones * density_ratio > n) {
+		State(n).swap(dense);
+		for (vector<index_type>::const_iterator i = active.begin(); i
+				!= active.end(); ++i)
+			dense.set(*i);
+		vector<index_type>().swap(active);
+	} else if (!isSparse() && ones * density_ratio <= n) {
+		active.reserve(ones);
+		for (size_t i = dense.find_first(); i != State::npos; i
+				= dense.find_next(i))
+			active.push_back(i);
+		State().swap(dense);
+	}
+}
+
+ostream& operator<<(ostream& out, const SparseState& s) {
+	if (!s.isSparse())
+		return out << s.bits();
+	const vector<SparseState::index_type>& active = s.indices();
+	vector<SparseState::index_type>::const_reverse_iterator a =
+			active.rbegin();
+	for (size_t i = s.size(); i > 0; --i) {
+		const bool on = a != active.rend() && *a == i - 1;
+		out << (on ? '1' : '0');
+		if (on)
+			++a;
+	}
+	return out;
+}
+
+size_t hash_value(const SparseState& s) {
+	if (!s.isSparse())
+		return bitset_hash(s.bits());
+	const vector<SparseState::index_type>& active = s.indices();
+	WyMixer mixer;
+	size_t i = 0;
+	for (; i + 1 < active.size(); i += 2)
+		mixer(uint64_t(active[i]) | uint64_t(active[i + 1]) << 32);
+	if (i < active.size())
+		mixer(active[i]);
+	return mixer.result(s.size());
+}
+
+} // namespace bn
@@ -0,0 +1,241 @@
+/*
+ * ThresholdFunction.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+#include <ostream>
+
+#include <boost/functional/hash.hpp>
+
+#include <BnSimulator/core/ThresholdFunction.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+/**
+ * Input position meaning no input.
+ */
+const size_t NO_INPUT = size_t(-1);
+
+/**
+ * Largest range of sums that sums() tracks in a bitset.
+ */
+const ThresholdFunction::sum_type MAX_SPAN = 1 << 16;
+
+/**
+ * Largest number of distinct sums that sums() enumerates otherwise.
+ */
+const size_t MAX_SUMS = 1 << 16;
+
+} // namespace
+
+/**
+ * Builds a threshold function.
+ * @param weights the weight of every input, least significant input first
+ * @param threshold the threshold
+ * @param tie the value of the function when the sum equals @a threshold
+ * @param kept the input whose value is taken on ties if @a tie is TIE_KEEP;
+ * 	it is ignored otherwise
+ */
+ThresholdFunction::ThresholdFunction(const vector<weight_type>& weights,
+		const sum_type threshold, const TieRule tie, const size_t kept) :
+	weights(weights), threshold(threshold), tie(tie), kept(
+			tie == TIE_KEEP ? kept : 0), positive(0), negative(0), keptMask(
+			0), unit(weights.size() <= 64) {
+	assert(tie != TIE_KEEP || kept < weights.size());
+	if (tie == TIE_KEEP && kept < 64)
+		keptMask = boost::uint64_t(1) << kept;
+	for (size_t j = 0; j < weights.size(); ++j) {
+		unit = unit && weights[j] >= -1 && weights[j] <= 1;
+		if (unit && weights[j] > 0)
+			positive |= boost::uint64_t(1) << j;
+		else if (unit && weights[j] < 0)
+			negative |= boost::uint64_t(1) << j;
+	}
+}
+
+bool ThresholdFunction::operator()(const State& x) const {
+	assert(x.size() == weights.size());
+	sum_type sum = 0;
+	for (State::size_type j = x.find_first(); j != State::npos; j
+			= x.find_next(j))
+		sum += weights[j];
+	return value(sum, tie == TIE_KEEP && x[kept]);
+}
+
+/**
+ * Computes the weighted sums that the inputs other than @a skip1 and
+ * @a skip2 can produce.
+ *
+ * Sums are tracked in a bitset as long as they span at most MAX_SPAN values,
+ * and in a sorted vector otherwise, which is given up on as soon as it holds
+ * more than MAX_SUMS sums: their number is bounded by \f$2^k\f$ only.
+ * @param skip1 an input position, or NO_INPUT
+ * @param skip2 an input position, or NO_INPUT
+ * @param res set to the distinct sums in increasing order
+ * @return @e false if there are too many sums, in which case @a res is
+ * 	incomplete
+ */
+bool ThresholdFunction::sums(const size_t skip1, const size_t skip2,
+		vector<sum_type>& res) const {
+	sum_type lo = 0, hi = 0;
+	for (size_t j = 0; j < weights.size(); ++j)
+		if (j != skip1 && j != skip2)
+			(weights[j] < 0 ? lo : hi) += weights[j];
+	res.clear();
+	if (hi - lo < MAX_SPAN) {
+		State reach(hi - lo + 1);
+		reach.set(-lo);
+		for (size_t j = 0; j < weights.size(); ++j)
+			if (j != skip1 && j != skip2 && weights[j] != 0)
+				reach |= weights[j] > 0 ? reach << weights[j] : reach
+						>> -weights[j];
+		for (State::size_type s = reach.find_first(); s != State::npos; s
+				= reach.find_next(s))
+			res.push_back(lo + sum_type(s));
+		return true;
+	}
+	res.push_back(0);
+	vector<sum_type> shifted, merged;
+	for (size_t j = 0; j < weights.size(); ++j)
+		if (j != skip1 && j != skip2 && weights[j] != 0) {
+			shifted = res;
+			for (size_t s = 0; s < shifted.size(); ++s)
+				shifted[s] += weights[j];
+			merged.resize(res.size() + shifted.size());
+			merged.erase(set_union(res.begin(), res.end(), shifted.begin(),
+					shifted.end(), merged.begin()), merged.end());
+			res.swap(merged);
+			if (res.size() > MAX_SUMS)
+				return false;
+		}
+	return true;
+}
+
+/**
+ * Tells whether input @a i influences the value of this function.
+ *
+ * It enumerates the distinct sums of the other inputs, whose number is
+ * bounded both by \f$2^{k-1}\f$ and by the sum of the absolute weights. The
+ * answer is exact unless there are more than MAX_SUMS of them, in which case
+ * the input is assumed to be influent.
+ */
+bool ThresholdFunction::dependsOn(const size_t i) const {
+	assert(i < weights.size());
+	const bool keeps = tie == TIE_KEEP;
+	if (weights[i] == 0 && !(keeps && kept == i))
+		return false;
+	const size_t other = keeps && kept != i ? kept : NO_INPUT;
+	vector<sum_type> r;
+	if (!sums(i, other, r))
+		return true;
+	for (size_t s = 0; s < r.size(); ++s)
+		for (size_t b = 0; b < (other != NO_INPUT ? 2u : 1u); ++b) {
+			const sum_type sum = r[s] + (b ? weights[other] : 0);
+			// the kept value is b, or input i itself
+			if (value(sum, b != 0 && kept != i) != value(sum + weights[i], b
+					!= 0 || kept == i))
+				return true;
+		}
+	return false;
+}
+
+/**
+ * Tells whether this function is constant.
+ *
+ * The answer is exact without enumerating sums: for a given value of the
+ * kept input the function does not decrease with the sum, hence it only
+ * needs to be evaluated on the smallest and on the largest sum of the other
+ * inputs.
+ * @return a pair whose first element is @e true if the function is constant,
+ * 	and whose second element is @e true if it is constantly true
+ */
+pair<bool, bool> ThresholdFunction::isConstant() const {
+	const size_t other = tie == TIE_KEEP ? kept : NO_INPUT;
+	sum_type lo = 0, hi = 0;
+	for (size_t j = 0; j < weights.size(); ++j)
+		if (j != other)
+			(weights[j] < 0 ? lo : hi) += weights[j];
+	bool seen[2] = { false, false };
+	for (size_t b = 0; b < (other != NO_INPUT ? 2u : 1u); ++b) {
+		const sum_type w = b ? weights[other] : 0;
+		seen[value(lo + w, b != 0)] = true;
+		seen[value(hi + w, b != 0)] = true;
+	}
+	return make_pair(!seen[0] || !seen[1], !seen[0]);
+}
+
+/**
+ * Returns the function of @e k - 1 inputs obtained by fixing input @a i to
+ * @a v; inputs after @a i are shifted down by one. It is a threshold
+ * function too.
+ */
+ThresholdFunction ThresholdFunction::clamped(const size_t i, const bool v) const {
+	assert(i < weights.size());
+	vector<weight_type> w(weights);
+	w.erase(w.begin() + i);
+	TieRule t = tie;
+	size_t k = kept;
+	if (tie == TIE_KEEP && kept == i)
+		t = v ? TIE_TRUE : TIE_FALSE;
+	else if (tie == TIE_KEEP && kept > i)
+		--k;
+	return ThresholdFunction(w, threshold - (v ? weights[i] : 0), t, k);
+}
+
+/**
+ * Expands this function into a truth table.
+ * @return a truth table of \f$2^k\f$ entries
+ */
+State ThresholdFunction::table() const {
+	assert(weights.size() < sizeof(size_t) * 8 - 1);
+	State t(size_t(1) << weights.size());
+	for (size_t i = 0; i < t.size(); ++i)
+		t[i] = (*this)(boost::uint64_t(i));
+	return t;
+}
+
+bool ThresholdFunction::operator<(const ThresholdFunction& other) const {
+	if (weights.size() != other.weights.size())
+		return weights.size() < other.weights.size();
+	if (threshold != other.threshold)
+		return threshold < other.threshold;
+	if (tie != other.tie)
+		return tie < other.tie;
+	if (kept != other.kept)
+		return kept < other.kept;
+	return weights < other.weights;
+}
+
+/**
+ * Prints a function in the format read by read_functions(): the letter 't',
+ * the threshold, the tie rule ('0', '1', or '=' followed by the kept input)
+ * and the weights.
+ */
+ostream& operator<<(ostream& out, const ThresholdFunction& f) {
+	out << "t " << f.threshold << ' ';
+	if (f.tie == ThresholdFunction::TIE_KEEP)
+		out << '=' << f.kept;
+	else
+		out << (f.tie == ThresholdFunction::TIE_TRUE);
+	for (size_t j = 0; j < f.weights.size(); ++j)
+		out << ' ' << f.weights[j];
+	return out;
+}
+
+size_t hash_value(const ThresholdFunction& f) {
+	size_t h = f.weights.size();
+	boost::hash_combine(h, f.threshold);
+	boost::hash_combine(h, int(f.tie));
+	boost::hash_combine(h, f.kept);
+	boost::hash_range(h, f.weights.begin(), f.weights.end());
+	return h;
+}
+
+} // namespace bn
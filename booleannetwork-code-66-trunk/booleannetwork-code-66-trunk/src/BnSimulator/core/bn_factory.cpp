@@ -5,19 +5,25 @@
  *      Author: stewie
  */
 
+#include <cassert>
+#include <cstdlib>
+#include <algorithm>
+
+#include <BnSimulator/core/FunctionPool.hpp>
 #include <BnSimulator/core/bn_factory.hpp>
 
 using namespace std;
 
 namespace bn {
 
-MutableBooleanNetwork make_network(const vector<vector<size_t> >& topology,
-		const vector<vector<int> >& functions) {
-	MutableBooleanNetwork res;
-	for (vector<vector<int> >::const_iterator it = functions.begin(), end =
-			functions.end(); it != end; ++it) // add vertices and functions
-		add_vertex(MutableBooleanNetwork::TruthTable(it->begin(), it->end()),
-				res.topology());
+namespace {
+
+/**
+ * Connects the nodes of a network, whose vertices have been added already,
+ * and sets it to the all-zero state.
+ */
+void add_edges(const vector<vector<size_t> >& topology,
+		MutableBooleanNetwork& res) {
 	for (size_t ui = 0; ui < topology.size(); ++ui) {
 		MutableBooleanNetwork::Network::vertex_descriptor u = vertex(ui,
 				res.topology());
@@ -27,6 +33,98 @@ MutableBooleanNetwork make_network(const vector<vector<size_t> >& topology,
 		}
 	}
 	res.setState(State(res.size()));
+}
+
+/**
+ * Chooses @a k distinct nodes among @a n uniformly at random.
+ * @param nodes a permutation of 0 ... @a n - 1, shuffled in place
+ */
+vector<size_t> random_inputs(vector<size_t>& nodes, const size_t k) {
+	const size_t n = nodes.size();
+	vector<size_t> res;
+	for (size_t j = 0; j < k; ++j) { // partial Fisher-Yates shuffle
+		std::swap(nodes[j], nodes[j + rand() % (n - j)]);
+		res.push_back(nodes[j]);
+	}
+	return res;
+}
+
+} // namespace
+
+MutableBooleanNetwork make_network(const vector<vector<size_t> >& topology,
+		const vector<vector<int> >& functions) {
+	MutableBooleanNetwork res;
+	for (vector<vector<int> >::const_iterator it = functions.begin(), end =
+			functions.end(); it != end; ++it) // add vertices and functions
+		add_vertex(FunctionPool::global().intern(
+				MutableBooleanNetwork::TruthTable(it->begin(), it->end())),
+				res.topology());
+	add_edges(topology, res);
+	return res;
+}
+
+/**
+ * Generates a random network of the NK ensemble using std::rand().
+ *
+ * Every node has @a k distinct inputs chosen uniformly at random (self-loops
+ * included) and a random truth table in which each entry is 1 with
+ * probability @a bias.
+ * @param n number of nodes
+ * @param k number of inputs per node; it must not exceed @a n
+ * @param bias probability of a 1 in truth tables
+ * @return a network in the all-zero state
+ */
+MutableBooleanNetwork make_random_network(const size_t n, const size_t k,
+		const double bias) {
+	assert(k <= n);
+	vector<vector<size_t> > topology(n);
+	vector<vector<int> > functions(n, vector<int> (size_t(1) << k));
+	vector<size_t> nodes(n);
+	for (size_t i = 0; i < n; ++i)
+		nodes[i] = i;
+	for (size_t i = 0; i < n; ++i) {
+		topology[i] = random_inputs(nodes, k);
+		for (size_t j = 0; j < functions[i].size(); ++j)
+			functions[i][j] = rand() < bias * (RAND_MAX + 1.0);
+	}
+	return make_network(topology, functions);
+}
+
+/**
+ * Generates a random threshold network using std::rand().
+ *
+ * Every node has @a k distinct inputs chosen uniformly at random (self-loops
+ * included), each with weight 1 or -1 with equal probability, and threshold
+ * 0. With TIE_KEEP, a node whose sum is 0 keeps its value: if it is not one
+ * of its inputs, it is added as a further input of weight 0.
+ * @param n number of nodes
+ * @param k number of weighted inputs per node; it must not exceed @a n
+ * @param tie the tie rule of every node
+ * @return a network in the all-zero state
+ */
+MutableBooleanNetwork make_random_threshold_network(const size_t n,
+		const size_t k, const ThresholdFunction::TieRule tie) {
+	assert(k <= n);
+	vector<vector<size_t> > topology(n);
+	vector<size_t> nodes(n);
+	for (size_t i = 0; i < n; ++i)
+		nodes[i] = i;
+	MutableBooleanNetwork res;
+	for (size_t i = 0; i < n; ++i) {
+		topology[i] = random_inputs(nodes, k);
+		vector<ThresholdFunction::weight_type> weights;
+		for (size_t j = 0; j < k; ++j)
+			weights.push_back(rand() % 2 ? 1 : -1);
+		const size_t self = find(topology[i].begin(), topology[i].end(), i)
+				- topology[i].begin();
+		if (tie == ThresholdFunction::TIE_KEEP && self == k) {
+			topology[i].push_back(i);
+			weights.push_back(0);
+		}
+		add_vertex(FunctionPool::global().intern(BooleanFunction(
+				ThresholdFunction(weights, 0, tie, self))), res.topology());
+	}
+	add_edges(topology, res);
 	return res;
 }
 
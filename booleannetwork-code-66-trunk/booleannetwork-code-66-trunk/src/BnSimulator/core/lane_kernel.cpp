@@ -0,0 +1,184 @@
+/*
+ * lane_kernel.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <BnSimulator/core/lane_kernel.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BN_CPU_SUPPORTS(isa) __builtin_cpu_supports(isa)
+#else
+#define BN_CPU_SUPPORTS(isa) 0
+#endif
+
+using namespace std;
+
+namespace bn {
+
+namespace detail {
+
+typedef LaneKernel::word_type word_type;
+
+/**
+ * Portable kernel, one word at a time.
+ *
+ * Wider kernels also use it to process the blocks that do not fill a
+ * register.
+ */
+void scalar_lane_eval(const word_type* const * in, const size_t k,
+		const unsigned char* table, const size_t blocks, word_type* scratch,
+		word_type* dst) {
+	for (size_t b = 0; b < blocks; ++b) {
+		word_type x = in[0][b];
+		size_t width = size_t(1) << (k - 1);
+		for (size_t m = 0; m < width; ++m) {
+			const word_type lo = -word_type(table[2 * m]);
+			const word_type hi = -word_type(table[2 * m + 1]);
+			scratch[m] = lo ^ ((lo ^ hi) & x);
+		}
+		for (size_t j = 1; j < k; ++j) {
+			x = in[j][b];
+			width >>= 1;
+			for (size_t m = 0; m < width; ++m) {
+				const word_type lo = scratch[2 * m];
+				scratch[m] = lo ^ ((lo ^ scratch[2 * m + 1]) & x);
+			}
+		}
+		dst[b] = scratch[0];
+	}
+}
+
+#ifdef __SSE2__
+
+namespace {
+
+inline __m128i sse2_mux(const __m128i lo, const __m128i hi, const __m128i x) {
+	return _mm_xor_si128(lo, _mm_and_si128(_mm_xor_si128(lo, hi), x));
+}
+
+inline __m128i sse2_load(const word_type* p) {
+	return _mm_loadu_si128(reinterpret_cast<const __m128i*> (p));
+}
+
+inline void sse2_store(word_type* p, const __m128i v) {
+	_mm_storeu_si128(reinterpret_cast<__m128i*> (p), v);
+}
+
+void sse2_lane_eval(const word_type* const * in, const size_t k,
+		const unsigned char* table, const size_t blocks, word_type* scratch,
+		word_type* dst) {
+	const size_t w = 2;
+	size_t b = 0;
+	for (; b + w <= blocks; b += w) {
+		__m128i x = sse2_load(in[0] + b);
+		size_t width = size_t(1) << (k - 1);
+		for (size_t m = 0; m < width; ++m) {
+			const __m128i lo = _mm_set1_epi32(-int(table[2 * m]));
+			const __m128i hi = _mm_set1_epi32(-int(table[2 * m + 1]));
+			sse2_store(scratch + m * w, sse2_mux(lo, hi, x));
+		}
+		for (size_t j = 1; j < k; ++j) {
+			x = sse2_load(in[j] + b);
+			width >>= 1;
+			for (size_t m = 0; m < width; ++m)
+				sse2_store(scratch + m * w, sse2_mux(sse2_load(scratch + 2 * m
+						* w), sse2_load(scratch + (2 * m + 1) * w), x));
+		}
+		sse2_store(dst + b, sse2_load(scratch));
+	}
+	if (b < blocks) {
+		const word_type* tail[64];
+		for (size_t j = 0; j < k; ++j)
+			tail[j] = in[j] + b;
+		scalar_lane_eval(tail, k, table, blocks - b, scratch, dst + b);
+	}
+}
+
+const LaneKernel SSE2_KERNEL = { "sse2", 2, sse2_lane_eval };
+
+} // namespace
+
+const LaneKernel* sse2_lane_kernel() {
+	return &SSE2_KERNEL;
+}
+
+#else
+
+const LaneKernel* sse2_lane_kernel() {
+	return NULL;
+}
+
+#endif
+
+} // namespace detail
+
+namespace {
+
+const LaneKernel SCALAR_KERNEL = { "scalar", 1, detail::scalar_lane_eval };
+
+bool supported(const LaneKernel* k) {
+	if (k == NULL)
+		return false;
+	if (!strcmp(k->name, "avx512"))
+		return BN_CPU_SUPPORTS("avx512f");
+	if (!strcmp(k->name, "avx2"))
+		return BN_CPU_SUPPORTS("avx2");
+	return true; // scalar and sse2 are baseline
+}
+
+const LaneKernel& detect_lane_kernel() {
+	const char* forced = getenv("BN_LANE_KERNEL");
+	if (forced != NULL) {
+		const LaneKernel* k = find_lane_kernel(forced);
+		if (k != NULL)
+			return *k;
+	}
+	const LaneKernel* const candidates[] = { detail::avx512_lane_kernel(),
+			detail::avx2_lane_kernel(), detail::sse2_lane_kernel() };
+	for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); ++i)
+		if (supported(candidates[i]))
+			return *candidates[i];
+	return SCALAR_KERNEL;
+}
+
+} // namespace
+
+/**
+ * Returns the widest kernel compiled in and supported by the running CPU.
+ *
+ * Detection happens once, the first time this function is called. Setting
+ * the environment variable @c BN_LANE_KERNEL to a kernel name forces that
+ * kernel, provided it is available.
+ * @return the kernel used by default by BitslicedNetwork
+ */
+const LaneKernel& best_lane_kernel() {
+	static const LaneKernel& k = detect_lane_kernel();
+	return k;
+}
+
+/**
+ * Looks up a kernel by name.
+ * @param name one of "scalar", "sse2", "avx2", "avx512"
+ * @return the kernel, or NULL if it is not compiled in or the running CPU
+ * 	does not support it
+ */
+const LaneKernel* find_lane_kernel(const char name[]) {
+	const LaneKernel* const all[] = { &SCALAR_KERNEL,
+			detail::sse2_lane_kernel(), detail::avx2_lane_kernel(),
+			detail::avx512_lane_kernel() };
+	for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i)
+		if (all[i] != NULL && !strcmp(all[i]->name, name))
+			return supported(all[i]) ? all[i] : NULL;
+	return NULL;
+}
+
+} // namespace bn
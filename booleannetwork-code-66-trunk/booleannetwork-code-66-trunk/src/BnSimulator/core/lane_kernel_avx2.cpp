@@ -0,0 +1,89 @@
+/*
+ * lane_kernel_avx2.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+/*
+ * This file must be compiled with -mavx2. Its code is only run after
+ * best_lane_kernel() has checked that the CPU supports AVX2.
+ */
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <BnSimulator/core/lane_kernel.hpp>
+
+namespace bn {
+
+namespace detail {
+
+#ifdef __AVX2__
+
+namespace {
+
+typedef LaneKernel::word_type word_type;
+
+inline __m256i avx2_mux(const __m256i lo, const __m256i hi, const __m256i x) {
+	return _mm256_xor_si256(lo, _mm256_and_si256(_mm256_xor_si256(lo, hi), x));
+}
+
+inline __m256i avx2_load(const word_type* p) {
+	return _mm256_loadu_si256(reinterpret_cast<const __m256i*> (p));
+}
+
+inline void avx2_store(word_type* p, const __m256i v) {
+	_mm256_storeu_si256(reinterpret_cast<__m256i*> (p), v);
+}
+
+void avx2_lane_eval(const word_type* const * in, const std::size_t k,
+		const unsigned char* table, const std::size_t blocks,
+		word_type* scratch, word_type* dst) {
+	const std::size_t w = 4;
+	std::size_t b = 0;
+	for (; b + w <= blocks; b += w) {
+		__m256i x = avx2_load(in[0] + b);
+		std::size_t width = std::size_t(1) << (k - 1);
+		for (std::size_t m = 0; m < width; ++m) {
+			const __m256i lo = _mm256_set1_epi32(-int(table[2 * m]));
+			const __m256i hi = _mm256_set1_epi32(-int(table[2 * m + 1]));
+			avx2_store(scratch + m * w, avx2_mux(lo, hi, x));
+		}
+		for (std::size_t j = 1; j < k; ++j) {
+			x = avx2_load(in[j] + b);
+			width >>= 1;
+			for (std::size_t m = 0; m < width; ++m)
+				avx2_store(scratch + m * w, avx2_mux(avx2_load(scratch + 2 * m
+						* w), avx2_load(scratch + (2 * m + 1) * w), x));
+		}
+		avx2_store(dst + b, avx2_load(scratch));
+	}
+	if (b < blocks) {
+		const word_type* tail[64];
+		for (std::size_t j = 0; j < k; ++j)
+			tail[j] = in[j] + b;
+		scalar_lane_eval(tail, k, table, blocks - b, scratch, dst + b);
+	}
+}
+
+const LaneKernel AVX2_KERNEL = { "avx2", 4, avx2_lane_eval };
+
+} // namespace
+
+const LaneKernel* avx2_lane_kernel() {
+	return &AVX2_KERNEL;
+}
+
+#else
+
+const LaneKernel* avx2_lane_kernel() {
+	return NULL;
+}
+
+#endif
+
+} // namespace detail
+
+} // namespace bn
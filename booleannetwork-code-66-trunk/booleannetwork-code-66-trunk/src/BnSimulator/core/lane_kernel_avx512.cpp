@@ -0,0 +1,92 @@
+/*
+ * lane_kernel_avx512.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+/*
+ * This file must be compiled with -mavx512f. Its code is only run after
+ * best_lane_kernel() has checked that the CPU supports AVX-512F.
+ */
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+#include <BnSimulator/core/lane_kernel.hpp>
+
+namespace bn {
+
+namespace detail {
+
+#ifdef __AVX512F__
+
+namespace {
+
+typedef LaneKernel::word_type word_type;
+
+/**
+ * Truth table of <code>x ? hi : lo</code> for vpternlog.
+ */
+const int MUX = 0xCA;
+
+inline __m512i avx512_load(const word_type* p) {
+	return _mm512_loadu_si512(p);
+}
+
+inline void avx512_store(word_type* p, const __m512i v) {
+	_mm512_storeu_si512(p, v);
+}
+
+void avx512_lane_eval(const word_type* const * in, const std::size_t k,
+		const unsigned char* table, const std::size_t blocks,
+		word_type* scratch, word_type* dst) {
+	const std::size_t w = 8;
+	std::size_t b = 0;
+	for (; b + w <= blocks; b += w) {
+		__m512i x = avx512_load(in[0] + b);
+		std::size_t width = std::size_t(1) << (k - 1);
+		for (std::size_t m = 0; m < width; ++m) {
+			const __m512i lo = _mm512_set1_epi32(-int(table[2 * m]));
+			const __m512i hi = _mm512_set1_epi32(-int(table[2 * m + 1]));
+			avx512_store(scratch + m * w, _mm512_ternarylogic_epi64(x, hi, lo,
+					MUX));
+		}
+		for (std::size_t j = 1; j < k; ++j) {
+			x = avx512_load(in[j] + b);
+			width >>= 1;
+			for (std::size_t m = 0; m < width; ++m)
+				avx512_store(scratch + m * w, _mm512_ternarylogic_epi64(x,
+						avx512_load(scratch + (2 * m + 1) * w), avx512_load(
+								scratch + 2 * m * w), MUX));
+		}
+		avx512_store(dst + b, avx512_load(scratch));
+	}
+	if (b < blocks) {
+		const word_type* tail[64];
+		for (std::size_t j = 0; j < k; ++j)
+			tail[j] = in[j] + b;
+		scalar_lane_eval(tail, k, table, blocks - b, scratch, dst + b);
+	}
+}
+
+const LaneKernel AVX512_KERNEL = { "avx512", 8, avx512_lane_eval };
+
+} // namespace
+
+const LaneKernel* avx512_lane_kernel() {
+	return &AVX512_KERNEL;
+}
+
+#else
+
+const LaneKernel* avx512_lane_kernel() {
+	return NULL;
+}
+
+#endif
+
+} // namespace detail
+
+} // namespace bn
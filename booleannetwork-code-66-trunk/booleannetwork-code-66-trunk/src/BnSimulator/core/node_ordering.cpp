@@ -0,0 +1,89 @@
+/*
+ * node_ordering.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: stewie
+ */
+
+#include <cassert>
+#include <deque>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/cuthill_mckee_ordering.hpp>
+
+#include <BnSimulator/core/node_ordering.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>
+		UndirectedGraph;
+
+UndirectedGraph undirected(const vector<vector<size_t> >& topology) {
+	UndirectedGraph g(topology.size());
+	for (size_t v = 0; v < topology.size(); ++v)
+		for (vector<size_t>::const_iterator u = topology[v].begin(); u
+				!= topology[v].end(); ++u)
+			if (*u != v)
+				add_edge(*u, v, g);
+	return g;
+}
+
+vector<size_t> bfs_order(const UndirectedGraph& g) {
+	vector<size_t> order;
+	order.reserve(num_vertices(g));
+	vector<bool> visited(num_vertices(g));
+	deque<size_t> queue;
+	for (size_t root = 0; root < num_vertices(g); ++root) {
+		if (visited[root])
+			continue;
+		visited[root] = true;
+		queue.push_back(root);
+		while (!queue.empty()) {
+			const size_t v = queue.front();
+			queue.pop_front();
+			order.push_back(v);
+			UndirectedGraph::adjacency_iterator it, end;
+			for (boost::tie(it, end) = adjacent_vertices(v, g); it != end; ++it)
+				if (!visited[*it]) {
+					visited[*it] = true;
+					queue.push_back(*it);
+				}
+		}
+	}
+	return order;
+}
+
+} // namespace
+
+/**
+ * Computes a numbering of the nodes of a network that places nodes close to
+ * their inputs, so that a step reads nearby bits of the state.
+ *
+ * Edge directions are ignored.
+ * @param topology for each node, the list of its inputs
+ * @param ordering the kind of numbering
+ * @return the permutation @e p such that @e p[i] is the node numbered @e i
+ */
+vector<size_t> node_order(const vector<vector<size_t> >& topology,
+		const NodeOrdering ordering) {
+	const size_t n = topology.size();
+	vector<size_t> order;
+	if (ordering == NATURAL_ORDER) {
+		for (size_t i = 0; i < n; ++i)
+			order.push_back(i);
+		return order;
+	}
+	const UndirectedGraph g = undirected(topology);
+	if (ordering == BFS_ORDER)
+		return bfs_order(g);
+	assert(ordering == RCM_ORDER);
+	order.resize(n);
+	boost::cuthill_mckee_ordering(g, order.rbegin());
+	return order;
+}
+
+} // namespace bn
@@ -112,7 +112,7 @@ struct GetTruthTable {
 
 	void operator()(TempGraph::vertex_descriptor u,
 			MutableBooleanNetwork::Network::vertex_descriptor v) const {
-		to[v] = from[u].truthTable();
+		to[v] = from[u];
 	}
 };
 
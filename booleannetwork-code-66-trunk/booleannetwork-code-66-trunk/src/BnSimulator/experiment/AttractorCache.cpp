@@ -0,0 +1,229 @@
+/*
+ * AttractorCache.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+
+#include <BnSimulator/core/network_state.hpp>
+#include <BnSimulator/experiment/AttractorCache.hpp>
+
+using namespace std;
+
+namespace bn {
+
+/**
+ * Allocates the entries.
+ * @param nodes the number of nodes of the states
+ * @param memory the memory for the entries, in bytes; the cache has at least
+ * 	one bucket per shard
+ * @param eviction the eviction policy
+ * @param shards the number of shards, that is of threads that may look up
+ * 	states at the same time
+ */
+AttractorCache::AttractorCache(const size_t nodes, const size_t memory,
+		const Eviction eviction, const size_t shards) :
+	nodes(nodes), keyBlocks((nodes + State::bits_per_block - 1)
+			/ State::bits_per_block), eviction(eviction), shardCount(max<
+			size_t> (1, shards)), shards(new Shard[shardCount]) {
+	assert(nodes > 0);
+	const size_t bucket = WAYS * (sizeof(Slot) + keyBlocks
+			* sizeof(block_type)) + 1;
+	buckets = max<size_t> (1, memory / bucket / shardCount);
+	for (size_t i = 0; i < shardCount; ++i) {
+		this->shards[i].slots.resize(buckets * WAYS);
+		this->shards[i].keys.resize(buckets * WAYS * keyBlocks);
+		this->shards[i].hands.resize(buckets);
+	}
+	clear();
+}
+
+/**
+ * Returns the memory taken by the entries.
+ * @return a size in bytes
+ */
+size_t AttractorCache::memory() const {
+	return shardCount * buckets * (WAYS * (sizeof(Slot) + keyBlocks
+			* sizeof(block_type)) + 1);
+}
+
+/**
+ * Looks up a state.
+ * @param key the blocks() blocks of the state
+ * @param id set to the ID of the attractor of the state if it is cached
+ * @return @e true if the state is cached
+ */
+bool AttractorCache::find(const block_type* key, size_t& id) {
+	const size_t hash = bitset_hash(key, key + keyBlocks, nodes);
+	Shard& shard = shardOf(hash);
+	const size_t first = bucketOf(hash);
+	boost::mutex::scoped_lock lock(shard.mutex);
+	++shard.statistics.lookups;
+	for (size_t i = first; i < first + WAYS; ++i) {
+		Slot& slot = shard.slots[i];
+		if (slot.used && slot.hash == hash && equal(key, key + keyBlocks,
+				&shard.keys[i * keyBlocks])) {
+			slot.referenced = true;
+			++shard.statistics.hits;
+			id = slot.id;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Stores the attractor of a state, evicting another state if its bucket is
+ * full, unless the eviction policy is NONE.
+ * @param key the blocks() blocks of the state
+ * @param id the ID of its attractor, as returned by intern()
+ */
+void AttractorCache::insert(const block_type* key, const size_t id) {
+	const size_t hash = bitset_hash(key, key + keyBlocks, nodes);
+	Shard& shard = shardOf(hash);
+	const size_t first = bucketOf(hash);
+	boost::mutex::scoped_lock lock(shard.mutex);
+	size_t i = first;
+	for (; i < first + WAYS && shard.slots[i].used; ++i)
+		if (shard.slots[i].hash == hash && equal(key, key + keyBlocks,
+				&shard.keys[i * keyBlocks]))
+			return; // a state reaches one attractor only
+	if (i == first + WAYS) {
+		if (eviction == NONE)
+			return;
+		i = victim(shard, first);
+		++shard.statistics.evictions;
+	}
+	Slot& slot = shard.slots[i];
+	slot.hash = hash;
+	slot.id = id;
+	slot.used = true;
+	slot.referenced = false;
+	copy(key, key + keyBlocks, &shard.keys[i * keyBlocks]);
+	++shard.statistics.insertions;
+}
+
+/**
+ * Looks up a state.
+ *
+ * This overload converts the state to a temporary key.
+ * @param s a state of size() nodes
+ * @param id set to the ID of the attractor of @a s if it is cached
+ * @return @e true if @a s is cached
+ */
+bool AttractorCache::find(const State& s, size_t& id) {
+	assert(s.size() == nodes);
+	vector<block_type> key(keyBlocks);
+	boost::to_block_range(s, key.begin());
+	return find(&key[0], id);
+}
+
+/**
+ * Stores the attractor of a state.
+ *
+ * This overload converts the state to a temporary key.
+ * @param s a state of size() nodes
+ * @param id the ID of its attractor, as returned by intern()
+ */
+void AttractorCache::insert(const State& s, const size_t id) {
+	assert(s.size() == nodes);
+	vector<block_type> key(keyBlocks);
+	boost::to_block_range(s, key.begin());
+	insert(&key[0], id);
+}
+
+/**
+ * Returns the ID of an attractor, which is stored if it is new.
+ * @param a an attractor, which must not be empty
+ * @return its ID
+ */
+size_t AttractorCache::intern(const Attractor& a) {
+	assert(!a.empty());
+	boost::mutex::scoped_lock lock(internMutex);
+	const pair<map<State, size_t>::iterator, bool> p = ids.insert(make_pair(
+			a.getRepresentant(), interned));
+	if (p.second) {
+		assert(interned < boost::uint32_t(-1));
+		size_t k = 0;
+		while ((interned + 1) >> (k + 1))
+			++k;
+		if (!segments[k])
+			segments[k].reset(new Attractor[size_t(1) << k]);
+		segments[k][interned + 1 - (size_t(1) << k)] = a;
+		++interned;
+	}
+	return p.first->second;
+}
+
+/**
+ * Returns the number of interned attractors.
+ * @return an attractor count
+ */
+size_t AttractorCache::numAttractors() const {
+	boost::mutex::scoped_lock lock(internMutex);
+	return interned;
+}
+
+/**
+ * Returns the counters of the operations since the construction or since the
+ * last call to resetStatistics() or clear().
+ * @return the sum of the counters of the shards
+ */
+AttractorCache::Statistics AttractorCache::getStatistics() const {
+	Statistics res;
+	for (size_t i = 0; i < shardCount; ++i) {
+		boost::mutex::scoped_lock lock(shards[i].mutex);
+		res += shards[i].statistics;
+	}
+	return res;
+}
+
+void AttractorCache::resetStatistics() {
+	for (size_t i = 0; i < shardCount; ++i) {
+		boost::mutex::scoped_lock lock(shards[i].mutex);
+		shards[i].statistics = Statistics();
+	}
+}
+
+/**
+ * Removes every state and every attractor, and resets the statistics.
+ *
+ * It must not run concurrently with other members, and invalidates the
+ * references returned by getAttractor().
+ */
+void AttractorCache::clear() {
+	const Slot empty = { 0, 0, false, false };
+	for (size_t i = 0; i < shardCount; ++i) {
+		fill(shards[i].slots.begin(), shards[i].slots.end(), empty);
+		fill(shards[i].hands.begin(), shards[i].hands.end(), 0);
+		shards[i].statistics = Statistics();
+	}
+	for (size_t k = 0; k < SEGMENTS; ++k)
+		segments[k].reset();
+	interned = 0;
+	ids.clear();
+}
+
+/**
+ * Picks the slot of a full bucket that a new state replaces, according to
+ * the eviction policy, and advances the hand of the bucket past it.
+ * @param shard the shard of the bucket, which the caller has locked
+ * @param bucket the first slot of the bucket
+ * @return the index of the slot
+ */
+size_t AttractorCache::victim(Shard& shard, const size_t bucket) {
+	unsigned char& hand = shard.hands[bucket / WAYS];
+	if (eviction == CLOCK)
+		// terminates within two turns, as every slot passed is cleared
+		while (shard.slots[bucket + hand].referenced) {
+			shard.slots[bucket + hand].referenced = false;
+			hand = (hand + 1) % WAYS;
+		}
+	const size_t res = bucket + hand;
+	hand = (hand + 1) % WAYS;
+	return res;
+}
+
+} // namespace bn
@@ -0,0 +1,210 @@
+/*
+ * ExperimentArena.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <BnSimulator/experiment/ExperimentArena.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace {
+
+/**
+ * Initial number of slots of the hash index.
+ */
+const size_t MIN_INDEX = 16;
+
+} // namespace
+
+ExperimentArena::ExperimentArena(const size_t blockSize) :
+	arena(blockSize), nodes(0), blocks(0), count(0) {
+}
+
+/**
+ * Counts the attractor that contains a state.
+ *
+ * The states of the attractor are stored only if it was not in this arena
+ * already.
+ * @param dyn the dynamics
+ * @param s a state of the attractor
+ * @param length the length of the attractor
+ * @return the attractor
+ */
+ExperimentArena::AttractorRef ExperimentArena::insert(
+		BasicBooleanDynamics<State>& dyn, const State& s, const size_t length) {
+	using std::swap;
+	assert(length > 0);
+	setSize(s.size());
+	least = s;
+	tortoise = s;
+	for (size_t i = 1; i < length; ++i) {
+		dyn.step(tortoise, next);
+		swap(tortoise, next);
+		if (tortoise < least)
+			least = tortoise;
+	}
+	boost::to_block_range(least, key.begin());
+	const size_t hash = bitset_hash(key.begin(), key.end(), nodes);
+	Entry* e = lookup(hash);
+	if (!e) {
+		e = store(hash, length);
+		block_type* w = words(e);
+		tortoise = least;
+		for (size_t i = 0; i < length; ++i, w += blocks) {
+			boost::to_block_range(tortoise, w);
+			dyn.step(tortoise, next);
+			swap(tortoise, next);
+		}
+	}
+	++e->count;
+	++count;
+	return AttractorRef(e, nodes);
+}
+
+/**
+ * Counts an attractor found by another cycle finder.
+ * @param a an attractor, which must not be empty
+ * @return the attractor
+ */
+ExperimentArena::AttractorRef ExperimentArena::insert(const Attractor& a) {
+	assert(!a.empty());
+	const State& r = a.getRepresentant();
+	setSize(r.size());
+	boost::to_block_range(r, key.begin());
+	const size_t hash = bitset_hash(key.begin(), key.end(), nodes);
+	Entry* e = lookup(hash);
+	if (!e) {
+		e = store(hash, a.getLength());
+		block_type* w = words(e);
+		// states in cycle order from the representant
+		const Attractor::const_iterator first = std::find(a.begin(), a.end(),
+				r);
+		for (Attractor::const_iterator it = first; it != a.end(); ++it, w
+				+= blocks)
+			boost::to_block_range(*it, w);
+		for (Attractor::const_iterator it = a.begin(); it != first; ++it, w
+				+= blocks)
+			boost::to_block_range(*it, w);
+	}
+	++e->count;
+	++count;
+	return AttractorRef(e, nodes);
+}
+
+/**
+ * Returns the number of bytes used by this arena: the blocks of the stored
+ * attractors and the index.
+ * @return a memory footprint
+ */
+size_t ExperimentArena::memory() const {
+	return arena.memory() + index.capacity() * sizeof(Entry*)
+			+ found.capacity() * sizeof(AttractorRef);
+}
+
+/**
+ * Frees every stored attractor, and resets all counts.
+ */
+void ExperimentArena::release() {
+	arena.release();
+	vector<Entry*> ().swap(index);
+	vector<AttractorRef> ().swap(found);
+	count = 0;
+}
+
+/**
+ * Sets the number of nodes of the states of this arena on first use.
+ */
+void ExperimentArena::setSize(const size_t n) {
+	if (found.empty()) {
+		nodes = n;
+		blocks = (n + State::bits_per_block - 1) / State::bits_per_block;
+		key.resize(blocks);
+	}
+	assert(n == nodes);
+}
+
+/**
+ * Finds the attractor whose representant has hash @a hash and blocks key.
+ * @return the attractor, or NULL
+ */
+ExperimentArena::Entry* ExperimentArena::lookup(const size_t hash) {
+	if (index.empty())
+		return NULL;
+	const size_t mask = index.size() - 1;
+	for (size_t i = hash & mask; index[i]; i = (i + 1) & mask)
+		if (index[i]->hash == hash && equal(key.begin(), key.end(), words(
+				index[i])))
+			return index[i];
+	return NULL;
+}
+
+/**
+ * Allocates and indexes an attractor, whose states are left to the caller.
+ */
+ExperimentArena::Entry* ExperimentArena::store(const size_t hash,
+		const size_t length) {
+	Entry* e = static_cast<Entry*> (arena.allocate(sizeof(Entry) + length
+			* blocks * sizeof(block_type), boost::alignment_of<Entry>::value));
+	e->hash = hash;
+	e->count = 0;
+	e->length = length;
+	if (2 * (found.size() + 1) > index.size())
+		rehash();
+	const size_t mask = index.size() - 1;
+	size_t i = hash & mask;
+	while (index[i])
+		i = (i + 1) & mask;
+	index[i] = e;
+	found.push_back(AttractorRef(e, nodes));
+	return e;
+}
+
+/**
+ * Doubles the size of the index.
+ */
+void ExperimentArena::rehash() {
+	vector<Entry*> bigger(max(MIN_INDEX, 2 * index.size()), NULL);
+	const size_t mask = bigger.size() - 1;
+	for (vector<AttractorRef>::const_iterator it = found.begin(); it
+			!= found.end(); ++it) {
+		size_t i = it->entry->hash & mask;
+		while (bigger[i])
+			i = (i + 1) & mask;
+		bigger[i] = const_cast<Entry*> (it->entry);
+	}
+	index.swap(bigger);
+}
+
+/**
+ * Returns a state of this attractor.
+ * @param i the distance of the state from the representant along the cycle
+ * @return a state
+ */
+State ExperimentArena::AttractorRef::getState(const size_t i) const {
+	assert(entry && i < entry->length);
+	const size_t blocks = (nodes + State::bits_per_block - 1)
+			/ State::bits_per_block;
+	const block_type* w = words(entry) + i * blocks;
+	State s(nodes);
+	boost::from_block_range(w, w + blocks, s);
+	return s;
+}
+
+/**
+ * Copies this attractor into an Attractor object.
+ * @return an attractor with the same states
+ */
+Attractor ExperimentArena::AttractorRef::toAttractor() const {
+	vector<State> states;
+	for (size_t i = 0; i < getLength(); ++i)
+		states.push_back(getState(i));
+	return Attractor(states);
+}
+
+} // namespace bn
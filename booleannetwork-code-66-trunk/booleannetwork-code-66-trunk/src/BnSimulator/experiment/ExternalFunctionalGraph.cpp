@@ -0,0 +1,692 @@
+/*
+ * ExternalFunctionalGraph.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include <boost/static_assert.hpp>
+
+#include <BnSimulator/experiment/ExternalFunctionalGraph.hpp>
+
+using namespace std;
+using boost::uint32_t;
+using boost::uint64_t;
+
+namespace bn {
+
+namespace {
+
+typedef ExternalFunctionalGraph::index_type index_type;
+
+/**
+ * Cycle without an attractor yet.
+ */
+const index_type NONE = numeric_limits<index_type>::max();
+
+/**
+ * Memory per run being merged, for the read-ahead of its file.
+ */
+const size_t STREAM_BYTES = size_t(256) << 10;
+
+/**
+ * Sweeps of a round of pointer jumping, in order; the in-degrees are counted
+ * by the first three.
+ */
+enum Sweep {
+	FILL, SORT, JOIN, SORT_BACK, SCATTER
+};
+
+template<class E> bool lessKey(const E& a, const E& b) {
+	return a.key < b.key;
+}
+
+/**
+ * Merges the sorted runs of @a width entries of in[0] ... in[size - 1] into
+ * out, by key.
+ */
+template<class E> void merge(const E* in, const index_type size,
+		const index_type width, E* out) {
+	typedef pair<index_type, size_t> Head; // key and run
+	priority_queue<Head, vector<Head> , greater<Head> > heads;
+	vector<index_type> next, end;
+	for (index_type first = 0; first < size; first += width) {
+		heads.push(Head(in[first].key, next.size()));
+		next.push_back(first);
+		end.push_back(min(first + width, size));
+	}
+	for (; !heads.empty(); ++out) {
+		const size_t r = heads.top().second;
+		heads.pop();
+		*out = in[next[r]++];
+		if (next[r] < end[r])
+			heads.push(Head(in[next[r]].key, r));
+	}
+}
+
+/**
+ * Maps an array on the file @a path with @a size elements if it is
+ * @a needed, or unmaps it and removes the file otherwise.
+ */
+template<class T> bool openIf(const bool needed, util::MappedArray<T>& a,
+		const string& path, const uint64_t size) {
+	if (needed)
+		return a.open(path, size);
+	a.close();
+	remove(path.c_str());
+	return true;
+}
+
+template<class T> void write(ostream& out, const char name[],
+		const vector<T>& v) {
+	out << name << ' ' << v.size();
+	for (size_t i = 0; i < v.size(); ++i)
+		out << ' ' << v[i];
+	out << '\n';
+}
+
+/**
+ * Writes the values that occur in a distribution, with their counts.
+ */
+void write(ostream& out, const char name[],
+		const ExternalFunctionalGraph::Distribution& distribution) {
+	out << name << ' ' << distribution.size();
+	for (ExternalFunctionalGraph::Distribution::const_iterator i =
+			distribution.begin(); i != distribution.end(); ++i)
+		out << ' ' << i->first << ' ' << i->second;
+	out << '\n';
+}
+
+template<class T> bool read(istream& in, const char name[], T& value) {
+	string s;
+	return in >> s >> value && s == name;
+}
+
+template<class T> bool read(istream& in, const char name[], vector<T>& v) {
+	size_t size;
+	if (!read(in, name, size))
+		return false;
+	v.resize(size);
+	for (size_t i = 0; i < size; ++i)
+		in >> v[i];
+	return bool(in);
+}
+
+bool read(istream& in, const char name[],
+		ExternalFunctionalGraph::Distribution& distribution) {
+	size_t size;
+	if (!read(in, name, size))
+		return false;
+	distribution.clear();
+	uint64_t value, times;
+	for (size_t i = 0; i < size && in >> value >> times; ++i)
+		distribution[value] = times;
+	return bool(in);
+}
+
+} // namespace
+
+const size_t ExternalFunctionalGraph::MAX_NODES;
+
+const size_t ExternalFunctionalGraph::DEFAULT_MEMORY;
+
+const size_t ExternalFunctionalGraph::SAMPLE_SIZE;
+
+/**
+ * Prepares an analysis stored in a directory, which must exist.
+ * @param directory the directory of the files of the analysis
+ * @param memory the memory of a sort, in bytes
+ */
+ExternalFunctionalGraph::ExternalFunctionalGraph(const string& directory,
+		const size_t memory) :
+	directory(directory), memory(memory), n(0), window(0), fanIn(0),
+			phase(SUCCESSORS), round(0), sweep(0), position(0), width(0),
+			current(0), count(0), previous(0), rounds(0), fingerprint(0),
+			sampled(0) {
+}
+
+string ExternalFunctionalGraph::path(const char name[]) const {
+	return directory + '/' + name;
+}
+
+/**
+ * Starts a new analysis of a network of @a n nodes.
+ */
+void ExternalFunctionalGraph::reset(const size_t n) {
+	BOOST_STATIC_ASSERT(sizeof(Entry) == 15);
+	this->n = n;
+	window = min<index_type> (64, numStates());
+	while (window < numStates() && 2 * window * sizeof(Entry) <= memory)
+		window *= 2;
+	fanIn = max<size_t> (2, memory / STREAM_BYTES);
+	phase = SUCCESSORS;
+	round = sweep = current = 0;
+	position = count = previous = 0;
+	width = window;
+	rounds = 0;
+	fingerprint = sampled = 0;
+	inDegrees.clear();
+	transients.clear();
+	basins.clear();
+	order.clear();
+	cycles.clear();
+	offsets.clear();
+}
+
+/**
+ * Maps the files that the current phase needs, and removes the other ones.
+ */
+bool ExternalFunctionalGraph::openArrays() {
+	const uint64_t states = numStates();
+	const bool sorts = phase == IN_DEGREES || phase == JUMPS || phase
+			== DEPTHS;
+	return openIf(phase <= DEPTHS, successorArray, path("successors"),
+			states) && openIf(phase >= JUMPS && phase <= DEPTHS, jumps,
+			path("jumps"), states) && openIf(phase >= IN_DEGREES && phase
+			<= LABELS, image, path("image"), max<uint64_t> (1, states / 64))
+			&& openIf(phase >= LABELS, labels, path("labels"), states)
+			&& openIf(phase >= LABELS, depths, path("depths"), states)
+			&& openIf(sorts, entries[0], path("entries0"), states) && openIf(
+			sorts, entries[1], path("entries1"), states);
+}
+
+/**
+ * Reads the progress file.
+ * @return @e false if there is none, or it is unreadable
+ */
+bool ExternalFunctionalGraph::load() {
+	ifstream in(path("progress").c_str());
+	int p;
+	if (!(read(in, "n", n) && read(in, "window", window) && read(in, "fanIn",
+			fanIn) && read(in, "phase", p) && read(in, "round", round)
+			&& read(in, "sweep", sweep) && read(in, "position", position)
+			&& read(in, "width", width) && read(in, "current", current)
+			&& read(in, "count", count)
+			&& read(in, "previous", previous) && read(in, "rounds", rounds)
+			&& read(in, "fingerprint", fingerprint) && read(in, "sampled",
+			sampled) && read(in, "inDegrees", inDegrees) && read(in,
+			"transients", transients) && read(in, "basins", basins) && read(
+			in, "order", order) && read(in, "cycles", cycles) && read(in,
+			"offsets", offsets)))
+		return false;
+	phase = Phase(p);
+	return n > 0 && n <= MAX_NODES;
+}
+
+/**
+ * Replaces the progress file.
+ * @return @e false if it could not be written
+ */
+bool ExternalFunctionalGraph::save() const {
+	const string tmp = path("progress.tmp");
+	{
+		ofstream out(tmp.c_str());
+		out << "n " << n << "\nwindow " << window << "\nfanIn " << fanIn
+				<< "\nphase " << int(phase) << "\nround " << round
+				<< "\nsweep " << sweep << "\nposition " << position
+				<< "\nwidth " << width << "\ncurrent " << current
+				<< "\ncount " << count
+				<< "\nprevious " << previous << "\nrounds " << rounds
+				<< "\nfingerprint " << fingerprint << "\nsampled " << sampled
+				<< '\n';
+		write(out, "inDegrees", inDegrees);
+		write(out, "transients", transients);
+		write(out, "basins", basins);
+		write(out, "order", order);
+		write(out, "cycles", cycles);
+		write(out, "offsets", offsets);
+		if (!out.flush())
+			return false;
+	}
+	return rename(tmp.c_str(), path("progress").c_str()) == 0;
+}
+
+/**
+ * Writes the arrays to their files, then saves the progress with @a next as
+ * the first state of the next chunk or window.
+ * @return @e false on failure
+ */
+bool ExternalFunctionalGraph::checkpoint(const index_type next) {
+	position = next;
+	return successorArray.sync() && jumps.sync() && image.sync()
+			&& depths.sync() && labels.sync() && entries[0].sync()
+			&& entries[1].sync() && save();
+}
+
+/**
+ * Runs the phases after the successors.
+ */
+bool ExternalFunctionalGraph::finish() {
+	for (;;) {
+		if (!openArrays())
+			return false;
+		bool ok = false;
+		switch (phase) {
+		case IN_DEGREES:
+			ok = countInDegrees();
+			break;
+		case JUMPS:
+			ok = jump();
+			break;
+		case LABELS:
+			ok = label();
+			break;
+		case DEPTHS:
+			ok = sumDepths();
+			break;
+		case TRANSIENTS:
+			ok = countTransients();
+			break;
+		case COMPLETE:
+			return true;
+		default:
+			assert(false);
+		}
+		if (!ok)
+			return false;
+	}
+}
+
+/**
+ * Returns the jump of round @a r of pointer jumping, \f$f^{2^r}\f$, during
+ * that round.
+ */
+const ExternalFunctionalGraph::Packed* ExternalFunctionalGraph::power(
+		const size_t r) const {
+	return r == 0 ? successorArray.data() : jumps.data();
+}
+
+/**
+ * Stores the entry (src[x], x) of every state @e x in entries[current],
+ * with depth d[x] if @a d is given, sorting every chunk into a run.
+ */
+bool ExternalFunctionalGraph::fill(const Packed* src, const Packed* d) {
+	const uint64_t states = numStates();
+	Entry* const e = entries[current].data();
+	while (position < states) {
+		const index_type first = position;
+		for (index_type x = first; x < first + window; ++x) {
+			e[x].key = src[x];
+			e[x].value = x;
+			e[x].depth = d ? index_type(d[x]) : 0;
+		}
+		std::sort(e + first, e + first + window, lessKey<Entry> );
+		if (!checkpoint(first + window))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Sorts entries[current] by key, merging its runs fanIn at a time until one
+ * is left, each pass from one file into the other.
+ */
+bool ExternalFunctionalGraph::sort() {
+	const uint64_t states = numStates();
+	while (width < states) {
+		const Entry* const in = entries[current].data();
+		Entry* const out = entries[1 - current].data();
+		const index_type group = width * fanIn;
+		while (position < states) {
+			const index_type first = position;
+			const index_type size = min<index_type> (group, states - first);
+			merge(in + first, size, width, out + first);
+			if (!checkpoint(first + size))
+				return false;
+		}
+		current = 1 - current;
+		width = group;
+		if (!checkpoint(0))
+			return false;
+	}
+	width = window;
+	return true;
+}
+
+/**
+ * Joins the entries, sorted by key, with @a src and @a d, which are read in
+ * increasing order: the entry (y, x) becomes (x, src[y]), with d[y] added to
+ * its depth if @a d is given, in the other file, whose chunks are sorted into
+ * runs.
+ * @param mark if @e true, the keys are marked in the image, and the distinct
+ * 	ones are added to count
+ */
+bool ExternalFunctionalGraph::join(const Packed* src, const Packed* d,
+		const bool mark) {
+	const uint64_t states = numStates();
+	const Entry* const in = entries[current].data();
+	Entry* const out = entries[1 - current].data();
+	uint64_t* const bits = image.data();
+	while (position < states) {
+		const index_type first = position;
+		for (index_type i = first; i < first + window; ++i) {
+			const index_type y = in[i].key;
+			out[i].key = index_type(in[i].value);
+			out[i].value = src[y];
+			out[i].depth = in[i].depth + (d ? index_type(d[y]) : 0);
+			if (mark && (i == 0 || y != in[i - 1].key)) {
+				bits[y / 64] |= uint64_t(1) << (y % 64);
+				++count;
+			}
+		}
+		std::sort(out + first, out + first + window, lessKey<Entry> );
+		if (!checkpoint(first + window))
+			return false;
+	}
+	current = 1 - current;
+	return true;
+}
+
+/**
+ * Stores the values of the entries, sorted back by state: dst[x] is the
+ * value of the entry of @e x, and d[x] its depth if @a d is given. Since
+ * the entries hold everything that is written, a scatter that was
+ * interrupted can be run again.
+ */
+bool ExternalFunctionalGraph::scatter(Packed* dst, Packed* d) {
+	const uint64_t states = numStates();
+	const Entry* const e = entries[current].data();
+	while (position < states) {
+		const index_type first = position;
+		for (index_type x = first; x < first + window; ++x) {
+			assert(e[x].key == x);
+			dst[x] = e[x].value;
+			if (d)
+				d[x] = e[x].depth;
+		}
+		if (!checkpoint(first + window))
+			return false;
+	}
+	return true;
+}
+
+/**
+ * Counts the predecessors of every state on the successors sorted by an
+ * external sort, which the first round of pointer jumping then joins.
+ */
+bool ExternalFunctionalGraph::countInDegrees() {
+	const uint64_t states = numStates();
+	if (sweep == FILL) {
+		if (!fill(successorArray.data(), NULL))
+			return false;
+		sweep = SORT;
+		if (!checkpoint(0))
+			return false;
+	}
+	if (sweep == SORT) {
+		if (!sort())
+			return false;
+		sweep = JOIN;
+		count = 0;
+		if (!checkpoint(0))
+			return false;
+	}
+	const Entry* const e = entries[current].data();
+	util::Histogram histogram;
+	while (position < states) {
+		// chunks end between states, so that no count spans two of them
+		const index_type first = position;
+		index_type last = min<index_type> (first + window, states);
+		while (last < states && e[last].key == e[last - 1].key)
+			++last;
+		histogram.clear();
+		for (index_type i = first; i < last;) {
+			const index_type j = i;
+			while (++i < last && e[i].key == e[j].key)
+				;
+			histogram.add(i - j);
+			++count;
+		}
+		histogram.addTo(inDegrees);
+		if (!checkpoint(last))
+			return false;
+	}
+	if (count < states)
+		inDegrees[0] += states - count;
+	phase = JUMPS;
+	round = 0;
+	sweep = JOIN;
+	previous = states; // the size of the image of the identity
+	count = 0;
+	std::fill(image.data(), image.data() + image.size(), 0);
+	return checkpoint(0);
+}
+
+/**
+ * Squares the jump of the current round, \f$f^{2^r}\f$, by joining it with
+ * itself through two external sorts, until its image stops shrinking; the
+ * image is marked and counted by the join. The square replaces the jump,
+ * which is no longer read once the join is over.
+ */
+bool ExternalFunctionalGraph::jump() {
+	for (;;) {
+		const Packed* const src = power(round);
+		if (sweep == FILL) {
+			if (!fill(src, NULL))
+				return false;
+			sweep = SORT;
+			if (!checkpoint(0))
+				return false;
+		}
+		if (sweep == SORT) {
+			if (!sort())
+				return false;
+			sweep = JOIN;
+			count = 0;
+			std::fill(image.data(), image.data() + image.size(), 0);
+			if (!checkpoint(0))
+				return false;
+		}
+		if (sweep == JOIN) {
+			if (!join(src, NULL, true))
+				return false;
+			if (count == previous) {
+				// the previous jump already reached the attractors, whose
+				// states are the image
+				rounds = round == 0 ? 0 : round - 1;
+				phase = LABELS;
+				return checkpoint(0);
+			}
+			previous = count;
+			sweep = SORT_BACK;
+			if (!checkpoint(0))
+				return false;
+		}
+		if (sweep == SORT_BACK) {
+			if (!sort())
+				return false;
+			sweep = SCATTER;
+			if (!checkpoint(0))
+				return false;
+		}
+		if (!scatter(jumps.data(), NULL))
+			return false;
+		++round;
+		sweep = FILL;
+		if (!checkpoint(0))
+			return false;
+	}
+}
+
+/**
+ * Loads the attractor states, which are the image of the last jump, and
+ * numbers their cycles in order of their smallest state.
+ * @param sequences the states of cycle @e c at sequences[starts[c]] ...
+ * 	sequences[starts[c + 1] - 1], in the order of the dynamics
+ * @return @e false if they do not fit in memory
+ */
+bool ExternalFunctionalGraph::findCycles(vector<index_type>& sequences,
+		vector<size_t>& starts) {
+	const uint64_t states = numStates();
+	cycleStates.clear();
+	for (index_type w = 0; w < image.size(); ++w)
+		for (uint64_t bits = image[w]; bits; bits &= bits - 1)
+			cycleStates.push_back(w * 64 + __builtin_ctzll(bits));
+	assert(cycleStates.back() < states);
+	if (cycleStates.size() * 3 * sizeof(index_type) > memory
+			|| cycleStates.size() > numeric_limits<uint32_t>::max())
+		return false; // labels are 32-bit
+	cycleOf.assign(cycleStates.size(), NONE);
+	sequences.clear();
+	starts.assign(1, 0);
+	for (size_t i = 0; i < cycleStates.size(); ++i) {
+		if (cycleOf[i] != NONE)
+			continue;
+		index_type s = cycleStates[i];
+		do {
+			const size_t p = lower_bound(cycleStates.begin(),
+					cycleStates.end(), s) - cycleStates.begin();
+			assert(p < cycleStates.size() && cycleStates[p] == s);
+			cycleOf[p] = starts.size() - 1;
+			sequences.push_back(s);
+			s = successorArray[s];
+		} while (s != cycleStates[i]);
+		starts.push_back(sequences.size());
+	}
+	return true;
+}
+
+/**
+ * Labels every state with the attractor its last jump lands on; attractors
+ * are numbered as by FunctionalGraph, in order of the smallest state of
+ * their basin. Also sets depths[x] to 1 if @e x is transient, 0 otherwise,
+ * which starts sumDepths().
+ *
+ * The last jump is \f$f^{2^r}\f$ with @e r = rounds, or a later power if
+ * rounds > 0, which maps every state into its attractor just as well.
+ */
+bool ExternalFunctionalGraph::label() {
+	const uint64_t states = numStates();
+	vector<index_type> sequences;
+	vector<size_t> starts;
+	if (!findCycles(sequences, starts))
+		return false;
+	if (order.empty())
+		order.assign(starts.size() - 1, NONE);
+	const Packed* const j = power(rounds);
+	while (position < states) {
+		const index_type first = position;
+		for (index_type x = first; x < first + window; ++x) {
+			const size_t c = cycleOf[lower_bound(cycleStates.begin(),
+					cycleStates.end(), j[x]) - cycleStates.begin()];
+			if (order[c] == NONE) {
+				order[c] = basins.size();
+				basins.push_back(0);
+			}
+			labels[x] = uint32_t(order[c]);
+			++basins[order[c]];
+			depths[x] = (image[x / 64] >> (x % 64)) & 1 ? 0 : 1;
+		}
+		if (!checkpoint(first + window))
+			return false;
+	}
+	vector<size_t> cycleOfAttractor(basins.size());
+	for (size_t c = 0; c < order.size(); ++c)
+		cycleOfAttractor[order[c]] = c;
+	cycles.clear();
+	offsets.assign(1, 0);
+	for (size_t a = 0; a < basins.size(); ++a) {
+		const size_t c = cycleOfAttractor[a];
+		cycles.insert(cycles.end(), sequences.begin() + starts[c],
+				sequences.begin() + starts[c + 1]);
+		offsets.push_back(cycles.size());
+	}
+	order.clear();
+	cycleStates.clear();
+	cycleOf.clear();
+	phase = DEPTHS;
+	round = sweep = 0;
+	return checkpoint(0);
+}
+
+/**
+ * Sums the transient lengths by pointer jumping, with the same sweeps as
+ * jump(): after round @e r, depths[x] is the number of states among
+ * \f$x, f(x), \ldots, f^{2^{r + 1} - 1}(x)\f$ that are not in an
+ * attractor. The entries carry the depths from the fill to the scatter,
+ * which then replaces them.
+ */
+bool ExternalFunctionalGraph::sumDepths() {
+	while (round < rounds) {
+		const Packed* const src = power(round);
+		Packed* const d = depths.data();
+		if (sweep == FILL) {
+			if (!fill(src, d))
+				return false;
+			sweep = SORT;
+			if (!checkpoint(0))
+				return false;
+		}
+		if (sweep == SORT) {
+			if (!sort())
+				return false;
+			sweep = JOIN;
+			if (!checkpoint(0))
+				return false;
+		}
+		if (sweep == JOIN) {
+			if (!join(src, d, false))
+				return false;
+			sweep = SORT_BACK;
+			if (!checkpoint(0))
+				return false;
+		}
+		if (sweep == SORT_BACK) {
+			if (!sort())
+				return false;
+			sweep = SCATTER;
+			if (!checkpoint(0))
+				return false;
+		}
+		if (!scatter(jumps.data(), d))
+			return false;
+		++round;
+		sweep = FILL;
+		if (!checkpoint(0))
+			return false;
+	}
+	phase = TRANSIENTS;
+	return checkpoint(0);
+}
+
+/**
+ * Counts the transient lengths, then keeps only the files of the results.
+ */
+bool ExternalFunctionalGraph::countTransients() {
+	const uint64_t states = numStates();
+	const Packed* const d = depths.data();
+	util::Histogram histogram;
+	while (position < states) {
+		const index_type first = position;
+		histogram.clear();
+		for (index_type x = first; x < first + window; ++x)
+			histogram.add(d[x]);
+		histogram.addTo(transients);
+		if (!checkpoint(first + window))
+			return false;
+	}
+	phase = COMPLETE;
+	return checkpoint(0);
+}
+
+/**
+ * Returns an attractor.
+ * @param i an attractor index, in order of the smallest state of the basin
+ * @return the attractor
+ */
+Attractor ExternalFunctionalGraph::getAttractor(const size_t i) const {
+	assert(i < numAttractors());
+	vector<State> states;
+	for (size_t p = offsets[i]; p < offsets[i + 1]; ++p)
+		states.push_back(State(n, cycles[p]));
+	return Attractor(states);
+}
+
+} // namespace bn
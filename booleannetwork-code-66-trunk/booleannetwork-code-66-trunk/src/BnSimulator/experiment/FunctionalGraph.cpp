@@ -0,0 +1,112 @@
+/*
+ * FunctionalGraph.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include <BnSimulator/experiment/FunctionalGraph.hpp>
+
+using namespace std;
+using boost::uint64_t;
+
+namespace bn {
+
+namespace {
+
+/**
+ * Label of a state that no walk has reached yet.
+ */
+const FunctionalGraph::index_type UNVISITED = 0;
+
+/**
+ * Label of a state on the current walk.
+ */
+const FunctionalGraph::index_type WALKING = numeric_limits<
+		FunctionalGraph::index_type>::max();
+
+} // namespace
+
+const size_t FunctionalGraph::MAX_NODES;
+
+/**
+ * Finds the attractors, the basins and the distributions from the
+ * successors.
+ *
+ * States are walked from the smallest unlabeled one until the walk meets a
+ * labeled state, whose attractor and transient length give those of the
+ * states walked, or closes on itself, which finds a new attractor. Either
+ * way the walked states are labeled, hence visited no more.
+ */
+void FunctionalGraph::analyze() {
+	const uint64_t states = numStates();
+	// a count wraps only if every state has the same successor
+	bool wrapped = false;
+	for (uint64_t x = 0; x < states; ++x)
+		if (++label[depth[x]] == 0)
+			wrapped = true;
+	util::Histogram histogram;
+	if (wrapped) {
+		histogram.add(0, states - 1);
+		histogram.add(states);
+	} else
+		for (uint64_t x = 0; x < states; ++x)
+			histogram.add(label[x]);
+	histogram.addTo(inDegrees);
+	histogram.clear();
+	fill(label.begin(), label.end(), UNVISITED);
+	offsets.push_back(0);
+	vector<index_type> path;
+	for (uint64_t x = 0; x < states; ++x) {
+		if (label[x] != UNVISITED)
+			continue;
+		path.clear();
+		index_type y = index_type(x);
+		while (label[y] == UNVISITED) {
+			label[y] = WALKING;
+			path.push_back(y);
+			y = depth[y];
+		}
+		// path[0] ... path[tail - 1] are transient states
+		size_t tail = path.size();
+		if (label[y] == WALKING) { // a new attractor, from y on
+			assert(basins.size() + 1 < WALKING);
+			tail = find(path.begin(), path.end(), y) - path.begin();
+			cycles.insert(cycles.end(), path.begin() + tail, path.end());
+			offsets.push_back(cycles.size());
+			basins.push_back(0);
+			for (size_t p = tail; p < path.size(); ++p) {
+				label[path[p]] = index_type(basins.size());
+				depth[path[p]] = 0;
+			}
+			histogram.add(0, path.size() - tail);
+		}
+		const index_type a = label[y];
+		index_type d = depth[y];
+		for (size_t p = tail; p-- > 0;) {
+			label[path[p]] = a;
+			depth[path[p]] = ++d;
+			histogram.add(d);
+		}
+		basins[a - 1] += path.size();
+	}
+	histogram.addTo(transients);
+}
+
+/**
+ * Returns an attractor.
+ * @param i an attractor index, in order of the smallest state of the basin
+ * @return the attractor
+ */
+Attractor FunctionalGraph::getAttractor(const size_t i) const {
+	assert(i < numAttractors());
+	vector<State> states;
+	for (size_t p = offsets[i]; p < offsets[i + 1]; ++p)
+		states.push_back(State(n, cycles[p]));
+	return Attractor(states);
+}
+
+} // namespace bn
@@ -11,15 +11,9 @@ namespace bn {
 
 namespace cycle_finder {
 
-Attractor naive(BooleanDynamics& net, State s) {
-	StateSet stateSet;
-	for (; true; net.update(s)) {
-		const std::pair<StateSet::const_iterator, bool> p = stateSet.push_back(
-				s);
-		if (!p.second)
-			return Attractor(std::make_pair(p.first, stateSet.end()));
-	}
-}
+// the virtual path, for dynamics known only as BasicBooleanDynamics
+template Attractor naive<BasicBooleanDynamics<State> > (
+		BasicBooleanDynamics<State>&, State);
 
 } // namespace cycle_finder
 
@@ -0,0 +1,20 @@
+/*
+ * nivasch.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#include <BnSimulator/experiment/cycle_finder/nivasch.hpp>
+
+namespace bn {
+
+namespace cycle_finder {
+
+// the virtual path, for dynamics known only as BasicBooleanDynamics
+template Attractor nivasch<1, BasicBooleanDynamics<State> > (
+		BasicBooleanDynamics<State>&, State);
+
+} // namespace cycle_finder
+
+} // namespace bn
@@ -0,0 +1,68 @@
+/*
+ * MappedArray.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: stewie
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <BnSimulator/util/MappedArray.hpp>
+
+using namespace std;
+
+namespace bn {
+
+namespace util {
+
+/**
+ * Maps a file, which is created or resized to @a bytes bytes as needed.
+ * @param path the file name
+ * @param bytes the size of the file, which must be positive
+ * @return @e false if the file could not be mapped
+ */
+bool MappedFile::open(const string& path, const boost::uint64_t bytes) {
+	assert(bytes > 0);
+	close();
+	const int fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	bool ok = fstat(fd, &st) == 0;
+	if (ok && boost::uint64_t(st.st_size) != bytes)
+		ok = ftruncate(fd, bytes) == 0;
+	void* p = MAP_FAILED;
+	if (ok)
+		p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd); // the mapping keeps the file open
+	if (p == MAP_FAILED)
+		return false;
+	data = p;
+	this->bytes = bytes;
+	return true;
+}
+
+/**
+ * Unmaps the file, if any.
+ */
+void MappedFile::close() {
+	if (data)
+		munmap(data, bytes);
+	data = NULL;
+	bytes = 0;
+}
+
+/**
+ * Writes the modified pages to the file.
+ * @return @e false on failure
+ */
+bool MappedFile::sync() {
+	return !data || msync(data, bytes, MS_SYNC) == 0;
+}
+
+} // namespace util
+
+} // namespace bn